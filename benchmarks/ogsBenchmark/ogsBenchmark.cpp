@@ -0,0 +1,151 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// Throughput benchmark for the OCCA gather-scatter library.
+//
+//   mpiexec -n <ranks> ./ogsBenchmark <mode> <Nel> <N> <Nfields>
+//
+// builds a continuous numbering of a structured hex mesh with Nel^3
+// elements of degree N per rank (slab partitioned in z), then times
+// Nfields separate ogsGatherScatter calls against one ogsGatherScatterMany
+// call on the same packed fields and reports the effective bandwidth.
+
+#include <stdio.h>
+#include <string.h>
+#include "ogs.hpp"
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  int rank, size;
+  MPI_Comm comm = MPI_COMM_WORLD;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  if (argc<5) {
+    if (!rank) printf("usage: ./ogsBenchmark Serial|OpenMP|CUDA|OpenCL Nel N Nfields\n");
+    MPI_Finalize();
+    exit(-1);
+  }
+
+  const int Nel     = atoi(argv[2]);
+  const int N       = atoi(argv[3]);
+  const int Nfields = atoi(argv[4]);
+  const int Ntests  = 20;
+
+  char deviceConfig[BUFSIZ];
+  if (!strcmp(argv[1], "CUDA"))
+    sprintf(deviceConfig, "mode: 'CUDA', device_id: %d", rank%2);
+  else if (!strcmp(argv[1], "OpenCL"))
+    sprintf(deviceConfig, "mode: 'OpenCL', device_id: 0, platform_id: 0");
+  else if (!strcmp(argv[1], "OpenMP"))
+    sprintf(deviceConfig, "mode: 'OpenMP' ");
+  else
+    sprintf(deviceConfig, "mode: 'Serial' ");
+
+  occa::device device;
+  device.setup(deviceConfig);
+
+  // global node grid is (Nel*N+1) x (Nel*N+1) x (size*Nel*N+1)
+  const hlong Nx = Nel*N+1;
+  const int Nq = N+1;
+  const int Np = Nq*Nq*Nq;
+  const dlong Nelements = Nel*Nel*Nel;
+  const dlong Nlocal = Nelements*Np;
+
+  hlong *ids = (hlong*) calloc(Nlocal, sizeof(hlong));
+  for (int ez=0;ez<Nel;ez++)
+    for (int ey=0;ey<Nel;ey++)
+      for (int ex=0;ex<Nel;ex++) {
+        dlong e = ex + Nel*(ey + Nel*ez);
+        for (int k=0;k<Nq;k++)
+          for (int j=0;j<Nq;j++)
+            for (int i=0;i<Nq;i++) {
+              hlong gx = ex*N+i;
+              hlong gy = ey*N+j;
+              hlong gz = (hlong)(rank*Nel+ez)*N+k;
+              ids[e*Np+i+Nq*(j+Nq*k)] = 1 + gx + Nx*(gy + Nx*gz);
+            }
+      }
+
+  ogs_t *ogs = ogsSetup(Nlocal, ids, comm, 0, 0, device);
+
+  dfloat *q = (dfloat*) calloc(Nfields*Nlocal, sizeof(dfloat));
+  for (dlong n=0;n<Nfields*Nlocal;n++) q[n] = 1;
+
+  occa::memory o_q = device.malloc(Nfields*Nlocal*sizeof(dfloat), q);
+
+  // warm up
+  ogsGatherScatterMany(o_q, Nfields, Nlocal, ogsDfloat, ogsAdd, ogs);
+  for (int f=0;f<Nfields;f++)
+    ogsGatherScatter(o_q + f*Nlocal*sizeof(dfloat), ogsDfloat, ogsAdd, ogs);
+
+  device.finish();
+  MPI_Barrier(comm);
+  double tic = MPI_Wtime();
+  for (int test=0;test<Ntests;test++)
+    for (int f=0;f<Nfields;f++)
+      ogsGatherScatter(o_q + f*Nlocal*sizeof(dfloat), ogsDfloat, ogsAdd, ogs);
+  device.finish();
+  MPI_Barrier(comm);
+  double elapsedSingle = (MPI_Wtime()-tic)/Ntests;
+
+  tic = MPI_Wtime();
+  for (int test=0;test<Ntests;test++)
+    ogsGatherScatterMany(o_q, Nfields, Nlocal, ogsDfloat, ogsAdd, ogs);
+  device.finish();
+  MPI_Barrier(comm);
+  double elapsedMany = (MPI_Wtime()-tic)/Ntests;
+
+  // bytes moved: each shared node is read and written once per field, plus
+  // the index data (read once per field for separate calls, once for Many)
+  dlong NsharedIds = ogs->NsymGather ? ogs->symGatherOffsets[ogs->NsymGather] : 0;
+  NsharedIds += ogs->Nhalo;
+
+  hlong localBytesSingle = (hlong) Nfields*NsharedIds*(2*sizeof(dfloat)+sizeof(dlong));
+  hlong localBytesMany   = (hlong) NsharedIds*(2*Nfields*sizeof(dfloat)+sizeof(dlong));
+  hlong bytesSingle = 0, bytesMany = 0;
+  MPI_Allreduce(&localBytesSingle, &bytesSingle, 1, MPI_HLONG, MPI_SUM, comm);
+  MPI_Allreduce(&localBytesMany,   &bytesMany,   1, MPI_HLONG, MPI_SUM, comm);
+
+  hlong localShared = NsharedIds, totalShared = 0;
+  MPI_Allreduce(&localShared, &totalShared, 1, MPI_HLONG, MPI_SUM, comm);
+
+  if (!rank) {
+    printf("ogsBenchmark: ranks=%d, mode=%s, Nel=%d, N=%d, Nfields=%d, shared nodes=" hlongFormat "\n",
+           size, argv[1], Nel, N, Nfields, totalShared);
+    printf("  %d x ogsGatherScatter : %g s, %g GB/s\n", Nfields, elapsedSingle, bytesSingle/(1.e9*elapsedSingle));
+    printf("  ogsGatherScatterMany  : %g s, %g GB/s\n", elapsedMany, bytesMany/(1.e9*elapsedMany));
+  }
+
+  o_q.free();
+  free(q); free(ids);
+  ogsFree(ogs);
+
+  MPI_Finalize();
+  return 0;
+}
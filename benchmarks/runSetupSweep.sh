@@ -0,0 +1,64 @@
+#!/bin/bash
+
+# run a solver over combinations of setup file values and rank counts
+# usage: runSetupSweep.sh setup executable filter ranks ["KEY=value[,value...]" ...]
+#   setup       setup file to start from, the value line after each [KEY] is replaced
+#               (comment lines between [KEY] and its value are left alone)
+#   executable  solver binary, run as mpiexec -n <ranks> executable <setup copy>
+#   filter      extended regular expression selecting the output lines to print
+#   ranks       space separated rank counts, swept innermost
+#   KEY=values  keys given several comma separated values are swept, the first
+#               such key outermost
+# prints [KEY=value,...,ranks=n] before the selected lines of each run
+
+if [ $# -lt 4 ]; then
+    sed -n '3,12p' $0
+    exit 1
+fi
+
+setup=$1
+executable=$2
+filter=$3
+ranks=$4
+shift 4
+
+specs=("$@")
+exprs=()
+labels=()
+
+sweepSetup=$(mktemp ./setupSweep.XXXXXX)
+trap "rm -f $sweepSetup" EXIT
+
+sweep() {
+    local k=$1
+
+    if [ $k -eq ${#specs[@]} ]; then
+	local args=(-e '')
+	for expr in "${exprs[@]}"; do args+=(-e "$expr"); done
+	sed "${args[@]}" $setup > $sweepSetup
+
+	local label=""
+	for l in "${labels[@]}"; do [ -n "$l" ] && label+="$l,"; done
+
+	for Nranks in $ranks;
+	do
+	    echo "[${label}ranks=$Nranks]";
+	    mpiexec -n $Nranks $executable $sweepSetup | grep -E "$filter";
+	done;
+	return
+    fi
+
+    local key=${specs[$k]%%=*}
+    local values
+    IFS=, read -ra values <<< "${specs[$k]#*=}"
+
+    for value in "${values[@]}"
+    do
+	exprs[$k]="/^\[$key\]/,/^[^#]/{/^[^#[]/s|.*|$value|}"
+	labels[$k]=""
+	if [ ${#values[@]} -gt 1 ]; then labels[$k]="$key=$value"; fi
+	sweep $((k+1))
+    done
+}
+
+sweep 0
@@ -0,0 +1,65 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef KERNEL_BUILDER_H
+#define KERNEL_BUILDER_H 1
+
+#include "mpi.h"
+#include <occa.hpp>
+
+#include "types.h"
+#include "setupAide.hpp"
+
+// collective kernel builds: one leader rank compiles each kernel into the OCCA
+// cache while the others wait, then the others load the cached binary
+typedef struct {
+
+  occa::device device;
+  MPI_Comm comm;
+
+  int leader;      // this rank compiles
+  int everyRank;   // [KERNEL BUILD] ALL: no coordination
+
+  int Nkernels;
+  double buildTime; // seconds spent building on this rank
+
+}kernelBuilder_t;
+
+// [KERNEL BUILD] RANK0 (default): rank 0 compiles for everyone, shared OCCA cache
+//                NODE: the first rank of every node compiles, node-local OCCA cache
+//                ALL:  every rank builds on its own
+kernelBuilder_t *kernelBuilderSetup(occa::device &device, MPI_Comm comm, setupAide &options);
+
+// collective over the builder communicator, call in the same order on every rank
+occa::kernel kernelBuild(kernelBuilder_t *kb, const char *fileName, const char *kernelName,
+                         const occa::properties &info);
+
+// kernel count and slowest rank build time
+void kernelBuilderReport(kernelBuilder_t *kb);
+
+void kernelBuilderFree(kernelBuilder_t *kb);
+
+#endif
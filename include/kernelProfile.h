@@ -0,0 +1,82 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef KERNEL_PROFILE_H
+#define KERNEL_PROFILE_H 1
+
+#include "mpi.h"
+#include <occa.hpp>
+
+#include "types.h"
+#include "setupAide.hpp"
+
+// analytic work model and accumulated timings of one kernel
+typedef struct {
+
+  char *name;
+
+  double bytes;  // bytes moved per launch
+  double flops;  // floating point operations per launch
+
+  long long int Nlaunches;
+  double time;   // accumulated device time [s]
+
+}kernelProfileEntry_t;
+
+// device event based kernel counters (enabled by [KERNEL PROFILE] TRUE)
+typedef struct {
+
+  int enabled;
+
+  occa::device device;
+  MPI_Comm comm;
+
+  int Nentries, maxEntries;
+  kernelProfileEntry_t *entries;
+
+  // launches whose events have not been resolved yet
+  occa::streamTag startTag;
+  int Npending, maxPending;
+  int *pendingEntries;
+  occa::streamTag *pendingStart, *pendingEnd;
+
+}kernelProfile_t;
+
+kernelProfile_t *kernelProfileSetup(occa::device &device, MPI_Comm comm, setupAide &options);
+
+// register a kernel with its analytic per-launch byte and flop counts
+int kernelProfileRegister(kernelProfile_t *prof, const char *name, double bytes, double flops);
+
+// bracket a kernel launch, a NULL profile is ignored
+void kernelProfileStart(kernelProfile_t *prof);
+void kernelProfileStop(kernelProfile_t *prof, int entry);
+
+// print the per-kernel table and write the roofline data file
+void kernelProfileReport(kernelProfile_t *prof, setupAide &options);
+
+void kernelProfileFree(kernelProfile_t *prof);
+
+#endif
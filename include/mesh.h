@@ -46,6 +46,11 @@ SOFTWARE.
 #define TETRAHEDRA 6
 #define HEXAHEDRA 12
 
+// halo exchange modes for device resident fields
+#define MESH_HALO_STAGED        0 // DEVICE -> pinned HOST -> MPI -> pinned HOST -> DEVICE
+#define MESH_HALO_DEVICE_DIRECT 1 // MPI reads/writes DEVICE buffers (GPU-aware MPI)
+#define MESH_HALO_HOST          2 // Serial/OpenMP modes, DEVICE buffers are HOST memory
+
 
 // Copy o_qRecv to host every recvCopyRate
 #define recvCopyRate 5000
@@ -101,6 +106,7 @@ typedef struct {
   dlong NLRPoints; // [EA] Number of points with local reaction BC
   dlong NERPoints; // [EA] Number of points with extended reaction BC
 
+  hlong NmshPrint; // [EA] number of (surface id, physical id) pairs in mshPrint
   hlong *mshPrint;
 
 
@@ -571,8 +577,88 @@ void meshHaloExchangeStart(mesh_t *mesh,
     void *recvBuffer);
 
 
+void meshHaloExchangeRecvStart(mesh_t *mesh,
+			       size_t Nbytes,       // message size per element
+			       void *recvBuffer);
+
+void meshHaloExchangeSendStart(mesh_t *mesh,
+			       size_t Nbytes,       // message size per element
+			       void *sendBuffer);
+
 void meshHaloExchangeFinish(mesh_t *mesh);
 
+// halo exchange engine for DEVICE resident fields
+typedef struct {
+
+  int    mode;       // MESH_HALO_STAGED, MESH_HALO_DEVICE_DIRECT or MESH_HALO_HOST
+  int    Nentries;   // number of dfloats per halo element
+  size_t Nbytes;     // message size per element
+  size_t haloBytes;  // total bytes sent
+  size_t recvBytes;  // total bytes received
+
+  // exchange pattern: send message m carries elements [sendStarts[m],sendStarts[m+1])
+  // of the send list to sendRanks[m], receive message m fills elements
+  // [recvStarts[m],recvStarts[m+1]) after the local elements
+  dlong  Nsend, Nrecv;
+  int    NsendMessages, NrecvMessages;
+  int   *sendRanks, *recvRanks;
+  dlong *sendStarts, *recvStarts;
+  occa::memory o_sendList;
+  int    extended;   // pattern borrowed from a meshHaloExtension_t
+
+  MPI_Request *sendRequests, *recvRequests;
+
+  occa::memory o_haloBuffer; // DEVICE buffer of extracted halo elements
+
+  // pinned HOST staging buffers (MESH_HALO_STAGED only)
+  dfloat *sendBuffer, *recvBuffer;
+  occa::memory o_sendBuffer, o_recvBuffer;
+
+  // destination of the exchange in flight
+  occa::memory o_recv;
+  size_t recvOffset;
+
+}meshHalo_t;
+
+// halo extended one layer deeper, for kernels that evaluate surface terms of the
+// halo elements: the usual halo elements are followed by Nextra face neighbours
+// of halo elements that are not already held locally
+typedef struct {
+
+  dlong Nextra;
+
+  // face node maps and boundary flags of the usual halo elements,
+  // in the element numbering local + halo + extra
+  dlong *vmapM, *vmapP;
+  int   *EToB;
+
+  // exchange pattern for the usual and extra halo elements (see meshHalo_t)
+  dlong  Nsend, Nrecv;
+  dlong *sendList;
+  int    NsendMessages, NrecvMessages;
+  int   *sendRanks, *recvRanks;
+  dlong *sendStarts, *recvStarts;
+
+}meshHaloExtension_t;
+
+meshHaloExtension_t *meshHaloExtensionSetup(mesh_t *mesh);
+
+meshHalo_t *meshHaloDeviceSetup(mesh_t *mesh, int Nentries, setupAide &options);
+
+// exchange whole elements of the usual and extra halo of ext
+meshHalo_t *meshHaloDeviceExtendedSetup(mesh_t *mesh, meshHaloExtension_t *ext, int Nentries, setupAide &options);
+
+// release the buffers of halo and the pattern arrays it allocated
+void meshHaloDeviceFree(meshHalo_t *halo);
+
+// exchange whole elements of o_q, halo elements are received after the local elements of o_q
+void meshHaloExchangeDeviceStart(mesh_t *mesh, meshHalo_t *halo, occa::memory &o_q);
+
+// exchange data already packed in halo->o_haloBuffer, received into o_recv at byte offset
+void meshHaloExchangeDeviceBufferStart(mesh_t *mesh, meshHalo_t *halo, occa::memory &o_recv, size_t offset);
+
+void meshHaloExchangeDeviceFinish(mesh_t *mesh, meshHalo_t *halo);
+
 void meshHaloExchangeBlocking(mesh_t *mesh,
 			     size_t Nbytes,       // message size per element
 			     void *sendBuffer,    // temporary buffer
@@ -630,6 +716,8 @@ extern "C"
   void dgetri_(int* N, double* A, int* lda, int* IPIV, double* WORK, int* lwork, int* INFO);
   void dgeev_(char *JOBVL, char *JOBVR, int *N, double *A, int *LDA, double *WR, double *WI,
               double *VL, int *LDVL, double *VR, int *LDVR, double *WORK, int *LWORK, int *INFO );
+  void dsyev_(char *JOBZ, char *UPLO, int *N, double *A, int *LDA, double *W,
+              double *WORK, int *LWORK, int *INFO);
   
   double dlange_(char *NORM, int *M, int *N, double *A, int *LDA, double *WORK);
   void dgecon_(char *NORM, int *N, double *A, int *LDA, double *ANORM,
@@ -32,17 +32,17 @@ extern "C"
   void *ogsHostSetup(MPI_Comm comm, dlong Ngather, hlong *gatherIds, int unique, int verbose);
   void  ogsGsUnique(hlong *gatherIds, dlong Ngather, MPI_Comm comm);
 
-  void ogsHostGatherScatter    (void *v, const char *type, const char *op, void *gsh);
-  void ogsHostGatherScatterVec (void *v, const int k, const char *type, const char *op, void *gsh);
-  void ogsHostGatherScatterMany(void *v, const int k, const char *type, const char *op, void *gsh);
+  void ogsHostGatherScatter    (void *v, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostGatherScatterVec (void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostGatherScatterMany(void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
   
-  void ogsHostGather    (void *v, const char *type, const char *op, void *gsh);
-  void ogsHostGatherVec (void *v, const int k, const char *type, const char *op, void *gsh);
-  void ogsHostGatherMany(void *v, const int k, const char *type, const char *op, void *gsh);
+  void ogsHostGather    (void *v, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostGatherVec (void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostGatherMany(void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
   
-  void ogsHostScatter    (void *v, const char *type, const char *op, void *gsh);
-  void ogsHostScatterVec (void *v, const int k, const char *type, const char *op, void *gsh);
-  void ogsHostScatterMany(void *v, const int k, const char *type, const char *op, void *gsh);
+  void ogsHostScatter    (void *v, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostScatterVec (void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
+  void ogsHostScatterMany(void *v, const int k, const ogs_type type, const ogs_op op, void *gsh);
   
   void ogsHostFree(void *gsh);
 }
@@ -39,151 +39,22 @@ namespace ogs {
   extern void* haloBuf;
   extern occa::memory o_haloBuf;
 
-  extern occa::kernel gatherScatterKernel_floatAdd;
-  extern occa::kernel gatherScatterKernel_floatMul;
-  extern occa::kernel gatherScatterKernel_floatMin;
-  extern occa::kernel gatherScatterKernel_floatMax;
-
-  extern occa::kernel gatherScatterKernel_doubleAdd;
-  extern occa::kernel gatherScatterKernel_doubleMul;
-  extern occa::kernel gatherScatterKernel_doubleMin;
-  extern occa::kernel gatherScatterKernel_doubleMax;
-
-  extern occa::kernel gatherScatterKernel_intAdd;
-  extern occa::kernel gatherScatterKernel_intMul;
-  extern occa::kernel gatherScatterKernel_intMin;
-  extern occa::kernel gatherScatterKernel_intMax;
-
-  extern occa::kernel gatherScatterKernel_longAdd;
-  extern occa::kernel gatherScatterKernel_longMul;
-  extern occa::kernel gatherScatterKernel_longMin;
-  extern occa::kernel gatherScatterKernel_longMax;
-
-
-
-  extern occa::kernel gatherScatterVecKernel_floatAdd;
-  extern occa::kernel gatherScatterVecKernel_floatMul;
-  extern occa::kernel gatherScatterVecKernel_floatMin;
-  extern occa::kernel gatherScatterVecKernel_floatMax;
-
-  extern occa::kernel gatherScatterVecKernel_doubleAdd;
-  extern occa::kernel gatherScatterVecKernel_doubleMul;
-  extern occa::kernel gatherScatterVecKernel_doubleMin;
-  extern occa::kernel gatherScatterVecKernel_doubleMax;
-
-  extern occa::kernel gatherScatterVecKernel_intAdd;
-  extern occa::kernel gatherScatterVecKernel_intMul;
-  extern occa::kernel gatherScatterVecKernel_intMin;
-  extern occa::kernel gatherScatterVecKernel_intMax;
-
-  extern occa::kernel gatherScatterVecKernel_longAdd;
-  extern occa::kernel gatherScatterVecKernel_longMul;
-  extern occa::kernel gatherScatterVecKernel_longMin;
-  extern occa::kernel gatherScatterVecKernel_longMax;
-
-
-
-  extern occa::kernel gatherScatterManyKernel_floatAdd;
-  extern occa::kernel gatherScatterManyKernel_floatMul;
-  extern occa::kernel gatherScatterManyKernel_floatMin;
-  extern occa::kernel gatherScatterManyKernel_floatMax;
-
-  extern occa::kernel gatherScatterManyKernel_doubleAdd;
-  extern occa::kernel gatherScatterManyKernel_doubleMul;
-  extern occa::kernel gatherScatterManyKernel_doubleMin;
-  extern occa::kernel gatherScatterManyKernel_doubleMax;
-
-  extern occa::kernel gatherScatterManyKernel_intAdd;
-  extern occa::kernel gatherScatterManyKernel_intMul;
-  extern occa::kernel gatherScatterManyKernel_intMin;
-  extern occa::kernel gatherScatterManyKernel_intMax;
-
-  extern occa::kernel gatherScatterManyKernel_longAdd;
-  extern occa::kernel gatherScatterManyKernel_longMul;
-  extern occa::kernel gatherScatterManyKernel_longMin;
-  extern occa::kernel gatherScatterManyKernel_longMax;
-
-
-
-  extern occa::kernel gatherKernel_floatAdd;
-  extern occa::kernel gatherKernel_floatMul;
-  extern occa::kernel gatherKernel_floatMin;
-  extern occa::kernel gatherKernel_floatMax;
-
-  extern occa::kernel gatherKernel_doubleAdd;
-  extern occa::kernel gatherKernel_doubleMul;
-  extern occa::kernel gatherKernel_doubleMin;
-  extern occa::kernel gatherKernel_doubleMax;
-
-  extern occa::kernel gatherKernel_intAdd;
-  extern occa::kernel gatherKernel_intMul;
-  extern occa::kernel gatherKernel_intMin;
-  extern occa::kernel gatherKernel_intMax;
-
-  extern occa::kernel gatherKernel_longAdd;
-  extern occa::kernel gatherKernel_longMul;
-  extern occa::kernel gatherKernel_longMin;
-  extern occa::kernel gatherKernel_longMax;
-
-
-
-  extern occa::kernel gatherVecKernel_floatAdd;
-  extern occa::kernel gatherVecKernel_floatMul;
-  extern occa::kernel gatherVecKernel_floatMin;
-  extern occa::kernel gatherVecKernel_floatMax;
-
-  extern occa::kernel gatherVecKernel_doubleAdd;
-  extern occa::kernel gatherVecKernel_doubleMul;
-  extern occa::kernel gatherVecKernel_doubleMin;
-  extern occa::kernel gatherVecKernel_doubleMax;
-
-  extern occa::kernel gatherVecKernel_intAdd;
-  extern occa::kernel gatherVecKernel_intMul;
-  extern occa::kernel gatherVecKernel_intMin;
-  extern occa::kernel gatherVecKernel_intMax;
-
-  extern occa::kernel gatherVecKernel_longAdd;
-  extern occa::kernel gatherVecKernel_longMul;
-  extern occa::kernel gatherVecKernel_longMin;
-  extern occa::kernel gatherVecKernel_longMax;
-
-
-
-  extern occa::kernel gatherManyKernel_floatAdd;
-  extern occa::kernel gatherManyKernel_floatMul;
-  extern occa::kernel gatherManyKernel_floatMin;
-  extern occa::kernel gatherManyKernel_floatMax;
-
-  extern occa::kernel gatherManyKernel_doubleAdd;
-  extern occa::kernel gatherManyKernel_doubleMul;
-  extern occa::kernel gatherManyKernel_doubleMin;
-  extern occa::kernel gatherManyKernel_doubleMax;
-
-  extern occa::kernel gatherManyKernel_intAdd;
-  extern occa::kernel gatherManyKernel_intMul;
-  extern occa::kernel gatherManyKernel_intMin;
-  extern occa::kernel gatherManyKernel_intMax;
-
-  extern occa::kernel gatherManyKernel_longAdd;
-  extern occa::kernel gatherManyKernel_longMul;
-  extern occa::kernel gatherManyKernel_longMin;
-  extern occa::kernel gatherManyKernel_longMax;
-
-
-  extern occa::kernel scatterKernel_float;
-  extern occa::kernel scatterKernel_double;
-  extern occa::kernel scatterKernel_int;
-  extern occa::kernel scatterKernel_long;
-
-  extern occa::kernel scatterVecKernel_float;
-  extern occa::kernel scatterVecKernel_double;
-  extern occa::kernel scatterVecKernel_int;
-  extern occa::kernel scatterVecKernel_long;
-
-  extern occa::kernel scatterManyKernel_float;
-  extern occa::kernel scatterManyKernel_double;
-  extern occa::kernel scatterManyKernel_int;
-  extern occa::kernel scatterManyKernel_long;
+  typedef enum {
+    OGS_GATHERSCATTER = 0,
+    OGS_GATHERSCATTERVEC,
+    OGS_GATHERSCATTERMANY,
+    OGS_GATHERSCATTERBUCKET,
+    OGS_GATHERSCATTERMANYBUCKET,
+    OGS_GATHER,
+    OGS_GATHERVEC,
+    OGS_GATHERMANY,
+    OGS_SCATTER,
+    OGS_SCATTERVEC,
+    OGS_SCATTERMANY,
+    OGS_NKERNELS
+  } ogsKernelId;
+
+  extern const size_t typeSize[ogsNtypes];
 
   extern occa::stream defaultStream;
   extern occa::stream dataStream;
@@ -191,21 +62,30 @@ namespace ogs {
   void initKernels(MPI_Comm comm, occa::device device);
 
   void freeKernels();
+
+  occa::kernel &getKernel(const ogsKernelId id, const ogs_type type, const ogs_op op);
 }
 
 void occaGatherScatter(const  dlong Ngather,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
+                occa::memory  o_v);
+
+void occaGatherScatterSym(ogs_t *ogs,
+                const int Nentries,
+                const dlong stride,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v);
 
 void occaGatherScatterVec(const  dlong Ngather,
                 const int Nentries,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v);
 
 void occaGatherScatterMany(const  dlong Ngather,
@@ -213,15 +93,15 @@ void occaGatherScatterMany(const  dlong Ngather,
                 const dlong stride,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v);
 
 void occaGather(const  dlong Ngather,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv);
 
@@ -229,8 +109,8 @@ void occaGatherVec(const  dlong Ngather,
                 const int Nentries,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv);
 
@@ -240,16 +120,16 @@ void occaGatherMany(const  dlong Ngather,
                 const dlong gstride,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv);
 
 void occaScatter(const  dlong Nscatter,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv);
 
@@ -257,8 +137,8 @@ void occaScatterVec(const  dlong Nscatter,
                 const int Nentries,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv);
 
@@ -268,8 +148,8 @@ void occaScatterMany(const  dlong Nscatter,
                 const dlong sstride,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv);
 
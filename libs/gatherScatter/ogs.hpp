@@ -118,18 +118,10 @@ SOFTWARE.
 #include "mpi.h"
 #include "types.h"
 
-#define ogsFloat  "float"
-#define ogsDouble "double"
-#define ogsDfloat dfloatString
-#define ogsInt  "int"
-#define ogsLong "long long int"
-#define ogsDlong dlongString
-#define ogsHlong hlongString
-
-#define ogsAdd "add"
-#define ogsMul "mul"
-#define ogsMax "max"
-#define ogsMin "min"
+#include "ogsDefs.h"
+
+// largest gather multiplicity handled by the fixed-trip bucket kernels
+#define OGS_MAX_BUCKET 8
 
 // OCCA+gslib gather scatter
 typedef struct {
@@ -155,6 +147,21 @@ typedef struct {
   occa::memory o_haloGatherOffsets;
   occa::memory o_haloGatherIds;
 
+  // symmetric local gather-scatter over shared nodes only. Groups with a
+  // single member are dropped and the remainder are sorted by multiplicity.
+  // Groups of multiplicity m<=OGS_MAX_BUCKET are stored per bucket with
+  // member n of group g at symBucketIds[symBucketOffset[m] + n*symBucketNgather[m] + g]
+  dlong         NsymGather;       //  number of shared local gather groups
+  dlong         NsymBucketed;     //  number of those handled by buckets
+  dlong         symBucketNgather[OGS_MAX_BUCKET+1];
+  dlong         symBucketOffset[OGS_MAX_BUCKET+1];
+  dlong         *symGatherOffsets;
+  dlong         *symGatherIds;
+  dlong         *symBucketIds;
+  occa::memory o_symGatherOffsets;
+  occa::memory o_symGatherIds;
+  occa::memory o_symBucketIds;
+
   void         *hostGsh;          // gslib gather
   void         *haloGshSym;       // gslib gather
   void         *haloGshNonSym;    // gslib gather
@@ -173,53 +180,53 @@ ogs_t *ogsSetup(dlong N, hlong *ids, MPI_Comm &comm,
 void ogsFree(ogs_t* ogs);
 
 // Host array versions
-void ogsGatherScatter    (void  *v, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
-void ogsGatherScatterVec (void  *v, const int k, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
-void ogsGatherScatterMany(void  *v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatter    (void  *v, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatterVec (void  *v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatterMany(void  *v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
 
-void ogsGather    (void  *gv, void  *v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherVec (void  *gv, void  *v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherMany(void  *gv, void  *v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
+void ogsGather    (void  *gv, void  *v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherVec (void  *gv, void  *v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherMany(void  *gv, void  *v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
 
-void ogsScatter    (void  *sv, void  *v, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterVec (void  *sv, void  *v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterMany(void  *sv, void  *v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
+void ogsScatter    (void  *sv, void  *v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterVec (void  *sv, void  *v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterMany(void  *sv, void  *v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
 
 
 // Synchronous device buffer versions
-void ogsGatherScatter    (occa::memory  o_v, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
-void ogsGatherScatterVec (occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
-void ogsGatherScatterMany(occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatter    (occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatterVec (occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
+void ogsGatherScatterMany(occa::memory  o_v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs); //wrapper for gslib call
 
-void ogsGather    (occa::memory  o_gv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherVec (occa::memory  o_gv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherMany(occa::memory  o_gv, occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
+void ogsGather    (occa::memory  o_gv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherVec (occa::memory  o_gv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherMany(occa::memory  o_gv, occa::memory  o_v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
 
-void ogsScatter    (occa::memory  o_sv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterVec (occa::memory  o_sv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterMany(occa::memory  o_sv, occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
+void ogsScatter    (occa::memory  o_sv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterVec (occa::memory  o_sv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterMany(occa::memory  o_sv, occa::memory  o_v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
 
 // Asynchronous device buffer versions
-void ogsGatherScatterStart     (occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherScatterFinish    (occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherScatterVecStart  (occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherScatterVecFinish (occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherScatterManyStart (occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherScatterManyFinish(occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
-
-void ogsGatherStart     (occa::memory  o_Gv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherFinish    (occa::memory  o_Gv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherVecStart  (occa::memory  o_Gv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherVecFinish (occa::memory  o_Gv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherManyStart (occa::memory  o_Gv, occa::memory  o_v, const int k, const dlong gstride, const dlong stride, const char *type, const char *op, ogs_t *ogs);
-void ogsGatherManyFinish(occa::memory  o_Gv, occa::memory  o_v, const int k, const dlong gstride, const dlong stride, const char *type, const char *op, ogs_t *ogs);
-
-void ogsScatterStart     (occa::memory  o_Sv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterFinish    (occa::memory  o_Sv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterVecStart  (occa::memory  o_Sv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterVecFinish (occa::memory  o_Sv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterManyStart (occa::memory  o_Sv, occa::memory  o_v, const int k, const dlong sstride, const dlong stride, const char *type, const char *op, ogs_t *ogs);
-void ogsScatterManyFinish(occa::memory  o_Sv, occa::memory  o_v, const int k, const dlong sstride, const dlong stride, const char *type, const char *op, ogs_t *ogs);
+void ogsGatherScatterStart     (occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherScatterFinish    (occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherScatterVecStart  (occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherScatterVecFinish (occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherScatterManyStart (occa::memory  o_v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherScatterManyFinish(occa::memory  o_v, const int k, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
+
+void ogsGatherStart     (occa::memory  o_Gv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherFinish    (occa::memory  o_Gv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherVecStart  (occa::memory  o_Gv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherVecFinish (occa::memory  o_Gv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherManyStart (occa::memory  o_Gv, occa::memory  o_v, const int k, const dlong gstride, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsGatherManyFinish(occa::memory  o_Gv, occa::memory  o_v, const int k, const dlong gstride, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
+
+void ogsScatterStart     (occa::memory  o_Sv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterFinish    (occa::memory  o_Sv, occa::memory  o_v, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterVecStart  (occa::memory  o_Sv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterVecFinish (occa::memory  o_Sv, occa::memory  o_v, const int k, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterManyStart (occa::memory  o_Sv, occa::memory  o_v, const int k, const dlong sstride, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
+void ogsScatterManyFinish(occa::memory  o_Sv, occa::memory  o_v, const int k, const dlong sstride, const dlong stride, const ogs_type type, const ogs_op op, ogs_t *ogs);
 
 
 #endif
\ No newline at end of file
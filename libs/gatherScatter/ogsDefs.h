@@ -0,0 +1,59 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Datatype and operation tags for the OCCA gather/scatter library.
+
+  Kept C compatible so the gslib wrappers (compiled with a C compiler) can
+  share them with the C++ side.
+*/
+
+#ifndef OGS_DEFS_H
+#define OGS_DEFS_H 1
+
+#include "types.h"
+
+typedef enum {
+  ogsFloat = 0,
+  ogsDouble,
+  ogsInt,
+  ogsLong,
+  ogsNtypes
+} ogs_type;
+
+typedef enum {
+  ogsAdd = 0,
+  ogsMul,
+  ogsMin,
+  ogsMax,
+  ogsNops
+} ogs_op;
+
+#define ogsDfloat ((sizeof(dfloat)==sizeof(float)) ? ogsFloat : ogsDouble)
+#define ogsDlong  ((sizeof(dlong)==sizeof(int))    ? ogsInt   : ogsLong)
+#define ogsHlong  ((sizeof(hlong)==sizeof(int))    ? ogsInt   : ogsLong)
+
+#endif
@@ -30,15 +30,15 @@ SOFTWARE.
 
 #include "gather.tpp"
 
-void ogsGather_add(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGather_min(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGather_max(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs);
+void ogsGather_add(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGather_min(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGather_max(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
 
 void ogsGather(occa::memory o_gv, 
                occa::memory o_v, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsGatherStart (o_gv, o_v, type, op, ogs);
   ogsGatherFinish(o_gv, o_v, type, op, ogs);
@@ -46,18 +46,10 @@ void ogsGather(occa::memory o_gv,
 
 void ogsGatherStart(occa::memory o_gv, 
                     occa::memory o_v, 
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
@@ -81,18 +73,10 @@ void ogsGatherStart(occa::memory o_gv,
 
 void ogsGatherFinish(occa::memory o_gv, 
                      occa::memory o_v, 
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if(ogs->NlocalGather) {
     occaGather(ogs->NlocalGather, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v, o_gv);
@@ -117,18 +101,10 @@ void ogsGatherFinish(occa::memory o_gv,
 
 void ogsGather(void *gv, 
                void *v, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes) {
@@ -137,28 +113,28 @@ void ogsGather(void *gv,
     }
   }
 
-  if (!strcmp(op, "add")) 
+  if (op==ogsAdd) 
     ogsGather_add(gv, v, Nbytes, type, ogs);
-  else if (!strcmp(op, "mul")) 
+  else if (op==ogsMul) 
     ogsGather_mul(gv, v, Nbytes, type, ogs);
-  else if (!strcmp(op, "min")) 
+  else if (op==ogsMin) 
     ogsGather_min(gv, v, Nbytes, type, ogs);
-  else if (!strcmp(op, "max")) 
+  else if (op==ogsMax) 
     ogsGather_max(gv, v, Nbytes, type, ogs);
 }
 
-void ogsGather_add(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGather_add(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_add<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_add<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_add<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_add<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -170,32 +146,32 @@ void ogsGather_add(void *gv, void *v, const size_t Nbytes, const char *type, ogs
       memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_add<float>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_add<double>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_add<int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_add<long long int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_mul<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_mul<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_mul<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_mul<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -207,32 +183,32 @@ void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const char *type, ogs
       memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_mul<float>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_mul<double>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_mul<int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_mul<long long int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGather_min(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGather_min(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_min<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_min<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_min<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_min<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -244,32 +220,32 @@ void ogsGather_min(void *gv, void *v, const size_t Nbytes, const char *type, ogs
       memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_min<float>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_min<double>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_min<int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_min<long long int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGather_max(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGather_max(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_max<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_max<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_max<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_max<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -281,16 +257,16 @@ void ogsGather_max(void *gv, void *v, const size_t Nbytes, const char *type, ogs
       memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gather_max<float>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gather_max<double>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gather_max<int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gather_max<long long int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
@@ -298,41 +274,10 @@ void ogsGather_max(void *gv, void *v, const size_t Nbytes, const char *type, ogs
 void occaGather(const  dlong Ngather,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherKernel_floatAdd(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherKernel_floatMul(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherKernel_floatMin(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherKernel_floatMax(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherKernel_doubleAdd(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherKernel_doubleMul(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherKernel_doubleMin(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherKernel_doubleMax(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherKernel_intAdd(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherKernel_intMul(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherKernel_intMin(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherKernel_intMax(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherKernel_longAdd(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherKernel_longMul(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherKernel_longMin(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherKernel_longMax(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
+
+  ogs::getKernel(ogs::OGS_GATHER, type, op)(Ngather, o_gatherStarts, o_gatherIds, o_v, o_gv);
 }
\ No newline at end of file
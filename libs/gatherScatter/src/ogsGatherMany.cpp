@@ -30,18 +30,18 @@ SOFTWARE.
 
 #include "gatherMany.tpp"
 
-void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs);
+void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
 
 void ogsGatherMany(occa::memory o_gv, 
                occa::memory o_v,
                const int k,
                const dlong gstride,
                const dlong stride, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsGatherManyStart (o_gv, o_v, k, gstride, stride, type, op, ogs);
   ogsGatherManyFinish(o_gv, o_v, k, gstride, stride, type, op, ogs);
@@ -52,18 +52,10 @@ void ogsGatherManyStart(occa::memory o_gv,
                     const int k,
                     const dlong gstride,
                     const dlong stride, 
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -90,18 +82,10 @@ void ogsGatherManyFinish(occa::memory o_gv,
                      const int k,
                      const dlong gstride,
                      const dlong stride, 
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if(ogs->NlocalGather) {
     occaGatherMany(ogs->NlocalGather, k, stride, gstride, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v, o_gv);
@@ -134,18 +118,10 @@ void ogsGatherMany(void *gv,
                const int k,
                const dlong gstride,
                const dlong stride,  
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
@@ -154,31 +130,31 @@ void ogsGatherMany(void *gv,
     }
   }
 
-  if (!strcmp(op, "add")) 
+  if (op==ogsAdd) 
     ogsGatherMany_add(gv, v, k, gstride, stride, Nbytes, type, ogs);
-  else if (!strcmp(op, "mul")) 
+  else if (op==ogsMul) 
     ogsGatherMany_mul(gv, v, k, gstride, stride, Nbytes, type, ogs);
-  else if (!strcmp(op, "min")) 
+  else if (op==ogsMin) 
     ogsGatherMany_min(gv, v, k, gstride, stride, Nbytes, type, ogs);
-  else if (!strcmp(op, "max")) 
+  else if (op==ogsMax) 
     ogsGatherMany_max(gv, v, k, gstride, stride, Nbytes, type, ogs);
 }
 
-void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_add<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_add<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_add<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_add<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
@@ -196,39 +172,39 @@ void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, cons
                ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_add<float>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_add<double>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_add<int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_add<long long int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_mul<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_mul<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_mul<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_mul<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
@@ -246,39 +222,39 @@ void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, cons
                ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_mul<float>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_mul<double>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_mul<int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_mul<long long int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_min<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_min<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_min<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_min<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
@@ -296,39 +272,39 @@ void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, cons
                ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_min<float>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_min<double>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_min<int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_min<long long int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, const dlong stride, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_max<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_max<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_max<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_max<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
@@ -346,19 +322,19 @@ void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, cons
                ogs->NownedHalo*Nbytes);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherMany_max<float>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherMany_max<double>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherMany_max<int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherMany_max<long long int>(ogs->NlocalGather, k, stride, gstride, 
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
@@ -370,41 +346,10 @@ void occaGatherMany(const  dlong Ngather,
                 const dlong gstride,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherManyKernel_floatAdd(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherManyKernel_floatMul(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherManyKernel_floatMin(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherManyKernel_floatMax(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherManyKernel_doubleAdd(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherManyKernel_doubleMul(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherManyKernel_doubleMin(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherManyKernel_doubleMax(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherManyKernel_intAdd(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherManyKernel_intMul(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherManyKernel_intMin(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherManyKernel_intMax(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherManyKernel_longAdd(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherManyKernel_longMul(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherManyKernel_longMin(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherManyKernel_longMax(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
+
+  ogs::getKernel(ogs::OGS_GATHERMANY, type, op)(Ngather, Nentries, stride, gstride, o_gatherStarts, o_gatherIds, o_v, o_gv);
 }
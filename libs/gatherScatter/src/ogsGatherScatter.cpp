@@ -29,33 +29,25 @@ SOFTWARE.
 #include "ogsInterface.h"
 
 void ogsGatherScatter(void *v, 
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
   ogsHostGatherScatter(v, type, op, ogs->hostGsh);
 }
 
 void ogsGatherScatter(occa::memory o_v, 
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
   ogsGatherScatterStart (o_v, type, op, ogs);
   ogsGatherScatterFinish(o_v, type, op, ogs);
 }
 
 void ogsGatherScatterStart(occa::memory o_v, 
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
@@ -78,21 +70,13 @@ void ogsGatherScatterStart(occa::memory o_v,
 
 
 void ogsGatherScatterFinish(occa::memory o_v, 
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
-
-  if(ogs->NlocalGather) {
-    occaGatherScatter(ogs->NlocalGather, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v);
+  const size_t Nbytes = ogs::typeSize[type];
+
+  if(ogs->NsymGather) {
+    occaGatherScatterSym(ogs, 1, 0, type, op, o_v);
   }
 
   if (ogs->NhaloGather) {
@@ -112,43 +96,44 @@ void ogsGatherScatterFinish(occa::memory o_v,
   }
 }
 
+// symmetric gather-scatter over the shared local nodes of Nentries fields
+//  packed at o_v + k*stride
+void occaGatherScatterSym(ogs_t *ogs,
+                const int Nentries,
+                const dlong stride,
+                const ogs_type type,
+                const ogs_op op,
+                occa::memory  o_v) {
+
+  for (int m=2;m<=OGS_MAX_BUCKET;m++) {
+    const dlong Ng = ogs->symBucketNgather[m];
+    if (!Ng) continue;
+
+    occa::memory o_ids = ogs->o_symBucketIds + ogs->symBucketOffset[m]*sizeof(dlong);
+
+    if (Nentries==1)
+      ogs::getKernel(ogs::OGS_GATHERSCATTERBUCKET, type, op)(Ng, m, o_ids, o_v);
+    else
+      ogs::getKernel(ogs::OGS_GATHERSCATTERMANYBUCKET, type, op)(Ng, m, Nentries, stride, o_ids, o_v);
+  }
+
+  //remaining high multiplicity groups
+  const dlong Nlarge = ogs->NsymGather - ogs->NsymBucketed;
+  if (Nlarge) {
+    occa::memory o_largeOffsets = ogs->o_symGatherOffsets + ogs->NsymBucketed*sizeof(dlong);
+    if (Nentries==1)
+      occaGatherScatter(Nlarge, o_largeOffsets, ogs->o_symGatherIds, type, op, o_v);
+    else
+      occaGatherScatterMany(Nlarge, Nentries, stride, o_largeOffsets, ogs->o_symGatherIds, type, op, o_v);
+  }
+}
+
 void occaGatherScatter(const  dlong Ngather,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterKernel_floatAdd(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterKernel_floatMul(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterKernel_floatMin(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterKernel_floatMax(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterKernel_doubleAdd(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterKernel_doubleMul(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterKernel_doubleMin(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterKernel_doubleMax(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterKernel_intAdd(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterKernel_intMul(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterKernel_intMin(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterKernel_intMax(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterKernel_longAdd(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterKernel_longMul(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterKernel_longMin(Ngather, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterKernel_longMax(Ngather, o_gatherStarts, o_gatherIds, o_v);
+
+  ogs::getKernel(ogs::OGS_GATHERSCATTER, type, op)(Ngather, o_gatherStarts, o_gatherIds, o_v);
 }
\ No newline at end of file
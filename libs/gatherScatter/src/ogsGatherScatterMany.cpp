@@ -31,19 +31,11 @@ SOFTWARE.
 void ogsGatherScatterMany(void *v, 
                       const int k,
                       const dlong stride,
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
 
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   void* V[k];
   for (int i=0;i<k;i++) V[i] = (char*)v + i*stride*Nbytes;
@@ -54,8 +46,8 @@ void ogsGatherScatterMany(void *v,
 void ogsGatherScatterMany(occa::memory o_v, 
                       const int k,
                       const dlong stride,
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
   ogsGatherScatterManyStart (o_v, k, stride, type, op, ogs);
   ogsGatherScatterManyFinish(o_v, k, stride, type, op, ogs);
@@ -64,18 +56,10 @@ void ogsGatherScatterMany(occa::memory o_v,
 void ogsGatherScatterManyStart(occa::memory o_v, 
                           const int k,
                           const dlong stride,
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -100,22 +84,14 @@ void ogsGatherScatterManyStart(occa::memory o_v,
 void ogsGatherScatterManyFinish(occa::memory o_v, 
                           const int k,
                           const dlong stride,
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
 
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
-
-  if(ogs->NlocalGather) {
-    occaGatherScatterMany(ogs->NlocalGather, k, stride, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v);
+  const size_t Nbytes = ogs::typeSize[type];
+
+  if(ogs->NsymGather) {
+    occaGatherScatterSym(ogs, k, stride, type, op, o_v);
   }
 
   if (ogs->NhaloGather) {
@@ -143,40 +119,9 @@ void occaGatherScatterMany(const  dlong Ngather,
                 const dlong stride,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterManyKernel_floatAdd(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterManyKernel_floatMul(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterManyKernel_floatMin(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterManyKernel_floatMax(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterManyKernel_doubleAdd(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterManyKernel_doubleMul(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterManyKernel_doubleMin(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterManyKernel_doubleMax(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterManyKernel_intAdd(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterManyKernel_intMul(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterManyKernel_intMin(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterManyKernel_intMax(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterManyKernel_longAdd(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterManyKernel_longMul(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterManyKernel_longMin(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterManyKernel_longMax(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
+
+  ogs::getKernel(ogs::OGS_GATHERSCATTERMANY, type, op)(Ngather, Nentries, stride, o_gatherStarts, o_gatherIds, o_v);
 }
\ No newline at end of file
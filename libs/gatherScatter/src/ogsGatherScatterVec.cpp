@@ -30,16 +30,16 @@ SOFTWARE.
 
 void ogsGatherScatterVec(void *v, 
                       const int k,
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
   ogsHostGatherScatterVec(v, k, type, op, ogs->hostGsh);
 }
 
 void ogsGatherScatterVec(occa::memory o_v, 
                       const int k,
-                      const char *type, 
-                      const char *op, 
+                      const ogs_type type, 
+                      const ogs_op op, 
                       ogs_t *ogs){
   ogsGatherScatterVecStart (o_v, k, type, op, ogs);
   ogsGatherScatterVecFinish(o_v, k, type, op, ogs);
@@ -47,18 +47,10 @@ void ogsGatherScatterVec(occa::memory o_v,
 
 void ogsGatherScatterVecStart(occa::memory o_v, 
                           const int k,
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -82,22 +74,14 @@ void ogsGatherScatterVecStart(occa::memory o_v,
 
 void ogsGatherScatterVecFinish(occa::memory o_v, 
                           const int k,
-                          const char *type, 
-                          const char *op, 
+                          const ogs_type type, 
+                          const ogs_op op, 
                           ogs_t *ogs){
 
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
-
-  if(ogs->NlocalGather) {
-    occaGatherScatterVec(ogs->NlocalGather, k, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v);
+  const size_t Nbytes = ogs::typeSize[type];
+
+  if(ogs->NsymGather) {
+    occaGatherScatterVec(ogs->NsymGather, k, ogs->o_symGatherOffsets, ogs->o_symGatherIds, type, op, o_v);
   }
 
   if (ogs->NhaloGather) {
@@ -121,40 +105,9 @@ void occaGatherScatterVec(const  dlong Ngather,
                 const int Nentries,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterVecKernel_floatAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterVecKernel_floatMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterVecKernel_floatMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterVecKernel_floatMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterVecKernel_doubleAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterVecKernel_doubleMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterVecKernel_doubleMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterVecKernel_doubleMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterVecKernel_intAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterVecKernel_intMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterVecKernel_intMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterVecKernel_intMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherScatterVecKernel_longAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherScatterVecKernel_longMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherScatterVecKernel_longMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherScatterVecKernel_longMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
+
+  ogs::getKernel(ogs::OGS_GATHERSCATTERVEC, type, op)(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v);
 }
\ No newline at end of file
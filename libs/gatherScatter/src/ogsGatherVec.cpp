@@ -30,16 +30,16 @@ SOFTWARE.
 
 #include "gatherVec.tpp"
 
-void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs);
-void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs);
+void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
+void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
 
 void ogsGatherVec(occa::memory o_gv, 
                occa::memory o_v,
                const int k, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsGatherVecStart (o_gv, o_v, k, type, op, ogs);
   ogsGatherVecFinish(o_gv, o_v, k, type, op, ogs);
@@ -48,18 +48,10 @@ void ogsGatherVec(occa::memory o_gv,
 void ogsGatherVecStart(occa::memory o_gv, 
                     occa::memory o_v, 
                     const int k,
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -84,18 +76,10 @@ void ogsGatherVecStart(occa::memory o_gv,
 void ogsGatherVecFinish(occa::memory o_gv, 
                      occa::memory o_v, 
                      const int k,
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if(ogs->NlocalGather) {
     occaGatherVec(ogs->NlocalGather, k, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v, o_gv);
@@ -121,18 +105,10 @@ void ogsGatherVecFinish(occa::memory o_gv,
 void ogsGatherVec(void *gv, 
                void *v,
                const int k, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
@@ -141,28 +117,28 @@ void ogsGatherVec(void *gv,
     }
   }
 
-  if (!strcmp(op, "add")) 
+  if (op==ogsAdd) 
     ogsGatherVec_add(gv, v, k, Nbytes, type, ogs);
-  else if (!strcmp(op, "mul")) 
+  else if (op==ogsMul) 
     ogsGatherVec_mul(gv, v, k, Nbytes, type, ogs);
-  else if (!strcmp(op, "min")) 
+  else if (op==ogsMin) 
     ogsGatherVec_min(gv, v, k, Nbytes, type, ogs);
-  else if (!strcmp(op, "max")) 
+  else if (op==ogsMax) 
     ogsGatherVec_max(gv, v, k, Nbytes, type, ogs);
 }
 
-void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_add<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_add<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_add<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_add<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -173,32 +149,32 @@ void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const
       memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_add<float>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_add<double>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_add<int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_add<long long int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_mul<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_mul<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_mul<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_mul<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -209,32 +185,32 @@ void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const
       memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_mul<float>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_mul<double>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_mul<int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_mul<long long int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_min<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_min<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_min<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_min<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -245,32 +221,32 @@ void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const
       memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_min<float>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_min<double>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_min<int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_min<long long int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
 
-void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_max<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_max<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_max<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_max<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
 
@@ -281,16 +257,16 @@ void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const
       memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     gatherVec_max<float>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)gv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     gatherVec_max<double>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)gv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     gatherVec_max<int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)gv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     gatherVec_max<long long int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)gv);
 }
@@ -299,41 +275,10 @@ void occaGatherVec(const  dlong Ngather,
                 const int Nentries,
                 occa::memory o_gatherStarts,
                 occa::memory o_gatherIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_gv) {
-  
-  if      ((!strcmp(type, "float"))&&(!strcmp(op, "add"))) 
-    ogs::gatherVecKernel_floatAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherVecKernel_floatMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "min"))) 
-    ogs::gatherVecKernel_floatMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "float"))&&(!strcmp(op, "max"))) 
-    ogs::gatherVecKernel_floatMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "add"))) 
-    ogs::gatherVecKernel_doubleAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherVecKernel_doubleMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "min"))) 
-    ogs::gatherVecKernel_doubleMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "double"))&&(!strcmp(op, "max"))) 
-    ogs::gatherVecKernel_doubleMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherVecKernel_intAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherVecKernel_intMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherVecKernel_intMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherVecKernel_intMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "add"))) 
-    ogs::gatherVecKernel_longAdd(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "mul"))) 
-    ogs::gatherVecKernel_longMul(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "min"))) 
-    ogs::gatherVecKernel_longMin(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
-  else if ((!strcmp(type, "long long int"))&&(!strcmp(op, "max"))) 
-    ogs::gatherVecKernel_longMax(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
+
+  ogs::getKernel(ogs::OGS_GATHERVEC, type, op)(Ngather, Nentries, o_gatherStarts, o_gatherIds, o_v, o_gv);
 }
\ No newline at end of file
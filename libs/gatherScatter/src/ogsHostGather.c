@@ -33,55 +33,12 @@ SOFTWARE.
 
 #include "gslib.h"
 
-void ogsHostGather(void *v, const char *type, const char *op, void *gsh){
+#include "ogsDefs.h"
 
-  /* need gs_float or gs_double */
-  if(!strcmp(type, "float")){
-    //    printf("performing string gs on %s\n", type);
-    if(!strcmp(op, "add"))
-      gs(v, gs_float, gs_add, 1, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs(v, gs_float, gs_mul, 1, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs(v, gs_float, gs_min, 1, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs(v, gs_float, gs_max, 1, gsh, 0);
-  }
-  
-  if(!strcmp(type, "double")){
-    //    printf("performing double gs on %s\n", type);
-    if(!strcmp(op, "add"))
-      gs(v, gs_double, gs_add, 1, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs(v, gs_double, gs_mul, 1, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs(v, gs_double, gs_min, 1, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs(v, gs_double, gs_max, 1, gsh, 0);
-  }
+extern const gs_dom ogsGsDom[ogsNtypes];
+extern const gs_op  ogsGsOp[ogsNops];
 
-  if(!strcmp(type, "int")){
-    //    printf("performing int gs\n");
-    if(!strcmp(op, "add"))
-      gs(v, gs_int, gs_add, 1, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs(v, gs_int, gs_mul, 1, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs(v, gs_int, gs_min, 1, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs(v, gs_int, gs_max, 1, gsh, 0);
-  }
+void ogsHostGather(void *v, const ogs_type type, const ogs_op op, void *gsh){
 
-  if(!strcmp(type, "long long int")){
-    //    printf("performing long_long gs\n");
-    if(!strcmp(op, "add"))
-      gs(v, gs_long_long, gs_add, 1, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs(v, gs_long_long, gs_mul, 1, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs(v, gs_long_long, gs_min, 1, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs(v, gs_long_long, gs_max, 1, gsh, 0);
-  } 
+  gs(v, ogsGsDom[type], ogsGsOp[op], 1, gsh, 0);
 }
-
@@ -33,50 +33,12 @@ SOFTWARE.
 
 #include "gslib.h"
 
-void ogsHostGatherScatterMany(void **v, const int k, const char *type, const char *op, void *gsh){
+#include "ogsDefs.h"
 
-  /* need gs_float or gs_double */
-  if(!strcmp(type, "float")){
-    if(!strcmp(op, "add"))
-      gs_many(v, k, gs_float, gs_add, 0, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs_many(v, k, gs_float, gs_mul, 0, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs_many(v, k, gs_float, gs_min, 0, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs_many(v, k, gs_float, gs_max, 0, gsh, 0);
-  }
-  
-  if(!strcmp(type, "double")){
-    if(!strcmp(op, "add"))
-      gs_many(v, k, gs_double, gs_add, 0, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs_many(v, k, gs_double, gs_mul, 0, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs_many(v, k, gs_double, gs_min, 0, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs_many(v, k, gs_double, gs_max, 0, gsh, 0);
-  }
+extern const gs_dom ogsGsDom[ogsNtypes];
+extern const gs_op  ogsGsOp[ogsNops];
 
-  if(!strcmp(type, "int")){
-    if(!strcmp(op, "add"))
-      gs_many(v, k, gs_int, gs_add, 0, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs_many(v, k, gs_int, gs_mul, 0, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs_many(v, k, gs_int, gs_min, 0, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs_many(v, k, gs_int, gs_max, 0, gsh, 0);
-  }
+void ogsHostGatherScatterMany(void **v, const int k, const ogs_type type, const ogs_op op, void *gsh){
 
-  if(!strcmp(type, "long long int")){
-    if(!strcmp(op, "add"))
-      gs_many(v, k, gs_long_long, gs_add, 0, gsh, 0);
-    else if(!strcmp(op, "mul"))
-      gs_many(v, k, gs_long_long, gs_mul, 0, gsh, 0);
-    else if(!strcmp(op, "min"))
-      gs_many(v, k, gs_long_long, gs_min, 0, gsh, 0);
-    else if(!strcmp(op, "max"))
-      gs_many(v, k, gs_long_long, gs_max, 0, gsh, 0);
-  } 
+  gs_many(v, k, ogsGsDom[type], ogsGsOp[op], 0, gsh, 0);
 }
@@ -34,6 +34,11 @@ SOFTWARE.
 #include "gslib.h"
 
 #include "types.h"
+#include "ogsDefs.h"
+
+/* gslib domain and operation for each ogs_type and ogs_op */
+const gs_dom ogsGsDom[ogsNtypes] = {gs_float, gs_double, gs_int, gs_long_long};
+const gs_op  ogsGsOp[ogsNops]    = {gs_add, gs_mul, gs_min, gs_max};
 
 void *ogsHostSetup(MPI_Comm meshComm,
                    dlong NuniqueBases,
@@ -30,12 +30,12 @@ SOFTWARE.
 
 #include "scatter.tpp"
 
-void ogsScatter_op(void *gv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs);
+void ogsScatter_op(void *gv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
 
 void ogsScatter(occa::memory o_sv, 
                occa::memory o_v, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsScatterStart (o_sv, o_v, type, op, ogs);
   ogsScatterFinish(o_sv, o_v, type, op, ogs);
@@ -43,18 +43,10 @@ void ogsScatter(occa::memory o_sv,
 
 void ogsScatterStart(occa::memory o_sv, 
                     occa::memory o_v, 
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
@@ -82,18 +74,10 @@ void ogsScatterStart(occa::memory o_sv,
 
 void ogsScatterFinish(occa::memory o_sv, 
                      occa::memory o_v, 
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     ogs->device.setStream(ogs::dataStream);
@@ -114,19 +98,11 @@ void ogsScatterFinish(occa::memory o_sv,
 
 void ogsScatter(void *sv, 
                void *v, 
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes) {
@@ -138,18 +114,18 @@ void ogsScatter(void *sv,
   ogsScatter_op(sv, v, Nbytes, type, ogs);
 }
 
-void ogsScatter_op(void *sv, void *v, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsScatter_op(void *sv, void *v, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatter<float>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatter<double>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatter<int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatter<long long int>(ogs->NlocalGather, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)sv);
 
@@ -161,16 +137,16 @@ void ogsScatter_op(void *sv, void *v, const size_t Nbytes, const char *type, ogs
     ogsHostScatter(ogs::hostBuf, type, ogsAdd, ogs->haloGshNonSym);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatter<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatter<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatter<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatter<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
 }
@@ -179,17 +155,10 @@ void ogsScatter_op(void *sv, void *v, const size_t Nbytes, const char *type, ogs
 void occaScatter(const  dlong Nscatter,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv) {
-  
-  if      (!strcmp(type, "float")) 
-    ogs::scatterKernel_float(Nscatter, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "double")) 
-    ogs::scatterKernel_double(Nscatter, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "int")) 
-    ogs::scatterKernel_int(Nscatter, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "long long int")) 
-    ogs::scatterKernel_long(Nscatter, o_scatterStarts, o_scatterIds, o_v, o_sv);
+
+  ogs::getKernel(ogs::OGS_SCATTER, type, op)(Nscatter, o_scatterStarts, o_scatterIds, o_v, o_sv);
 }
\ No newline at end of file
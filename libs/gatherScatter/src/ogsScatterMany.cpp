@@ -35,7 +35,7 @@ void ogsScatterMany_op(void *gv, void *v,
                         const dlong sstride,  
                         const dlong stride,  
                         const size_t Nbytes, 
-                        const char *type, 
+                        const ogs_type type, 
                         ogs_t *ogs);
 
 void ogsScatterMany(occa::memory o_sv, 
@@ -43,8 +43,8 @@ void ogsScatterMany(occa::memory o_sv,
                const int k,
                const dlong sstride,
                const dlong stride,
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsScatterManyStart (o_sv, o_v, k, sstride, stride, type, op, ogs);
   ogsScatterManyFinish(o_sv, o_v, k, sstride, stride, type, op, ogs);
@@ -55,18 +55,10 @@ void ogsScatterManyStart(occa::memory o_sv,
                     const int k,
                     const dlong sstride,
                     const dlong stride,
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -99,18 +91,10 @@ void ogsScatterManyFinish(occa::memory o_sv,
                      const int k,
                      const dlong sstride,
                      const dlong stride,
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     ogs->device.setStream(ogs::dataStream);
@@ -137,19 +121,11 @@ void ogsScatterMany(void *sv,
                const int k,
                const dlong sstride,
                const dlong stride,
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
@@ -166,22 +142,22 @@ void ogsScatterMany_op(void *sv, void *v,
                        const dlong sstride,
                        const dlong stride,
                        const size_t Nbytes, 
-                       const char *type, 
+                       const ogs_type type, 
                        ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatterMany<float>(ogs->NlocalGather,  k, stride, sstride,
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatterMany<double>(ogs->NlocalGather, k, stride, sstride,
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatterMany<int>(ogs->NlocalGather, k, stride, sstride, 
                       ogs->localGatherOffsets, 
                       ogs->localGatherIds, (int*)v, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatterMany<long long int>(ogs->NlocalGather, k, stride, sstride,
                       ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)sv);
@@ -201,19 +177,19 @@ void ogsScatterMany_op(void *sv, void *v,
     ogsHostScatterMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatterMany<float>(ogs->NhaloGather, k, ogs->NhaloGather, sstride,
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatterMany<double>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatterMany<int>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatterMany<long long int>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
@@ -225,17 +201,10 @@ void occaScatterMany(const  dlong Nscatter,
                 const dlong sstride,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv) {
-  
-  if      (!strcmp(type, "float")) 
-    ogs::scatterManyKernel_float(Nscatter, Nentries, stride, sstride, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "double")) 
-    ogs::scatterManyKernel_double(Nscatter, Nentries, stride, sstride, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "int")) 
-    ogs::scatterManyKernel_int(Nscatter, Nentries, stride, sstride, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "long long int")) 
-    ogs::scatterManyKernel_long(Nscatter, Nentries, stride, sstride, o_scatterStarts, o_scatterIds, o_v, o_sv);
+
+  ogs::getKernel(ogs::OGS_SCATTERMANY, type, op)(Nscatter, Nentries, stride, sstride, o_scatterStarts, o_scatterIds, o_v, o_sv);
 }
\ No newline at end of file
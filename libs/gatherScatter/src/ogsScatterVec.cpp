@@ -30,13 +30,13 @@ SOFTWARE.
 
 #include "scatterVec.tpp"
 
-void ogsScatterVec_op(void *gv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs);
+void ogsScatterVec_op(void *gv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs);
 
 void ogsScatterVec(occa::memory o_sv, 
                occa::memory o_v, 
                const int k,
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   ogsScatterVecStart (o_sv, o_v, k, type, op, ogs);
   ogsScatterVecFinish(o_sv, o_v, k, type, op, ogs);
@@ -45,18 +45,10 @@ void ogsScatterVec(occa::memory o_sv,
 void ogsScatterVecStart(occa::memory o_sv, 
                     occa::memory o_v, 
                     const int k,
-                    const char *type, 
-                    const char *op, 
+                    const ogs_type type, 
+                    const ogs_op op, 
                     ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
@@ -85,18 +77,10 @@ void ogsScatterVecStart(occa::memory o_sv,
 void ogsScatterVecFinish(occa::memory o_sv, 
                      occa::memory o_v, 
                      const int k,
-                     const char *type, 
-                     const char *op, 
+                     const ogs_type type, 
+                     const ogs_op op, 
                      ogs_t *ogs){
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     ogs->device.setStream(ogs::dataStream);
@@ -118,19 +102,11 @@ void ogsScatterVecFinish(occa::memory o_sv,
 void ogsScatterVec(void *sv, 
                void *v, 
                const int k,
-               const char *type, 
-               const char *op, 
+               const ogs_type type, 
+               const ogs_op op, 
                ogs_t *ogs){
   
-  size_t Nbytes;
-  if (!strcmp(type, "float")) 
-    Nbytes = sizeof(float);
-  else if (!strcmp(type, "double")) 
-    Nbytes = sizeof(double);
-  else if (!strcmp(type, "int")) 
-    Nbytes = sizeof(int);
-  else if (!strcmp(type, "long long int")) 
-    Nbytes = sizeof(long long int);
+  const size_t Nbytes = ogs::typeSize[type];
 
   if (ogs->NhaloGather) {
     if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
@@ -142,18 +118,18 @@ void ogsScatterVec(void *sv,
   ogsScatterVec_op(sv, v, k, Nbytes, type, ogs);
 }
 
-void ogsScatterVec_op(void *sv, void *v, const int k, const size_t Nbytes, const char *type, ogs_t *ogs){
+void ogsScatterVec_op(void *sv, void *v, const int k, const size_t Nbytes, const ogs_type type, ogs_t *ogs){
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatterVec<float>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (float*)v, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatterVec<double>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (double*)v, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatterVec<int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (int*)v, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatterVec<long long int>(ogs->NlocalGather, k, ogs->localGatherOffsets,
                       ogs->localGatherIds, (long long int*)v, (long long int*)sv);
 
@@ -165,16 +141,16 @@ void ogsScatterVec_op(void *sv, void *v, const int k, const size_t Nbytes, const
     ogsHostScatterVec(ogs::hostBuf, k, type, ogsAdd, ogs->haloGshNonSym);
   }
 
-  if (!strcmp(type, "float")) 
+  if (type==ogsFloat) 
     scatterVec<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
-  else if (!strcmp(type, "double")) 
+  else if (type==ogsDouble) 
     scatterVec<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
-  else if (!strcmp(type, "int")) 
+  else if (type==ogsInt) 
     scatterVec<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
-  else if (!strcmp(type, "long long int")) 
+  else if (type==ogsLong) 
     scatterVec<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
                       ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
 }
@@ -183,17 +159,10 @@ void occaScatterVec(const  dlong Nscatter,
                 const int Nentries,
                 occa::memory o_scatterStarts,
                 occa::memory o_scatterIds,
-                const char* type,
-                const char* op,
+                const ogs_type type,
+                const ogs_op op,
                 occa::memory  o_v,
                 occa::memory  o_sv) {
-  
-  if      (!strcmp(type, "float")) 
-    ogs::scatterVecKernel_float(Nscatter, Nentries, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "double")) 
-    ogs::scatterVecKernel_double(Nscatter, Nentries, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "int")) 
-    ogs::scatterVecKernel_int(Nscatter, Nentries, o_scatterStarts, o_scatterIds, o_v, o_sv);
-  else if (!strcmp(type, "long long int")) 
-    ogs::scatterVecKernel_long(Nscatter, Nentries, o_scatterStarts, o_scatterIds, o_v, o_sv);
+
+  ogs::getKernel(ogs::OGS_SCATTERVEC, type, op)(Nscatter, Nentries, o_scatterStarts, o_scatterIds, o_v, o_sv);
 }
\ No newline at end of file
@@ -53,6 +53,28 @@ int compareBaseId(const void *a, const void *b){
   return 0;
 }
 
+typedef struct{
+
+  dlong mult;       // number of local nodes in the gather group
+  dlong gatherId;   // local gather group index
+
+}symGroup_t;
+
+// compare on multiplicity then gather group
+int compareMultiplicity(const void *a, const void *b){
+
+  symGroup_t *fa = (symGroup_t*) a;
+  symGroup_t *fb = (symGroup_t*) b;
+
+  if(fa->mult < fb->mult) return -1;
+  if(fa->mult > fb->mult) return +1;
+
+  if(fa->gatherId < fb->gatherId) return -1;
+  if(fa->gatherId > fb->gatherId) return +1;
+
+  return 0;
+}
+
 // compare on haloOwned then localId
 int compareLocalId(const void *a, const void *b){
 
@@ -192,6 +214,74 @@ ogs_t *ogsSetup(dlong N, hlong *ids, MPI_Comm &comm,
 
   free(localNodes);
 
+  //-----------Symmetric shared local GS setup -------------
+
+  // drop groups with a single member and sort the rest by multiplicity
+  symGroup_t *symGroups = (symGroup_t*) calloc(ogs->NlocalGather+1, sizeof(symGroup_t));
+
+  ogs->NsymGather = 0;
+  dlong NsymIds = 0;
+  for (dlong i=0;i<ogs->NlocalGather;i++) {
+    dlong mult = ogs->localGatherOffsets[i+1]-ogs->localGatherOffsets[i];
+    if (mult<2) continue;
+
+    symGroups[ogs->NsymGather].mult = mult;
+    symGroups[ogs->NsymGather].gatherId = i;
+    ogs->NsymGather++;
+    NsymIds += mult;
+  }
+
+  qsort(symGroups, ogs->NsymGather, sizeof(symGroup_t), compareMultiplicity);
+
+  ogs->symGatherOffsets = (dlong*) calloc(ogs->NsymGather+1,sizeof(dlong));
+  ogs->symGatherIds     = (dlong*) calloc(NsymIds+1,sizeof(dlong));
+  for (dlong i=0;i<ogs->NsymGather;i++) {
+    dlong start = ogs->localGatherOffsets[symGroups[i].gatherId];
+    dlong mult  = symGroups[i].mult;
+
+    ogs->symGatherOffsets[i+1] = ogs->symGatherOffsets[i] + mult;
+    for (dlong n=0;n<mult;n++)
+      ogs->symGatherIds[ogs->symGatherOffsets[i]+n] = ogs->localGatherIds[start+n];
+  }
+
+  // bucket the low multiplicity groups, transposing their ids so that
+  //  consecutive threads read consecutive entries
+  for (int m=0;m<=OGS_MAX_BUCKET;m++) {
+    ogs->symBucketNgather[m] = 0;
+    ogs->symBucketOffset[m]  = 0;
+  }
+
+  ogs->NsymBucketed = 0;
+  while ((ogs->NsymBucketed<ogs->NsymGather)
+         &&(symGroups[ogs->NsymBucketed].mult<=OGS_MAX_BUCKET)) {
+    ogs->symBucketNgather[symGroups[ogs->NsymBucketed].mult]++;
+    ogs->NsymBucketed++;
+  }
+
+  dlong NbucketIds = ogs->symGatherOffsets[ogs->NsymBucketed];
+  ogs->symBucketIds = (dlong*) calloc(NbucketIds+1,sizeof(dlong));
+
+  dlong g0 = 0;
+  for (int m=2;m<=OGS_MAX_BUCKET;m++) {
+    dlong Ng = ogs->symBucketNgather[m];
+    ogs->symBucketOffset[m] = ogs->symGatherOffsets[g0];
+
+    for (dlong g=0;g<Ng;g++)
+      for (int n=0;n<m;n++)
+        ogs->symBucketIds[ogs->symBucketOffset[m]+n*Ng+g]
+          = ogs->symGatherIds[ogs->symGatherOffsets[g0+g]+n];
+
+    g0 += Ng;
+  }
+  free(symGroups);
+
+  if (ogs->NsymGather) {
+    ogs->o_symGatherOffsets = device.malloc((ogs->NsymGather+1)*sizeof(dlong), ogs->symGatherOffsets);
+    ogs->o_symGatherIds     = device.malloc(NsymIds*sizeof(dlong), ogs->symGatherIds);
+    if (NbucketIds)
+      ogs->o_symBucketIds   = device.malloc(NbucketIds*sizeof(dlong), ogs->symBucketIds);
+  }
+
   //-----------Halo GS setup -------------
 
   //set up the halo gatherScatter
@@ -360,6 +450,15 @@ void ogsFree(ogs_t *ogs) {
     ogs->o_localGatherIds.free();
   }
 
+  free(ogs->symGatherOffsets);
+  free(ogs->symGatherIds);
+  free(ogs->symBucketIds);
+  if (ogs->NsymGather) {
+    ogs->o_symGatherOffsets.free();
+    ogs->o_symGatherIds.free();
+    if (ogs->NsymBucketed) ogs->o_symBucketIds.free();
+  }
+
   if (ogs->Nhalo) {
     free(ogs->haloGatherOffsets);
     free(ogs->haloGatherIds);
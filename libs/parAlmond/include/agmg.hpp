@@ -29,12 +29,31 @@ SOFTWARE.
 
 namespace parAlmond {
 
+//communication pattern of a Galerkin product, kept for numeric re-setup
+typedef struct {
+
+  dfloat *Pvals;      //P weights of the fine columns (halo filled)
+
+  dlong sendNtotal;
+  dlong recvNtotal;
+  dlong *sendIds;     //send buffer slot of each fine product
+  dlong *recvIds;     //coarse nonzero of each received product (diag, then offd)
+
+  int *sendCounts, *recvCounts;
+  int *sendOffsets, *recvOffsets;
+
+  dfloat *sendVals, *recvVals;
+
+} galerkinPattern_t;
+
 class agmgLevel: public multigridLevel {
 
 public:
   parCSR   *A,   *P,   *R;
   parHYB *o_A, *o_P, *o_R;
 
+  galerkinPattern_t *pattern=NULL; //how A was formed from the finer level
+
   SmoothType stype;
   dfloat lambda, lambda1, lambda0; //smoothing params
 
@@ -90,7 +109,11 @@ parCSR *constructProlongation(parCSR *A, hlong *FineToCoarse,
 
 parCSR *transpose(parCSR *A);
 
-parCSR *galerkinProd(parCSR *A, parCSR *P);
+parCSR *galerkinProd(parCSR *A, parCSR *P, galerkinPattern_t *pattern);
+
+void galerkinRefresh(parCSR *A, parCSR *Ac, galerkinPattern_t *pattern);
+
+void freeGalerkinPattern(galerkinPattern_t *pattern);
 
 
 
@@ -98,7 +121,9 @@ void setupAgmgSmoother(agmgLevel *level, SmoothType s, int ChebIterations);
 
 void allocateAgmgVectors(agmgLevel *level, int k, int numLevels, CycleType ctype);
 
-void syncAgmgToDevice(agmgLevel *level, int k, int numLevels, CycleType ctype);
+void syncAgmgToDevice(agmgLevel *level, int k, int numLevels, CycleType ctype, FormatType ftype);
+
+dfloat checkHYBFormat(parCSR *A, FormatType ftype);
 
 }
 
@@ -40,6 +40,19 @@ public:
   int N;
   dfloat *invCoarseA=NULL;
 
+  //sparse envelope LDL^T factorization, held on rank 0 of comm
+  bool sparse;
+  int *perm=NULL;         //perm[new] = old
+  int *envFirst=NULL;     //first column of each row's envelope
+  size_t *envStarts=NULL; //offsets of each row in envL
+  dfloat *envL=NULL;
+  dfloat *invD=NULL;
+
+  bool nullSpace;
+  dfloat nullSpacePenalty;
+  dfloat nullNorm2;
+  dfloat *nullCoarse=NULL;
+
   dfloat *xLocal=NULL;
   dfloat *rhsLocal=NULL;
 
@@ -67,6 +80,12 @@ public:
 
   void solve(dfloat *rhs, dfloat *x);
   void solve(occa::memory o_rhs, occa::memory o_x);
+
+private:
+  void setupSparse(int totalNNZ, nonzero_t *nonZeros, dfloat *nullTotal);
+  void solveSparse(dfloat *rhs, dfloat *x);
+
+  void solveLocal(dfloat *rhs, dfloat *x);
 };
 
 }
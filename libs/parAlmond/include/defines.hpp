@@ -32,6 +32,11 @@ SOFTWARE.
 
 #define MAX_LEVELS 100
 #define GPU_CPU_SWITCH_SIZE 0 //host-device switch threshold
+#define HOST_OMP_MIN_SIZE 4096 //host loops shorter than this stay on one thread
+
+#define SELL_C 32       //rows per SELL-C-sigma chunk
+#define SELL_SIGMA 256  //SELL-C-sigma sorting window
+#define SELL_SWITCH 0.8 //AUTO picks SELL when it stores less than this fraction of the ELL entries
 
 #define NUMKCYCLES 3
 #define COARSENTHREASHOLD 0.5
@@ -44,6 +49,7 @@ extern int ChebyshevIterations;
 typedef enum {VCYCLE=0,KCYCLE=1,EXACT=3} CycleType;
 typedef enum {PCG=0,GMRES=1} KrylovType;
 typedef enum {JACOBI=0,DAMPED_JACOBI=1,CHEBYSHEV=2} SmoothType;
+typedef enum {FORMAT_AUTO=0,FORMAT_ELL=1,FORMAT_SELL=2,FORMAT_CSR=3} FormatType;
 
 } //namespace parAlmond
 
@@ -43,6 +43,8 @@ namespace parAlmond {
   extern occa::kernel SpMVellKernel2;
   extern occa::kernel SpMVmcsrKernel1;
   extern occa::kernel SpMVmcsrKernel2;
+  extern occa::kernel SpMVsellKernel1;
+  extern occa::kernel SpMVsellKernel2;
 
   extern occa::kernel vectorSetKernel;
   extern occa::kernel vectorScaleKernel;
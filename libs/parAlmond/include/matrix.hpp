@@ -114,6 +114,40 @@ public:
   void SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta, occa::memory o_y, occa::memory o_z);
 };
 
+//SELL-C-sigma: rows sorted by length inside windows of sigma rows and
+// packed in chunks of SELL_C rows, each chunk padded to its longest row
+class SELL: public matrix_t {
+
+public:
+  int sigma;
+  dlong Nchunks;
+  dlong nnz;  //stored entries, padding included
+
+  dlong  *chunkStarts=NULL; //offset of each chunk in cols/vals
+  dlong  *rowIds=NULL;      //row held by each chunk slot (-1 for padding)
+  dlong  *cols=NULL;        //column-major within a chunk (-1 for padding)
+  dfloat *vals=NULL;
+
+  occa::memory o_chunkStarts;
+  occa::memory o_rowIds;
+  occa::memory o_cols;
+  occa::memory o_vals;
+
+  SELL(dlong N=0, dlong M=0);
+  SELL(CSR *A, int Sigma=SELL_SIGMA); //sorted-window packing of A
+  ~SELL();
+
+  void syncToDevice(occa::device device);
+
+  //re-pack the values of A (same sparsity) on the host
+  void refreshValues(CSR *A);
+
+  void SpMV(const dfloat alpha,        dfloat *x, const dfloat beta, dfloat *y);
+  void SpMV(const dfloat alpha,        dfloat *x, const dfloat beta, const dfloat *y, dfloat *z);
+  void SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta, const occa::memory o_y);
+  void SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta, occa::memory o_y, occa::memory o_z);
+};
+
 class parCSR: public matrix_t {
 
 public:
@@ -170,6 +204,9 @@ public:
 
   ~parCSR();
 
+  //replace the values with those of a COO matrix of identical sparsity
+  void refreshValues(dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals);
+
   void haloSetup(hlong *colIds);
   void haloExchangeStart (dfloat *x);
   void haloExchangeFinish(dfloat *x);
@@ -191,6 +228,7 @@ public:
 
   ELL  *E;
   MCSR *C;
+  SELL *S=NULL; //replaces E for the local block when set
 
   dfloat *diagA=NULL;
   dfloat *diagInv=NULL;
@@ -221,7 +259,7 @@ public:
   occa::device device;
 
   parHYB(dlong N=0, dlong M=0);
-  parHYB(parCSR *A); //build from parCSR
+  parHYB(parCSR *A, FormatType ftype=FORMAT_AUTO); //build from parCSR
 
   ~parHYB();
 
@@ -232,6 +270,9 @@ public:
 
   void syncToDevice();
 
+  //re-pack the values of A (same sparsity) and update the device copy
+  void refreshValues(parCSR *A);
+
   void SpMV(const dfloat alpha,        dfloat *x, const dfloat beta, dfloat *y);
   void SpMV(const dfloat alpha,        dfloat *x, const dfloat beta, const dfloat *y, dfloat *z);
   void SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta, const occa::memory o_y);
@@ -42,21 +42,29 @@ public:
   CycleType    ctype;
   KrylovType   ktype;
   SmoothType stype;
+  FormatType ftype;
 
   int numLevels;
   int AMGstartLev, baseLevel;
+
+  //AMG levels from hostLevel down are cycled on the host
+  dlong hostSwitchSize;
+  int hostLevel;
   multigridLevel **levels=NULL;
 
   coarseSolver *coarseLevel;
 
   int ChebyshevIterations;
 
+  double setupTime, refreshTime;
+
   solver_t(occa::device otherdevice, MPI_Comm othercomm,
                          setupAide otheroptions);
 
   ~solver_t();
 
   void AMGSetup(parCSR *A);
+  void AMGRefresh(dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals);
 
   void Report();
 
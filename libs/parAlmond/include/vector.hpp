@@ -58,6 +58,16 @@ void vectorDotStar(const dlong m, const dfloat *a, dfloat *b);
 void vectorDotStar(const dlong m, const dfloat alpha, const dfloat *a,
                    const dfloat *b, const dfloat beta,  dfloat *c);
 
+// d = alpha*a*b + beta*d and c = gamma*d
+void vectorDotStarAdd(const dlong m, const dfloat alpha, const dfloat *a,
+                      const dfloat *b, const dfloat beta, dfloat *d,
+                      const dfloat gamma, dfloat *c);
+
+// Chebyshev step: x = x + d, r = r - invD*Ad, d = alpha*r + beta*d
+void vectorChebyshevUpdate(const dlong m, const dfloat *invD, const dfloat *Ad,
+                           const dfloat alpha, const dfloat beta,
+                           dfloat *r, dfloat *d, dfloat *x);
+
 dfloat vectorNorm(const dlong n, const dfloat *a, MPI_Comm comm);
 
 dfloat vectorInnerProd(const dlong n, const dfloat *a, const dfloat *b,
@@ -60,6 +60,13 @@ void AMGSetup(solver_t* M,
              bool nullSpace,
              dfloat nullSpacePenalty);
 
+//numeric re-setup for a matrix with the sparsity given to AMGSetup
+void AMGRefresh(solver_t* M,
+               dlong nnz,
+               hlong* Ai,
+               hlong* Aj,
+               dfloat* Avals);
+
 void Precon(solver_t* M, occa::memory o_x, occa::memory o_rhs);
 
 void Report(solver_t *M);
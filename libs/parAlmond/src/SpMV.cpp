@@ -37,7 +37,7 @@ void CSR::SpMV(const dfloat alpha, dfloat *x,
                const dfloat beta, dfloat *y) {
   // y[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
   if (beta) {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<Nrows; i++){ //local
       dfloat result = 0.0;
       for(dlong jj=rowStarts[i]; jj<rowStarts[i+1]; jj++)
@@ -46,7 +46,7 @@ void CSR::SpMV(const dfloat alpha, dfloat *x,
       y[i] = alpha*result + beta*y[i];
     }
   } else {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<Nrows; i++){ //local
       dfloat result = 0.0;
       for(dlong jj=rowStarts[i]; jj<rowStarts[i+1]; jj++)
@@ -60,7 +60,7 @@ void CSR::SpMV(const dfloat alpha, dfloat *x,
 void CSR::SpMV(const dfloat alpha, dfloat *x,
                const dfloat beta, const dfloat *y, dfloat *z) {
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  // #pragma omp parallel for
+  #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<Nrows; i++){ //local
     dfloat result = 0.0;
     for(dlong jj=rowStarts[i]; jj<rowStarts[i+1]; jj++)
@@ -100,7 +100,7 @@ void ELL::SpMV(const dfloat alpha, dfloat *x,
                const dfloat beta, dfloat *y) {
   // y[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
   if (beta) {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<Nrows; i++){ //local
       dfloat result = 0.0;
       for(dlong c=0; c<nnzPerRow; c++) {
@@ -112,7 +112,7 @@ void ELL::SpMV(const dfloat alpha, dfloat *x,
       y[i] = alpha*result + beta*y[i];
     }
   } else {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<Nrows; i++){ //local
       dfloat result = 0.0;
       for(dlong c=0; c<nnzPerRow; c++) {
@@ -129,7 +129,7 @@ void ELL::SpMV(const dfloat alpha, dfloat *x,
 void ELL::SpMV(const dfloat alpha, dfloat *x,
                const dfloat beta, const dfloat *y, dfloat *z) {
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  // #pragma omp parallel for
+  #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<Nrows; i++){ //local
     dfloat result = 0.0;
     for(dlong c=0; c<nnzPerRow; c++) {
@@ -150,6 +150,10 @@ void ELL::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
     SpMVellKernel1(Nrows, nnzPerRow,
                              alpha, beta, o_cols, o_vals, o_x, o_y);
     // occaTimerToc(device,"SpMV ELL");
+  } else if (beta) { //empty ELL part (CSR format), still apply beta
+    vectorScale(Nrows, beta, o_y);
+  } else {
+    vectorSet(Nrows, 0.0, o_y);
   }
 }
 
@@ -161,6 +165,8 @@ void ELL::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
     SpMVellKernel2(Nrows, nnzPerRow,
                              alpha, beta, o_cols, o_vals, o_x, o_y, o_z);
     // occaTimerToc(device,"SpMV ELL");
+  } else { //empty ELL part (CSR format), z = beta*y
+    vectorAdd(Nrows, beta, o_y, 0.0, o_z);
   }
 }
 
@@ -173,7 +179,7 @@ void MCSR::SpMV(const dfloat alpha, dfloat *x,
                 const dfloat beta, dfloat *y){
   // y[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
   if (beta) {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(actualRows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<actualRows; i++){ //local
       dlong row = rows[i];
       dfloat result = 0.0;
@@ -183,7 +189,7 @@ void MCSR::SpMV(const dfloat alpha, dfloat *x,
       y[row] = alpha*result + beta*y[row];
     }
   } else {
-    // #pragma omp parallel for
+    #pragma omp parallel for schedule(static) if(actualRows>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<actualRows; i++){ //local
       dlong row = rows[i];
       dfloat result = 0.0;
@@ -198,7 +204,7 @@ void MCSR::SpMV(const dfloat alpha, dfloat *x,
 void MCSR::SpMV(const dfloat alpha, dfloat *x,
                 const dfloat beta, const dfloat *y, dfloat *z){
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  // #pragma omp parallel for
+  #pragma omp parallel for schedule(static) if(actualRows>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<actualRows; i++){ //local
     dlong row = rows[i];
     dfloat result = 0.0;
@@ -232,6 +238,81 @@ void MCSR::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
 }
 
 
+//------------------------------------------------------------------------
+//
+//  SELL-C-sigma matrix
+//
+//------------------------------------------------------------------------
+void SELL::SpMV(const dfloat alpha, dfloat *x,
+                const dfloat beta, dfloat *y) {
+  // y[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
+  #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
+  for(dlong c=0; c<Nchunks; c++){
+    dfloat result[SELL_C];
+    for(int r=0; r<SELL_C; r++) result[r] = 0.0;
+
+    // the rows of a chunk advance together, one SIMD lane each
+    for(dlong id=chunkStarts[c]; id<chunkStarts[c+1]; id+=SELL_C) {
+      #pragma omp simd
+      for(int r=0; r<SELL_C; r++) {
+        dlong col = cols[id+r];
+        if (col>-1)
+          result[r] += vals[id+r]*x[col];
+      }
+    }
+
+    for(int r=0; r<SELL_C; r++) {
+      dlong row = rowIds[c*SELL_C+r];
+      if (row>-1)
+        y[row] = (beta) ? alpha*result[r] + beta*y[row] : alpha*result[r];
+    }
+  }
+}
+
+void SELL::SpMV(const dfloat alpha, dfloat *x,
+                const dfloat beta, const dfloat *y, dfloat *z) {
+  // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
+  #pragma omp parallel for schedule(static) if(Nrows>HOST_OMP_MIN_SIZE)
+  for(dlong c=0; c<Nchunks; c++){
+    dfloat result[SELL_C];
+    for(int r=0; r<SELL_C; r++) result[r] = 0.0;
+
+    for(dlong id=chunkStarts[c]; id<chunkStarts[c+1]; id+=SELL_C) {
+      #pragma omp simd
+      for(int r=0; r<SELL_C; r++) {
+        dlong col = cols[id+r];
+        if (col>-1)
+          result[r] += vals[id+r]*x[col];
+      }
+    }
+
+    for(int r=0; r<SELL_C; r++) {
+      dlong row = rowIds[c*SELL_C+r];
+      if (row>-1)
+        z[row] = alpha*result[r] + beta*y[row];
+    }
+  }
+}
+
+void SELL::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
+                occa::memory o_y) {
+  // y[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
+  if (Nchunks)
+    SpMVsellKernel1(Nchunks, alpha, beta,
+                    o_chunkStarts, o_rowIds, o_cols, o_vals,
+                    o_x, o_y);
+}
+
+void SELL::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
+                occa::memory o_y, occa::memory o_z) {
+  // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
+  if (Nchunks)
+    SpMVsellKernel2(Nchunks, alpha, beta,
+                    o_chunkStarts, o_rowIds, o_cols, o_vals,
+                    o_x, o_y, o_z);
+}
+
+
 //------------------------------------------------------------------------
 //
 //  parCSR matrix
@@ -324,7 +405,8 @@ void parHYB::SpMV(const dfloat alpha, dfloat *x,
   this->haloExchangeStart(x);
 
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  E->SpMV(alpha, x, beta, y);
+  if (S) S->SpMV(alpha, x, beta, y);
+  else   E->SpMV(alpha, x, beta, y);
 
   this->haloExchangeFinish(x);
 
@@ -343,7 +425,8 @@ void parHYB::SpMV(const dfloat alpha, dfloat *x,
   this->haloExchangeStart(x);
 
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  E->SpMV(alpha, x, beta, y, z);
+  if (S) S->SpMV(alpha, x, beta, y, z);
+  else   E->SpMV(alpha, x, beta, y, z);
 
   this->haloExchangeFinish(x);
 
@@ -362,7 +445,8 @@ void parHYB::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
   this->haloExchangeStart(o_x);
 
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  E->SpMV(alpha, o_x, beta, o_y);
+  if (S) S->SpMV(alpha, o_x, beta, o_y);
+  else   E->SpMV(alpha, o_x, beta, o_y);
 
   this->haloExchangeFinish(o_x);
 
@@ -381,7 +465,8 @@ void parHYB::SpMV(const dfloat alpha, occa::memory o_x, const dfloat beta,
   this->haloExchangeStart(o_x);
 
   // z[i] = beta*y[i] + alpha* (sum_{ij} Aij*x[j])
-  E->SpMV(alpha, o_x, beta, o_y, o_z);
+  if (S) S->SpMV(alpha, o_x, beta, o_y, o_z);
+  else   E->SpMV(alpha, o_x, beta, o_y, o_z);
 
   this->haloExchangeFinish(o_x);
 
@@ -56,6 +56,8 @@ agmgLevel::~agmgLevel() {
   delete   A; delete   P; delete   R;
   delete o_A; delete o_P; delete o_R;
 
+  freeGalerkinPattern(pattern);
+
 }
 
 void agmgLevel::Ax        (dfloat *x, dfloat *Ax){ A->SpMV(1.0, x, 0.0, Ax); }
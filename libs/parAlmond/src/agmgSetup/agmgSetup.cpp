@@ -72,9 +72,56 @@ void solver_t::AMGSetup(parCSR *A){
   for (int n=AMGstartLev;n<numLevels;n++) {
     setupAgmgSmoother((agmgLevel*)(levels[n]), stype, ChebyshevIterations);
     allocateAgmgVectors((agmgLevel*)(levels[n]), n, AMGstartLev, ctype);
-    syncAgmgToDevice((agmgLevel*)(levels[n]), n, AMGstartLev, ctype);
+    syncAgmgToDevice((agmgLevel*)(levels[n]), n, AMGstartLev, ctype, ftype);
   }
   coarseLevel->syncToDevice();
+
+  //compare the device SpMV of each level operator with a CSR stored copy
+  if (options.compareArgs("PARALMOND CHECK FORMAT", "TRUE")) {
+    for (int n=AMGstartLev;n<numLevels;n++) {
+      dfloat err = checkHYBFormat(((agmgLevel*)levels[n])->A, ftype);
+      if(rank==0) printf("parAlmond level %d: max SpMV format difference = %g\n", n, err);
+    }
+  }
+
+  //hand off to the host once the average rows per rank drop below the switch size
+  hostLevel = numLevels;
+  for (int n=AMGstartLev;n<numLevels;n++) {
+    hlong globalRows = ((agmgLevel*)levels[n])->A->globalRowStarts[size];
+    if (globalRows < (hlong) hostSwitchSize*size) {
+      hostLevel = n;
+      break;
+    }
+  }
+
+  //the finest level only has device vectors unless it is cycled on the host
+  if (hostLevel==0) {
+    levels[0]->x   = (dfloat *) calloc(levels[0]->Ncols,sizeof(dfloat));
+    levels[0]->rhs = (dfloat *) calloc(levels[0]->Nrows,sizeof(dfloat));
+  }
+}
+
+//numeric-only re-setup: A has the same sparsity as the matrix given to
+// AMGSetup, so the aggregates, P, R, and the Galerkin communication pattern
+// are reused and only the level values and smoother parameters change
+void solver_t::AMGRefresh(dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals){
+
+  agmgLevel *L = (agmgLevel*) levels[AMGstartLev];
+  L->A->refreshValues(nnz, Ai, Aj, Avals);
+
+  for (int n=AMGstartLev+1;n<numLevels;n++) {
+    agmgLevel *Lc = (agmgLevel*) levels[n];
+    galerkinRefresh(((agmgLevel*)levels[n-1])->A, Lc->A, Lc->pattern);
+  }
+
+  for (int n=AMGstartLev;n<numLevels;n++) {
+    L = (agmgLevel*) levels[n];
+    setupAgmgSmoother(L, stype, ChebyshevIterations);
+    L->o_A->refreshValues(L->A);
+  }
+
+  coarseLevel->setup(((agmgLevel*)levels[baseLevel])->A);
+  coarseLevel->syncToDevice();
 }
 
 //create coarsened problem
@@ -96,11 +143,14 @@ agmgLevel *coarsenAgmgLevel(agmgLevel *level, KrylovType ktype, setupAide option
   dfloat *nullCoarseA;
   parCSR *P = constructProlongation(level->A, FineToCoarse, globalAggStarts, &nullCoarseA);
   parCSR *R = transpose(P);
-  parCSR *A = galerkinProd(level->A, P);
+
+  galerkinPattern_t *pattern = (galerkinPattern_t *) calloc(1,sizeof(galerkinPattern_t));
+  parCSR *A = galerkinProd(level->A, P, pattern);
 
   A->null = nullCoarseA;
 
   agmgLevel *coarseLevel = new agmgLevel(A,P,R, ktype);
+  coarseLevel->pattern = pattern;
 
   //update the number of columns required for this level (from R)
   level->Ncols = (level->Ncols > R->Ncols) ? level->Ncols : R->Ncols;
@@ -143,15 +193,71 @@ void allocateAgmgVectors(agmgLevel *level, int k, int AMGstartLev, CycleType cty
   }
 }
 
-void syncAgmgToDevice(agmgLevel *level, int k, int AMGstartLev, CycleType ctype) {
+//max difference of both device SpMV forms between A stored as ftype and
+// A stored as CSR (as ELL when ftype itself is CSR)
+dfloat checkHYBFormat(parCSR *A, FormatType ftype) {
+
+  occa::device device = A->device;
+  FormatType rtype = (ftype==FORMAT_CSR) ? FORMAT_ELL : FORMAT_CSR;
+
+  parHYB *H = new parHYB(A, ftype);
+  parHYB *R = new parHYB(A, rtype);
+  H->syncToDevice();
+  R->syncToDevice();
+
+  dlong Nrows = A->Nrows;
+  dlong Ncols = A->Ncols;
+
+  dfloat *x = (dfloat *) calloc(Ncols,sizeof(dfloat));
+  dfloat *y = (dfloat *) calloc(Nrows,sizeof(dfloat));
+  dfloat *z = (dfloat *) calloc(Nrows,sizeof(dfloat));
+  dfloat *w = (dfloat *) calloc(Nrows,sizeof(dfloat));
+  vectorRandomize(Nrows, x);
+  vectorRandomize(Nrows, y);
+  vectorRandomize(Nrows, z); //stale output, must be overwritten
+
+  occa::memory o_x  = device.malloc(Ncols*sizeof(dfloat), x);
+  occa::memory o_y  = device.malloc(Nrows*sizeof(dfloat), y);
+  occa::memory o_y1 = device.malloc(Nrows*sizeof(dfloat), y);
+  occa::memory o_y2 = device.malloc(Nrows*sizeof(dfloat), y);
+  occa::memory o_z1 = device.malloc(Nrows*sizeof(dfloat), z);
+  occa::memory o_z2 = device.malloc(Nrows*sizeof(dfloat), z);
+
+  // y = beta*y + alpha*A*x
+  H->SpMV(1.0, o_x, 0.5, o_y1);
+  R->SpMV(1.0, o_x, 0.5, o_y2);
+
+  // z = beta*y + alpha*A*x
+  H->SpMV(1.0, o_x, 0.5, o_y, o_z1);
+  R->SpMV(1.0, o_x, 0.5, o_y, o_z2);
+
+  vectorAdd(Nrows, -1.0, o_y2, 1.0, o_y1);
+  vectorAdd(Nrows, -1.0, o_z2, 1.0, o_z1);
+
+  o_y1.copyTo(y);
+  o_z1.copyTo(w);
+  dfloat errY = vectorMaxAbs(Nrows, y, A->comm);
+  dfloat errZ = vectorMaxAbs(Nrows, w, A->comm);
+
+  o_x.free(); o_y.free();
+  o_y1.free(); o_y2.free();
+  o_z1.free(); o_z2.free();
+  free(x); free(y); free(z); free(w);
+  delete H;
+  delete R;
+
+  return (errY > errZ) ? errY : errZ;
+}
+
+void syncAgmgToDevice(agmgLevel *level, int k, int AMGstartLev, CycleType ctype, FormatType ftype) {
 
   occa::device device = level->A->device;
 
-  level->o_A = new parHYB(level->A);
+  level->o_A = new parHYB(level->A, ftype);
   level->o_A->syncToDevice();
   if (k>AMGstartLev) {
-    level->o_R = new parHYB(level->R);
-    level->o_P = new parHYB(level->P);
+    level->o_R = new parHYB(level->R, ftype);
+    level->o_P = new parHYB(level->P, ftype);
     level->o_R->syncToDevice();
     level->o_P->syncToDevice();
   }
@@ -28,7 +28,18 @@ SOFTWARE.
 
 namespace parAlmond {
 
-parCSR *galerkinProd(parCSR *A, parCSR *P){
+//find the rank owning a global coarse row
+static int coarseRowRank(hlong id, hlong *starts, int size) {
+  int lo = 0, hi = size;
+  while (hi-lo>1) {
+    int mid = (lo+hi)/2;
+    if (id>=starts[mid]) lo = mid;
+    else                 hi = mid;
+  }
+  return lo;
+}
+
+parCSR *galerkinProd(parCSR *A, parCSR *P, galerkinPattern_t *pattern){
 
   // MPI info
   int rank, size;
@@ -90,6 +101,45 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
   MPI_Type_create_struct (3, blength, displ, dtype, &MPI_NONZERO_T);
   MPI_Type_commit (&MPI_NONZERO_T);
 
+  //count number of non-zeros we're sending
+  int *sendCounts = (int *) calloc(size,sizeof(int));
+  int *recvCounts = (int *) calloc(size,sizeof(int));
+  int *sendOffsets = (int *) calloc(size+1,sizeof(int));
+  int *recvOffsets = (int *) calloc(size+1,sizeof(int));
+
+  //all products of a fine row go to the owner of its aggregate
+  int *rowRank = (int *) calloc(N+1,sizeof(int));
+  for (dlong i=0;i<N;i++) {
+    rowRank[i] = coarseRowRank(Pcols[i], globalAggStarts, size);
+    sendCounts[rowRank[i]] += (int) (A->diag->rowStarts[i+1]-A->diag->rowStarts[i]
+                                    +A->offd->rowStarts[i+1]-A->offd->rowStarts[i]);
+  }
+
+  // find how many nodes to expect (should use sparse version)
+  MPI_Alltoall(sendCounts, 1, MPI_INT,
+               recvCounts, 1, MPI_INT, A->comm);
+
+  // find send and recv offsets for gather
+  for(int r=0;r<size;++r){
+    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r];
+    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+  }
+  dlong recvNtotal = recvOffsets[size];
+
+  //slot of each product in the send buffer, binned by destination rank
+  dlong *sendIds = (dlong *) calloc(sendNtotal+1,sizeof(dlong));
+  int *sendFill = (int *) calloc(size,sizeof(int));
+  cnt =0;
+  for (dlong i=0;i<N;i++) {
+    const int r = rowRank[i];
+    const dlong rowNnz = A->diag->rowStarts[i+1]-A->diag->rowStarts[i]
+                        +A->offd->rowStarts[i+1]-A->offd->rowStarts[i];
+    for (dlong j=0;j<rowNnz;j++)
+      sendIds[cnt++] = sendOffsets[r] + sendFill[r]++;
+  }
+  free(sendFill);
+  free(rowRank);
+
   //form the fine PTAP products
   cnt =0;
   for (dlong i=0;i<N;i++) {
@@ -99,10 +149,10 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
       const dlong  col = A->diag->cols[j];
       const dfloat val = A->diag->vals[j];
 
-      sendPTAP[cnt].row = Pcols[i];
-      sendPTAP[cnt].col = Pcols[col];
-      sendPTAP[cnt].val = val*Pvals[i]*Pvals[col];
-      cnt++;
+      nonzero_t *nz = sendPTAP + sendIds[cnt++];
+      nz->row = Pcols[i];
+      nz->col = Pcols[col];
+      nz->val = val*Pvals[i]*Pvals[col];
     }
     start = A->offd->rowStarts[i];
     end   = A->offd->rowStarts[i+1];
@@ -110,42 +160,14 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
       const dlong  col = A->offd->cols[j];
       const dfloat val = A->offd->vals[j];
 
-      sendPTAP[cnt].row = Pcols[i];
-      sendPTAP[cnt].col = Pcols[col];
-      sendPTAP[cnt].val = val*Pvals[i]*Pvals[col];
-      cnt++;
+      nonzero_t *nz = sendPTAP + sendIds[cnt++];
+      nz->row = Pcols[i];
+      nz->col = Pcols[col];
+      nz->val = val*Pvals[i]*Pvals[col];
     }
   }
 
   free(Pcols);
-  free(Pvals);
-
-  //sort entries by the coarse row and col
-  qsort(sendPTAP, sendNtotal, sizeof(nonzero_t), compareNonZeroByRow);
-
-  //count number of non-zeros we're sending
-  int *sendCounts = (int *) calloc(size,sizeof(int));
-  int *recvCounts = (int *) calloc(size,sizeof(int));
-  int *sendOffsets = (int *) calloc(size+1,sizeof(int));
-  int *recvOffsets = (int *) calloc(size+1,sizeof(int));
-
-  int r=0;
-  for(dlong i=0;i<sendNtotal;++i) {
-    hlong id = sendPTAP[i].row;
-    while(id>=globalAggStarts[r+1]) r++;
-    sendCounts[r]++;
-  }
-
-  // find how many nodes to expect (should use sparse version)
-  MPI_Alltoall(sendCounts, 1, MPI_INT,
-               recvCounts, 1, MPI_INT, A->comm);
-
-  // find send and recv offsets for gather
-  for(int r=0;r<size;++r){
-    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r];
-    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
-  }
-  dlong recvNtotal = recvOffsets[size];
 
   nonzero_t *recvPTAP = (nonzero_t *) calloc(recvNtotal,sizeof(nonzero_t));
 
@@ -156,8 +178,10 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
   //clean up
   MPI_Barrier(A->comm);
   free(sendPTAP);
-  free(sendCounts); free(recvCounts);
-  free(sendOffsets); free(recvOffsets);
+
+  //keep the arrival order of the products to build the refresh map
+  nonzero_t *recvOrder = (nonzero_t *) calloc(recvNtotal+1,sizeof(nonzero_t));
+  memcpy(recvOrder, recvPTAP, recvNtotal*sizeof(nonzero_t));
 
   //sort entries by the coarse row and col
   qsort(recvPTAP, recvNtotal, sizeof(nonzero_t), compareNonZeroByRow);
@@ -233,11 +257,15 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
   Ac->offd->cols = (dlong *)  calloc(Ac->offd->nnz, sizeof(dlong));
   Ac->diag->vals = (dfloat *) calloc(Ac->diag->nnz, sizeof(dfloat));
   Ac->offd->vals = (dfloat *) calloc(Ac->offd->nnz, sizeof(dfloat));
+  //position of each coarse nonzero in the diag vals, followed by the offd vals
+  dlong *PTAPdest = (dlong *) calloc(nnz+1,sizeof(dlong));
+
   dlong diagCnt = 0;
   dlong offdCnt = 0;
   for (dlong n=0;n<nnz;n++) {
     if ((PTAP[n].col > globalAggStarts[rank]-1)&&
         (PTAP[n].col < globalAggStarts[rank+1])) {
+      PTAPdest[n] = diagCnt;
       Ac->diag->cols[diagCnt] = (dlong) (PTAP[n].col - globalAggOffset);
       Ac->diag->vals[diagCnt] = PTAP[n].val;
 
@@ -248,6 +276,7 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
 
       diagCnt++;
     } else {
+      PTAPdest[n] = Ac->diag->nnz + offdCnt;
       Ac->offd->cols[offdCnt] = colIds[offdCnt];
       Ac->offd->vals[offdCnt] = PTAP[n].val;
       offdCnt++;
@@ -261,13 +290,96 @@ parCSR *galerkinProd(parCSR *A, parCSR *P){
   Ac->nullSpace = A->nullSpace;
   Ac->nullSpacePenalty = A->nullSpacePenalty;
 
+  //record the communication pattern so the values can be refreshed
+  // without redoing the aggregation, sorting, and halo setup
+  pattern->Pvals = Pvals;
+  pattern->sendNtotal = sendNtotal;
+  pattern->recvNtotal = recvNtotal;
+  pattern->sendIds = sendIds;
+  pattern->sendCounts = sendCounts;
+  pattern->recvCounts = recvCounts;
+  pattern->sendOffsets = sendOffsets;
+  pattern->recvOffsets = recvOffsets;
+
+  pattern->recvIds = (dlong *) calloc(recvNtotal+1,sizeof(dlong));
+  for (dlong i=0;i<recvNtotal;i++) {
+    nonzero_t *nz = (nonzero_t *) bsearch(recvOrder+i, PTAP, nnz,
+                                          sizeof(nonzero_t), compareNonZeroByRow);
+    pattern->recvIds[i] = PTAPdest[nz-PTAP];
+  }
+
+  pattern->sendVals = (dfloat *) calloc(sendNtotal+1,sizeof(dfloat));
+  pattern->recvVals = (dfloat *) calloc(recvNtotal+1,sizeof(dfloat));
+
   //clean up
   MPI_Barrier(A->comm);
   MPI_Type_free(&MPI_NONZERO_T);
   free(colIds);
   free(PTAP);
+  free(PTAPdest);
+  free(recvOrder);
 
   return Ac;
 }
 
+//recompute the values of Ac = P^T A P for a new A with the same sparsity,
+// reusing the communication pattern recorded by galerkinProd
+void galerkinRefresh(parCSR *A, parCSR *Ac, galerkinPattern_t *pattern){
+
+  const dlong N = A->Nrows;
+  const dfloat *Pvals = pattern->Pvals;
+  dfloat *sendVals = pattern->sendVals;
+  dfloat *recvVals = pattern->recvVals;
+
+  dlong cnt =0;
+  for (dlong i=0;i<N;i++) {
+    for (dlong j=A->diag->rowStarts[i];j<A->diag->rowStarts[i+1];j++) {
+      const dlong col = A->diag->cols[j];
+      sendVals[pattern->sendIds[cnt++]] = A->diag->vals[j]*Pvals[i]*Pvals[col];
+    }
+    for (dlong j=A->offd->rowStarts[i];j<A->offd->rowStarts[i+1];j++) {
+      const dlong col = A->offd->cols[j];
+      sendVals[pattern->sendIds[cnt++]] = A->offd->vals[j]*Pvals[i]*Pvals[col];
+    }
+  }
+
+  MPI_Alltoallv(sendVals, pattern->sendCounts, pattern->sendOffsets, MPI_DFLOAT,
+                recvVals, pattern->recvCounts, pattern->recvOffsets, MPI_DFLOAT,
+                A->comm);
+
+  const dlong diagNNZ = Ac->diag->nnz;
+  for (dlong n=0;n<Ac->diag->nnz;n++) Ac->diag->vals[n] = 0.0;
+  for (dlong n=0;n<Ac->offd->nnz;n++) Ac->offd->vals[n] = 0.0;
+
+  for (dlong i=0;i<pattern->recvNtotal;i++) {
+    const dlong id = pattern->recvIds[i];
+    if (id<diagNNZ) Ac->diag->vals[id]         += recvVals[i];
+    else            Ac->offd->vals[id-diagNNZ] += recvVals[i];
+  }
+
+  //record the diagonal
+  for (dlong n=0;n<Ac->Nrows;n++) {
+    for (dlong j=Ac->diag->rowStarts[n];j<Ac->diag->rowStarts[n+1];j++)
+      if (Ac->diag->cols[j]==n) Ac->diagA[n] = Ac->diag->vals[j];
+  }
+
+  //compute the inverse diagonal
+  for (dlong n=0;n<Ac->Nrows;n++) Ac->diagInv[n] = 1.0/Ac->diagA[n];
+}
+
+void freeGalerkinPattern(galerkinPattern_t *pattern){
+  if (!pattern) return;
+
+  free(pattern->Pvals);
+  free(pattern->sendIds);
+  free(pattern->recvIds);
+  free(pattern->sendCounts);
+  free(pattern->recvCounts);
+  free(pattern->sendOffsets);
+  free(pattern->recvOffsets);
+  free(pattern->sendVals);
+  free(pattern->recvVals);
+  free(pattern);
+}
+
 } //namespace parAlmond
\ No newline at end of file
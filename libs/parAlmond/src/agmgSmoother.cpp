@@ -74,32 +74,24 @@ void agmgLevel::smoothChebyshev(dfloat *r, dfloat *x,
   static dfloat *d   = ((dfloat*) scratch) + 2*Ncols;
 
   if(x_is_zero){ //skip the Ax if x is zero
-    //res = D^{-1}r
-    vectorDotStar(Nrows, 1.0, A->diagInv, r, 0.0, res);
+    //res = D^{-1}r, d = invTheta*res
+    vectorDotStarAdd(Nrows, 1.0, A->diagInv, r, 0.0, res, invTheta, d);
     vectorSet(Nrows, 0.0, x);
-    //d = invTheta*res
-    vectorAdd(Nrows, invTheta, res, 0.0, d);
   } else {
-    //res = D^{-1}(r-Ax)
+    //res = D^{-1}(r-Ax), d = invTheta*res
     A->SpMV(-1.0, x, 1.0, r, res);
-    vectorDotStar(Nrows, A->diagInv, res);
-
-    //d = invTheta*res
-    vectorAdd(Nrows, invTheta, res, 0.0, d);
+    vectorDotStarAdd(Nrows, 1.0, A->diagInv, res, 0.0, res, invTheta, d);
   }
 
   for (int k=0;k<ChebyshevIterations;k++) {
-    //x_k+1 = x_k + d_k
-    vectorAdd(Nrows, 1.0, d, 1.0, x);
-
-    //r_k+1 = r_k - D^{-1}Ad_k
     A->SpMV(1.0, d, 0.0, Ad);
-    vectorDotStar(Nrows, -1.0, A->diagInv, Ad, 1.0, res);
 
     rho_np1 = 1.0/(2.*sigma-rho_n);
 
+    //x_k+1 = x_k + d_k
+    //r_k+1 = r_k - D^{-1}Ad_k
     //d_k+1 = rho_k+1*rho_k*d_k  + 2*rho_k+1*r_k+1/delta
-    vectorAdd(Nrows, 2.0*rho_np1/delta, res, rho_np1*rho_n, d);
+    vectorChebyshevUpdate(Nrows, A->diagInv, Ad, 2.0*rho_np1/delta, rho_np1*rho_n, res, d, x);
     rho_n = rho_np1;
   }
   //x_k+1 = x_k + d_k
@@ -30,16 +30,31 @@ namespace parAlmond {
 
 coarseSolver::coarseSolver(setupAide options_) {
   gatherLevel = false;
+  nullSpace = false;
   options = options_;
+  sparse = options.compareArgs("PARALMOND COARSE SOLVER","SPARSE");
 }
 
 int coarseSolver::getTargetSize() {
-  return 1000;
+  int targetSize = sparse ? 10000 : 1000;
+  if (options.getArgs("PARALMOND COARSE SIZE").length())
+    options.getArgs("PARALMOND COARSE SIZE", targetSize);
+  return targetSize;
 }
 
 //set up exact solver using xxt
 void coarseSolver::setup(parCSR *A) {
 
+  //release a previous factorization when called again from a refresh
+  free(coarseOffsets); free(coarseCounts); free(invCoarseA);
+  free(xLocal); free(rhsLocal); free(xCoarse); free(rhsCoarse);
+  free(perm); free(envFirst); free(envStarts); free(envL); free(invD);
+  free(nullCoarse);
+  coarseOffsets = NULL; coarseCounts = NULL; invCoarseA = NULL;
+  xLocal = NULL; rhsLocal = NULL; xCoarse = NULL; rhsCoarse = NULL;
+  perm = NULL; envFirst = NULL; envStarts = NULL; envL = NULL; invD = NULL;
+  nullCoarse = NULL;
+
   comm = A->comm;
 
   int rank, size;
@@ -113,21 +128,38 @@ void coarseSolver::setup(parCSR *A) {
     NNZoffsets[r+1] = NNZoffsets[r] + recvNNZ[r];
   }
 
-  nonzero_t *recvNonZeros = (nonzero_t *) calloc(totalNNZ, sizeof(nonzero_t));
-
-  MPI_Allgatherv(sendNonZeros, sendNNZ,             MPI_NONZERO_T,
-                 recvNonZeros, recvNNZ, NNZoffsets, MPI_NONZERO_T, comm);
-
-  //gather null vector
-  dfloat *nullTotal = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
-
   coarseCounts = (int*) calloc(size,sizeof(int));
   for (int r=0;r<size;r++)
     coarseCounts[r] = coarseOffsets[r+1]-coarseOffsets[r];
 
-  MPI_Allgatherv(  A->null,          N,                MPI_DFLOAT,
-                 nullTotal, coarseCounts, coarseOffsets, MPI_DFLOAT,
-                 comm);
+  nonzero_t *recvNonZeros = NULL;
+  dfloat *nullTotal = NULL;
+
+  if (sparse) {
+    //only rank 0 holds the coarse operator
+    if (rank==0) {
+      recvNonZeros = (nonzero_t *) calloc(totalNNZ, sizeof(nonzero_t));
+      nullTotal = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+    }
+
+    MPI_Gatherv(sendNonZeros, sendNNZ,             MPI_NONZERO_T,
+                recvNonZeros, recvNNZ, NNZoffsets, MPI_NONZERO_T, 0, comm);
+
+    MPI_Gatherv(  A->null,          N,                MPI_DFLOAT,
+                nullTotal, coarseCounts, coarseOffsets, MPI_DFLOAT, 0, comm);
+  } else {
+    recvNonZeros = (nonzero_t *) calloc(totalNNZ, sizeof(nonzero_t));
+
+    MPI_Allgatherv(sendNonZeros, sendNNZ,             MPI_NONZERO_T,
+                   recvNonZeros, recvNNZ, NNZoffsets, MPI_NONZERO_T, comm);
+
+    //gather null vector
+    nullTotal = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+
+    MPI_Allgatherv(  A->null,          N,                MPI_DFLOAT,
+                   nullTotal, coarseCounts, coarseOffsets, MPI_DFLOAT,
+                   comm);
+  }
 
   //clean up
   MPI_Barrier(comm);
@@ -136,6 +168,25 @@ void coarseSolver::setup(parCSR *A) {
   free(NNZoffsets);
   free(recvNNZ);
 
+  xLocal   = (dfloat*) calloc(N,sizeof(dfloat));
+  rhsLocal = (dfloat*) calloc(N,sizeof(dfloat));
+
+  nullSpace = A->nullSpace;
+  nullSpacePenalty = A->nullSpacePenalty;
+
+  if (sparse) {
+    if (rank==0) {
+      xCoarse   = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+      rhsCoarse = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+
+      setupSparse(totalNNZ, recvNonZeros, nullTotal);
+
+      free(recvNonZeros);
+      free(nullTotal);
+    }
+    return;
+  }
+
 
   //assemble the full matrix
   dfloat *coarseA = (dfloat *) calloc(coarseTotal*coarseTotal,sizeof(dfloat));
@@ -166,9 +217,6 @@ void coarseSolver::setup(parCSR *A) {
     }
   }
 
-  xLocal   = (dfloat*) calloc(N,sizeof(dfloat));
-  rhsLocal = (dfloat*) calloc(N,sizeof(dfloat));
-
   xCoarse   = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
   rhsCoarse = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
 
@@ -179,40 +227,37 @@ void coarseSolver::setup(parCSR *A) {
 
 void coarseSolver::syncToDevice() {}
 
-void coarseSolver::solve(dfloat *rhs, dfloat *x) {
+//apply the exact coarse inverse to the local part of a vector
+void coarseSolver::solveLocal(dfloat *rhs, dfloat *x) {
 
-  if (gatherLevel) {
-    ogsGather(Gx, rhs, ogsDfloat, ogsAdd, ogs);
-    //gather the full vector
-    MPI_Allgatherv(Gx,                  N,                MPI_DFLOAT,
-                   rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT, comm);
-
-    //multiply by local part of the exact matrix inverse
-    // #pragma omp parallel for
-    for (int n=0;n<N;n++) {
-      xLocal[n] = 0.;
-      for (int m=0;m<coarseTotal;m++) {
-        xLocal[n] += invCoarseA[n*coarseTotal+m]*rhsCoarse[m];
-      }
-    }
-    ogsScatter(x, xLocal, ogsDfloat, ogsAdd, ogs);
+  if (sparse) {
+    solveSparse(rhs, x);
+    return;
+  }
 
-  } else {
-    //gather the full vector
-    MPI_Allgatherv(rhs,                  N,                MPI_DFLOAT,
-                   rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT, comm);
+  //gather the full vector
+  MPI_Allgatherv(rhs,                  N,                MPI_DFLOAT,
+                 rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT, comm);
 
-    //multiply by local part of the exact matrix inverse
-    // #pragma omp parallel for
-    for (int n=0;n<N;n++) {
-      x[n] = 0.;
-      for (int m=0;m<coarseTotal;m++) {
-        x[n] += invCoarseA[n*coarseTotal+m]*rhsCoarse[m];
-      }
+  //multiply by local part of the exact matrix inverse
+  // #pragma omp parallel for
+  for (int n=0;n<N;n++) {
+    x[n] = 0.;
+    for (int m=0;m<coarseTotal;m++) {
+      x[n] += invCoarseA[n*coarseTotal+m]*rhsCoarse[m];
     }
   }
+}
 
+void coarseSolver::solve(dfloat *rhs, dfloat *x) {
 
+  if (gatherLevel) {
+    ogsGather(Gx, rhs, ogsDfloat, ogsAdd, ogs);
+    solveLocal(Gx, xLocal);
+    ogsScatter(x, xLocal, ogsDfloat, ogsAdd, ogs);
+  } else {
+    solveLocal(rhs, x);
+  }
 }
 
 void coarseSolver::solve(occa::memory o_rhs, occa::memory o_x) {
@@ -224,18 +269,7 @@ void coarseSolver::solve(occa::memory o_rhs, occa::memory o_x) {
     if (N) o_rhs.copyTo(rhsLocal, N*sizeof(dfloat), 0);
   }
 
-  //gather the full vector
-  MPI_Allgatherv(rhsLocal,             N,                MPI_DFLOAT,
-                 rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT, comm);
-
-  //multiply by local part of the exact matrix inverse
-  // #pragma omp parallel for
-  for (int n=0;n<N;n++) {
-    xLocal[n] = 0.;
-    for (int m=0;m<coarseTotal;m++) {
-      xLocal[n] += invCoarseA[n*coarseTotal+m]*rhsCoarse[m];
-    }
-  }
+  solveLocal(rhsLocal, xLocal);
 
   if (gatherLevel) {
     if (N) o_Gx.copyFrom(xLocal, N*sizeof(dfloat), 0);
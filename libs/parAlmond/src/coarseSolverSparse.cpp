@@ -0,0 +1,309 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus, Rajesh Gandham
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAlmond.hpp"
+
+namespace parAlmond {
+
+//breadth-first level structure rooted at start. Returns the number of levels
+// and the lowest-degree node in the last level
+static int levelStructure(int start, int *rowStarts, int *cols,
+                          int *level, int *queue, int *Nqueue, int *last) {
+
+  int head = 0, tail = 0;
+  queue[tail++] = start;
+  level[start] = 0;
+
+  while (head<tail) {
+    const int n = queue[head++];
+    for (int m=rowStarts[n];m<rowStarts[n+1];m++) {
+      const int c = cols[m];
+      if (level[c]<0) {
+        level[c] = level[n]+1;
+        queue[tail++] = c;
+      }
+    }
+  }
+
+  const int depth = level[queue[tail-1]];
+
+  *last = queue[tail-1];
+  for (int n=tail-1;n>=0;n--) {
+    const int c = queue[n];
+    if (level[c]<depth) break;
+    if (rowStarts[c+1]-rowStarts[c] < rowStarts[*last+1]-rowStarts[*last])
+      *last = c;
+  }
+
+  //reset the marks for the next sweep
+  for (int n=0;n<tail;n++) level[queue[n]] = -1;
+
+  *Nqueue = tail;
+  return depth;
+}
+
+//reverse Cuthill-McKee ordering of a structurally symmetric graph, started
+// from a pseudo-peripheral node of each connected component
+static void reverseCuthillMcKee(int N, int *rowStarts, int *cols, int *perm) {
+
+  int *level = (int *) malloc(N*sizeof(int));
+  int *queue = (int *) malloc(N*sizeof(int));
+  for (int n=0;n<N;n++) level[n] = -1;
+
+  bool *ordered = (bool *) calloc(N,sizeof(bool));
+
+  int cnt = 0;
+  for (int seed=0;seed<N;seed++) {
+    if (ordered[seed]) continue;
+
+    //George-Liu search for a pseudo-peripheral start node
+    int Nqueue, last;
+    int start = seed;
+    int depth = levelStructure(start, rowStarts, cols, level, queue, &Nqueue, &last);
+    for (int it=0;it<8;it++) {
+      int newLast;
+      int newDepth = levelStructure(last, rowStarts, cols, level, queue, &Nqueue, &newLast);
+      if (newDepth<=depth) break;
+      start = last;
+      depth = newDepth;
+      last  = newLast;
+    }
+
+    //Cuthill-McKee sweep, visiting neighbours in increasing degree
+    int head = cnt;
+    perm[cnt++] = start;
+    ordered[start] = true;
+    while (head<cnt) {
+      const int n = perm[head++];
+      const int first = cnt;
+      for (int m=rowStarts[n];m<rowStarts[n+1];m++) {
+        const int c = cols[m];
+        if (ordered[c]) continue;
+        ordered[c] = true;
+
+        //insertion sort by degree
+        const int degree = rowStarts[c+1]-rowStarts[c];
+        int i = cnt++;
+        while (i>first && rowStarts[perm[i-1]+1]-rowStarts[perm[i-1]] > degree) {
+          perm[i] = perm[i-1];
+          i--;
+        }
+        perm[i] = c;
+      }
+    }
+  }
+
+  //reverse
+  for (int n=0;n<N/2;n++) {
+    int tmp = perm[n];
+    perm[n] = perm[N-1-n];
+    perm[N-1-n] = tmp;
+  }
+
+  free(level);
+  free(queue);
+  free(ordered);
+}
+
+//factor the coarse operator A = L D L^T in envelope (skyline) storage on
+// rank 0. A null space is handled exactly: the last pivot is pinned and the
+// penalty term is applied as a rank-one correction in solveSparse
+void coarseSolver::setupSparse(int totalNNZ, nonzero_t *nonZeros, dfloat *nullTotal) {
+
+  const int Ncoarse = coarseTotal;
+
+  //symmetric adjacency graph of A (without the diagonal)
+  int *rowStarts = (int *) calloc(Ncoarse+1,sizeof(int));
+  for (int i=0;i<totalNNZ;i++) {
+    const int r = (int) nonZeros[i].row;
+    const int c = (int) nonZeros[i].col;
+    if (r==c) continue;
+    rowStarts[r+1]++;
+    rowStarts[c+1]++;
+  }
+  for (int n=0;n<Ncoarse;n++) rowStarts[n+1] += rowStarts[n];
+
+  int *cols = (int *) calloc(rowStarts[Ncoarse]+1,sizeof(int));
+  int *cnt  = (int *) calloc(Ncoarse,sizeof(int));
+  for (int i=0;i<totalNNZ;i++) {
+    const int r = (int) nonZeros[i].row;
+    const int c = (int) nonZeros[i].col;
+    if (r==c) continue;
+    cols[rowStarts[r]+cnt[r]++] = c;
+    cols[rowStarts[c]+cnt[c]++] = r;
+  }
+
+  perm = (int *) calloc(Ncoarse,sizeof(int));
+  reverseCuthillMcKee(Ncoarse, rowStarts, cols, perm);
+
+  int *iperm = (int *) calloc(Ncoarse,sizeof(int));
+  for (int n=0;n<Ncoarse;n++) iperm[perm[n]] = n;
+
+  //envelope of the permuted lower triangle
+  envFirst = (int *) calloc(Ncoarse,sizeof(int));
+  for (int n=0;n<Ncoarse;n++) envFirst[n] = n;
+  for (int i=0;i<totalNNZ;i++) {
+    const int r = iperm[nonZeros[i].row];
+    const int c = iperm[nonZeros[i].col];
+    const int hi = (r>c) ? r : c;
+    const int lo = (r>c) ? c : r;
+    if (lo<envFirst[hi]) envFirst[hi] = lo;
+  }
+
+  envStarts = (size_t *) calloc(Ncoarse+1,sizeof(size_t));
+  for (int n=0;n<Ncoarse;n++)
+    envStarts[n+1] = envStarts[n] + (size_t) (n-envFirst[n]);
+
+  envL = (dfloat *) calloc(envStarts[Ncoarse]+1,sizeof(dfloat));
+  invD = (dfloat *) calloc(Ncoarse,sizeof(dfloat));
+
+  //scatter the lower triangle (and diagonal) of PAP^T into the envelope
+  dfloat *D = invD;
+  for (int i=0;i<totalNNZ;i++) {
+    const int r = iperm[nonZeros[i].row];
+    const int c = iperm[nonZeros[i].col];
+    if (r==c)
+      D[r] += nonZeros[i].val;
+    else if (r>c)
+      envL[envStarts[r]+(c-envFirst[r])] += nonZeros[i].val;
+  }
+
+  //row-by-row envelope LDL^T
+  for (int i=0;i<Ncoarse;i++) {
+    const int fi = envFirst[i];
+    dfloat *Li = envL + envStarts[i] - fi;
+
+    //Li[j] <- a_ij - sum_k (L_ik d_k) L_jk
+    for (int j=fi;j<i;j++) {
+      const int fj = envFirst[j];
+      const dfloat *Lj = envL + envStarts[j] - fj;
+
+      dfloat sum = Li[j];
+      for (int k=(fi>fj ? fi : fj);k<j;k++)
+        sum -= Li[k]*Lj[k];
+      Li[j] = sum;
+    }
+
+    const dfloat aii = D[i];
+    dfloat d = aii;
+    for (int k=fi;k<i;k++) {
+      const dfloat lk = Li[k]*invD[k];
+      d -= Li[k]*lk;
+      Li[k] = lk;
+    }
+
+    //the last pivot of a singular operator vanishes; pin it
+    if (nullSpace && i==Ncoarse-1) {
+      invD[i] = 0.0;
+      continue;
+    }
+
+    //any other vanishing pivot means the coarse operator is singular
+    if (fabs(d) <= 1e-12*fabs(aii)) {
+      printf("Sparse coarse solver: zero pivot %g in row %d (diagonal %g)\n", d, i, aii);
+      exit(-1);
+    }
+    invD[i] = 1.0/d;
+  }
+
+  if (nullSpace) {
+    nullCoarse = (dfloat *) calloc(Ncoarse,sizeof(dfloat));
+    nullNorm2 = 0.0;
+    for (int n=0;n<Ncoarse;n++) {
+      nullCoarse[n] = nullTotal[n];
+      nullNorm2 += nullTotal[n]*nullTotal[n];
+    }
+  }
+
+  if (options.compareArgs("VERBOSE","TRUE")) {
+    printf("Sparse coarse solver: N = %d, envelope nnz = %zu (dense %zu)\n",
+           Ncoarse, envStarts[Ncoarse], (size_t) Ncoarse*(size_t) (Ncoarse-1)/2);
+  }
+
+  free(rowStarts);
+  free(cols);
+  free(cnt);
+  free(iperm);
+}
+
+void coarseSolver::solveSparse(dfloat *rhs, dfloat *x) {
+
+  int rank;
+  MPI_Comm_rank(comm,&rank);
+
+  MPI_Gatherv(rhs,                  N,                MPI_DFLOAT,
+              rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT, 0, comm);
+
+  if (rank==0) {
+    const int Ncoarse = coarseTotal;
+
+    //with a null space n, (A + s n n^T) x = b is solved by x = y + a n where
+    // A y = b - (n.b/n.n) n, y.n = 0, and a = n.b/(s (n.n)^2)
+    dfloat nb = 0.0;
+    if (nullSpace) {
+      for (int n=0;n<Ncoarse;n++) nb += nullCoarse[n]*rhsCoarse[n];
+      const dfloat alpha = nb/nullNorm2;
+      for (int n=0;n<Ncoarse;n++) rhsCoarse[n] -= alpha*nullCoarse[n];
+    }
+
+    dfloat *z = xCoarse;
+    for (int n=0;n<Ncoarse;n++) z[n] = rhsCoarse[perm[n]];
+
+    //forward solve with L
+    for (int i=0;i<Ncoarse;i++) {
+      const int fi = envFirst[i];
+      const dfloat *Li = envL + envStarts[i] - fi;
+      dfloat sum = z[i];
+      for (int k=fi;k<i;k++) sum -= Li[k]*z[k];
+      z[i] = sum;
+    }
+
+    for (int i=0;i<Ncoarse;i++) z[i] *= invD[i];
+
+    //backward solve with L^T
+    for (int i=Ncoarse-1;i>=0;i--) {
+      const int fi = envFirst[i];
+      const dfloat *Li = envL + envStarts[i] - fi;
+      const dfloat zi = z[i];
+      for (int k=fi;k<i;k++) z[k] -= Li[k]*zi;
+    }
+
+    //unpermute into rhsCoarse, which is scattered back below
+    for (int n=0;n<Ncoarse;n++) rhsCoarse[perm[n]] = z[n];
+
+    if (nullSpace) {
+      dfloat ny = 0.0;
+      for (int n=0;n<Ncoarse;n++) ny += nullCoarse[n]*rhsCoarse[n];
+      const dfloat alpha = -ny/nullNorm2 + nb/(nullSpacePenalty*nullNorm2*nullNorm2);
+      for (int n=0;n<Ncoarse;n++) rhsCoarse[n] += alpha*nullCoarse[n];
+    }
+  }
+
+  MPI_Scatterv(rhsCoarse, coarseCounts, coarseOffsets, MPI_DFLOAT,
+               x,                  N,                MPI_DFLOAT, 0, comm);
+}
+
+} //namespace parAlmond
@@ -38,6 +38,8 @@ occa::kernel SpMVellKernel1;
 occa::kernel SpMVellKernel2;
 occa::kernel SpMVmcsrKernel1;
 occa::kernel SpMVmcsrKernel2;
+occa::kernel SpMVsellKernel1;
+occa::kernel SpMVsellKernel2;
 
 occa::kernel vectorSetKernel;
 occa::kernel vectorScaleKernel;
@@ -86,6 +88,7 @@ void buildParAlmondKernels(MPI_Comm comm, occa::device device){
   }
 
   kernelInfo["defines/" "p_BLOCKSIZE"]= BLOCKSIZE;
+  kernelInfo["defines/" "p_SELL_C"]= SELL_C;
 
   if(device.mode()=="OpenCL"){
     //kernelInfo["compiler_flags"] += "-cl-opt-disable";
@@ -109,6 +112,8 @@ void buildParAlmondKernels(MPI_Comm comm, occa::device device){
       SpMVellKernel2  = device.buildKernel(DPARALMOND"/okl/SpMVell.okl",  "SpMVell2",  kernelInfo);
       SpMVmcsrKernel1 = device.buildKernel(DPARALMOND"/okl/SpMVmcsr.okl", "SpMVmcsr1", kernelInfo);
       SpMVmcsrKernel2 = device.buildKernel(DPARALMOND"/okl/SpMVmcsr.okl", "SpMVmcsr2", kernelInfo);
+      SpMVsellKernel1 = device.buildKernel(DPARALMOND"/okl/SpMVsell.okl", "SpMVsell1", kernelInfo);
+      SpMVsellKernel2 = device.buildKernel(DPARALMOND"/okl/SpMVsell.okl", "SpMVsell2", kernelInfo);
 
       vectorSetKernel = device.buildKernel(DPARALMOND"/okl/vectorSet.okl", "vectorSet", kernelInfo);
       vectorScaleKernel = device.buildKernel(DPARALMOND"/okl/vectorScale.okl", "vectorScale", kernelInfo);
@@ -144,6 +149,8 @@ void freeParAlmondKernels() {
   SpMVellKernel2.free();
   SpMVmcsrKernel1.free();
   SpMVmcsrKernel2.free();
+  SpMVsellKernel1.free();
+  SpMVsellKernel2.free();
 
   vectorSetKernel.free();
   vectorScaleKernel.free();
@@ -114,6 +114,130 @@ void MCSR::syncToDevice(occa::device device) {
   }
 }
 
+//------------------------------------------------------------------------
+//
+//  SELL-C-sigma matrix
+//
+//------------------------------------------------------------------------
+SELL::SELL(dlong N, dlong M): matrix_t(N,M) {}
+
+typedef struct {
+  dlong row;
+  dlong length;
+} sellRow_t;
+
+//longest rows first, ties kept in row order
+static int compareSellRows(const void *a, const void *b){
+  const sellRow_t *ra = (const sellRow_t *) a;
+  const sellRow_t *rb = (const sellRow_t *) b;
+
+  if (ra->length > rb->length) return -1;
+  if (ra->length < rb->length) return +1;
+
+  if (ra->row < rb->row) return -1;
+  if (ra->row > rb->row) return +1;
+
+  return 0;
+}
+
+SELL::SELL(CSR *A, int Sigma): matrix_t(A->Nrows, A->Ncols) {
+
+  //windows hold whole chunks
+  sigma = ((Sigma+SELL_C-1)/SELL_C)*SELL_C;
+  if (sigma<SELL_C) sigma = SELL_C;
+
+  Nchunks = (Nrows+SELL_C-1)/SELL_C;
+
+  rowIds = (dlong *) malloc(Nchunks*SELL_C*sizeof(dlong));
+  for (dlong n=0;n<Nchunks*SELL_C;n++) rowIds[n] = -1;
+
+  //sort the rows by length inside each window
+  sellRow_t *window = (sellRow_t *) malloc(sigma*sizeof(sellRow_t));
+  for (dlong start=0;start<Nrows;start+=sigma) {
+    dlong Nwindow = (start+sigma < Nrows) ? sigma : Nrows-start;
+
+    for (dlong n=0;n<Nwindow;n++) {
+      window[n].row = start+n;
+      window[n].length = A->rowStarts[start+n+1]-A->rowStarts[start+n];
+    }
+    qsort(window, Nwindow, sizeof(sellRow_t), compareSellRows);
+
+    for (dlong n=0;n<Nwindow;n++)
+      rowIds[start+n] = window[n].row;
+  }
+  free(window);
+
+  //each chunk is as wide as its longest row
+  chunkStarts = (dlong *) calloc(Nchunks+1, sizeof(dlong));
+  for (dlong c=0;c<Nchunks;c++) {
+    dlong width = 0;
+    for (int r=0;r<SELL_C;r++) {
+      dlong row = rowIds[c*SELL_C+r];
+      if (row<0) continue;
+      dlong length = A->rowStarts[row+1]-A->rowStarts[row];
+      width = (length > width) ? length : width;
+    }
+    chunkStarts[c+1] = chunkStarts[c] + width*SELL_C;
+  }
+  nnz = chunkStarts[Nchunks];
+
+  cols = (dlong *)  malloc(nnz*sizeof(dlong));
+  vals = (dfloat *) calloc(nnz, sizeof(dfloat));
+  for (dlong n=0;n<nnz;n++) cols[n] = -1;
+
+  for (dlong c=0;c<Nchunks;c++) {
+    for (int r=0;r<SELL_C;r++) {
+      dlong row = rowIds[c*SELL_C+r];
+      if (row<0) continue;
+
+      dlong Jstart = A->rowStarts[row];
+      dlong Jend   = A->rowStarts[row+1];
+      for (dlong jj=Jstart;jj<Jend;jj++) {
+        dlong id = chunkStarts[c] + (jj-Jstart)*SELL_C + r;
+        cols[id] = A->cols[jj];
+        vals[id] = A->vals[jj];
+      }
+    }
+  }
+}
+
+SELL::~SELL() {
+  free(chunkStarts);
+  free(rowIds);
+  free(cols);
+  free(vals);
+
+  if (o_chunkStarts.size()) o_chunkStarts.free();
+  if (o_rowIds.size()) o_rowIds.free();
+  if (o_cols.size()) o_cols.free();
+  if (o_vals.size()) o_vals.free();
+}
+
+void SELL::syncToDevice(occa::device device) {
+  if (Nchunks) {
+    o_chunkStarts = device.malloc((Nchunks+1)*sizeof(dlong), chunkStarts);
+    o_rowIds      = device.malloc(Nchunks*SELL_C*sizeof(dlong), rowIds);
+  }
+  if (nnz) {
+    o_cols = device.malloc(nnz*sizeof(dlong),  cols);
+    o_vals = device.malloc(nnz*sizeof(dfloat), vals);
+  }
+}
+
+void SELL::refreshValues(CSR *A) {
+  for (dlong c=0;c<Nchunks;c++) {
+    for (int r=0;r<SELL_C;r++) {
+      dlong row = rowIds[c*SELL_C+r];
+      if (row<0) continue;
+
+      dlong Jstart = A->rowStarts[row];
+      dlong Jend   = A->rowStarts[row+1];
+      for (dlong jj=Jstart;jj<Jend;jj++)
+        vals[chunkStarts[c] + (jj-Jstart)*SELL_C + r] = A->vals[jj];
+    }
+  }
+}
+
 //------------------------------------------------------------------------
 //
 //  parCSR matrix
@@ -237,6 +361,39 @@ parCSR::parCSR(dlong N,         // number of rows on this rank
   for (dlong n=0;n<Nrows;n++) diagInv[n] = 1.0/diagA[n];
 }
 
+void parCSR::refreshValues(dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals) {
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  hlong globalOffset = globalRowStarts[rank];
+
+  //same fill order as the COO constructor
+  dlong diagCnt = 0;
+  dlong offdCnt = 0;
+  for (dlong n=0;n<Ncols;n++) diagA[n] = 0.0;
+  for (dlong n=0;n<nnz;n++) {
+    if ((Aj[n] < globalOffset) || (Aj[n]>globalOffset+Nrows-1)) {
+      offd->vals[offdCnt++] = Avals[n];
+    } else {
+      diag->vals[diagCnt] = Avals[n];
+
+      //record the diagonal
+      dlong row = (dlong) (Ai[n] - globalOffset);
+      if (row==diag->cols[diagCnt])
+        diagA[row] = diag->vals[diagCnt];
+
+      diagCnt++;
+    }
+  }
+
+  //fill the halo region
+  ogsGatherScatter(diagA, ogsDfloat, ogsAdd, ogs);
+
+  //compute the inverse diagonal
+  for (dlong n=0;n<Nrows;n++) diagInv[n] = 1.0/diagA[n];
+}
+
 void parCSR::haloSetup(hlong *colIds) {
 
   int rank, size;
@@ -501,7 +658,7 @@ dfloat parCSR::rhoDinvA(){
 //------------------------------------------------------------------------
 
 //build from parCSR
-parHYB::parHYB(parCSR *A): matrix_t(A->Nrows, A->Ncols) {
+parHYB::parHYB(parCSR *A, FormatType ftype): matrix_t(A->Nrows, A->Ncols) {
 
   int *rowCounters = (int*) calloc(A->Nrows, sizeof(int));
 
@@ -554,11 +711,27 @@ parHYB::parHYB(parCSR *A): matrix_t(A->Nrows, A->Ncols) {
 
   int nnzPerRow = maxNnzPerRow;
 
+  //CSR keeps the whole local block in the MCSR part
+  if (ftype==FORMAT_CSR) nnzPerRow = 0;
+
+  //SELL-C-sigma pads each chunk to its own longest row instead of the
+  // global one, AUTO keeps it when that saves enough of the ELL padding
+  if ((ftype==FORMAT_SELL)||(ftype==FORMAT_AUTO)) {
+    S = new SELL(A->diag);
+
+    double ellEntries = (double) Nrows*maxNnzPerRow;
+    if ((ftype==FORMAT_AUTO)&&(S->nnz >= SELL_SWITCH*ellEntries)) {
+      delete S;
+      S = NULL;
+    }
+  }
+
   //build the ELL matrix from the local CSR
   E = new ELL(Nrows, Ncols);
   C = new MCSR(Nrows, Ncols);
 
-  E->nnzPerRow = nnzPerRow;
+  const int ellWidth = (S) ? 0 : nnzPerRow;
+  E->nnzPerRow = ellWidth;
 
   E->cols  = (dlong *) calloc(Nrows*E->nnzPerRow, sizeof(dlong));
   E->vals = (dfloat *) calloc(Nrows*E->nnzPerRow, sizeof(dfloat));
@@ -571,16 +744,16 @@ parHYB::parHYB(parCSR *A): matrix_t(A->Nrows, A->Ncols) {
     dlong Jend   = A->diag->rowStarts[i+1];
     int rowNnz = (int)  (Jend - Jstart);
 
-    // store only min of nnzPerRow and rowNnz
-    int maxNnz = (nnzPerRow >= rowNnz) ? rowNnz : nnzPerRow;
+    // store only min of ellWidth and rowNnz
+    int maxNnz = (ellWidth >= rowNnz) ? rowNnz : ellWidth;
 
     for(int c=0; c<maxNnz; c++){
-      E->cols[i*nnzPerRow+c] = A->diag->cols[Jstart+c];
-      E->vals[i*nnzPerRow+c] = A->diag->vals[Jstart+c];
+      E->cols[i*ellWidth+c] = A->diag->cols[Jstart+c];
+      E->vals[i*ellWidth+c] = A->diag->vals[Jstart+c];
     }
 
-    for(int c=maxNnz; c<nnzPerRow; c++){
-      E->cols[i*nnzPerRow+c] = -1; //ignore this column
+    for(int c=maxNnz; c<ellWidth; c++){
+      E->cols[i*ellWidth+c] = -1; //ignore this column
     }
 
     // count the number of nonzeros to be stored in MCSR format
@@ -668,6 +841,7 @@ parHYB::parHYB(parCSR *A): matrix_t(A->Nrows, A->Ncols) {
 parHYB::~parHYB() {
   delete E;
   delete C;
+  if (S) delete S;
 
   free(diagA);
   free(diagInv);
@@ -692,6 +866,7 @@ void parHYB::syncToDevice() {
 
   E->syncToDevice(device);
   C->syncToDevice(device);
+  if (S) S->syncToDevice(device);
 
   if (Nrows) {
     o_diagA   = device.malloc(Nrows*sizeof(dfloat), diagA);
@@ -705,6 +880,52 @@ void parHYB::syncToDevice() {
     o_haloIds = device.malloc(Nshared*sizeof(dlong), haloIds);
 }
 
+void parHYB::refreshValues(parCSR *A) {
+
+  const int nnzPerRow = E->nnzPerRow;
+
+  //the SELL part holds the whole local block
+  if (S) S->refreshValues(A->diag);
+
+  dlong cnt = 0;
+  for(dlong i=0; i<Nrows; i++){
+    dlong Jstart = A->diag->rowStarts[i];
+    dlong Jend   = A->diag->rowStarts[i+1];
+    int rowNnz = (int)  (Jend - Jstart);
+    int maxNnz = (nnzPerRow >= rowNnz) ? rowNnz : nnzPerRow;
+
+    if (!S) {
+      for(int c=0; c<maxNnz; c++)
+        E->vals[i*nnzPerRow+c] = A->diag->vals[Jstart+c];
+
+      for(int c=nnzPerRow; c<rowNnz; c++)
+        C->vals[cnt++] = A->diag->vals[Jstart+c];
+    }
+
+    for (dlong j=A->offd->rowStarts[i];j<A->offd->rowStarts[i+1];j++)
+      C->vals[cnt++] = A->offd->vals[j];
+  }
+
+  if(nnzPerRow && Nrows){
+    dfloat *valsT = (dfloat *) malloc(Nrows*nnzPerRow*sizeof(dfloat));
+    for (dlong n=0;n<Nrows;n++)
+      for (int i=0;i<nnzPerRow;i++)
+        valsT[n+i*Nrows] = E->vals[n*nnzPerRow+i];
+
+    E->o_vals.copyFrom(valsT, Nrows*nnzPerRow*sizeof(dfloat), 0);
+    free(valsT);
+  }
+
+  if (C->nnz) C->o_vals.copyFrom(C->vals, C->nnz*sizeof(dfloat), 0);
+  if (S && S->nnz) S->o_vals.copyFrom(S->vals, S->nnz*sizeof(dfloat), 0);
+
+  //diagA and diagInv are shared with A
+  if (Nrows) {
+    o_diagA.copyFrom(diagA, Nrows*sizeof(dfloat), 0);
+    o_diagInv.copyFrom(diagInv, Nrows*sizeof(dfloat), 0);
+  }
+}
+
 void parHYB::haloExchangeStart(dfloat *x) {
   // copy data from outgoing elements into temporary send buffer
   for(int i=0;i<Nshared;++i){
@@ -102,7 +102,7 @@ void solver_t::device_kcycle(int k){
   occa::memory o_res = level->o_res;
 
   //check for device<->host handoff
-  if(m < GPU_CPU_SWITCH_SIZE){
+  if(k>=hostLevel){
     o_rhs.copyTo(level->rhs, m*sizeof(dfloat));
     this->kcycle(k);
     o_x.copyFrom(level->x, m*sizeof(dfloat));
@@ -209,7 +209,7 @@ void solver_t::device_vcycle(int k){
   occa::memory o_res = level->o_res;
 
   //check for device<->host handoff
-  if(m < GPU_CPU_SWITCH_SIZE){
+  if(k>=hostLevel){
     o_rhs.copyTo(level->rhs, m*sizeof(dfloat));
     vcycle(k);
     o_x.copyFrom(level->x, m*sizeof(dfloat));
@@ -58,6 +58,8 @@ void AMGSetup(solver_t *MM,
 
   if(rank==0) printf("Setting up AMG...");fflush(stdout);
 
+  double tic = MPI_Wtime();
+
   //populate null space vector
   dfloat *null = (dfloat *) calloc(numLocalRows, sizeof(dfloat));
   for (dlong i=0;i<numLocalRows;i++) null[i] = 1/sqrt(TotalRows);
@@ -70,7 +72,28 @@ void AMGSetup(solver_t *MM,
 
   M->AMGSetup(A);
 
-  if(rank==0) printf("done.\n");
+  M->setupTime = MPI_Wtime()-tic;
+  MPI_Allreduce(MPI_IN_PLACE, &(M->setupTime), 1, MPI_DOUBLE, MPI_MAX, M->comm);
+
+  if(rank==0) printf("done (%g s).\n", M->setupTime);
+}
+
+void AMGRefresh(solver_t *M,
+                dlong nnz,
+                hlong* Ai,
+                hlong* Aj,
+                dfloat* Avals){
+
+  if(M->rank==0) printf("Refreshing AMG values...");fflush(stdout);
+
+  double tic = MPI_Wtime();
+
+  M->AMGRefresh(nnz, Ai, Aj, Avals);
+
+  M->refreshTime = MPI_Wtime()-tic;
+  MPI_Allreduce(MPI_IN_PLACE, &(M->refreshTime), 1, MPI_DOUBLE, MPI_MAX, M->comm);
+
+  if(M->rank==0) printf("done (%g s, full setup %g s).\n", M->refreshTime, M->setupTime);
 }
 
 void Precon(solver_t *M, occa::memory o_x, occa::memory o_rhs) {
@@ -66,6 +66,22 @@ solver_t::solver_t(occa::device device_, MPI_Comm comm_,
   } else { //default to DAMPED_JACOBI
     stype = DAMPED_JACOBI;
   }
+
+  //storage format of the device level operators
+  if (options.compareArgs("PARALMOND MATRIX FORMAT", "ELL")) {
+    ftype = FORMAT_ELL;
+  } else if (options.compareArgs("PARALMOND MATRIX FORMAT", "SELL")) {
+    ftype = FORMAT_SELL;
+  } else if (options.compareArgs("PARALMOND MATRIX FORMAT", "CSR")) {
+    ftype = FORMAT_CSR;
+  } else { //default to AUTO
+    ftype = FORMAT_AUTO;
+  }
+
+  //levels with fewer rows per rank than this run on the threaded host path
+  hostSwitchSize = GPU_CPU_SWITCH_SIZE;
+  options.getArgs("PARALMOND HOST SWITCH SIZE", hostSwitchSize);
+  hostLevel = MAX_LEVELS;
 }
 
 solver_t::~solver_t() {
@@ -93,6 +109,9 @@ void solver_t::Report() {
 
   if(rank==0)
     printf("--------------------------------------------------------------------------\n");
+
+  if((rank==0)&&(hostLevel<numLevels))
+    printf("levels %d to %d are cycled on the host\n", hostLevel, numLevels-1);
 }
 
 }
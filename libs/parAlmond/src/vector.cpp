@@ -34,26 +34,29 @@ namespace parAlmond {
 //
 //------------------------------------------------------------------------
 
+// host loops are split over the OpenMP threads once they are long enough
+// to amortise the fork; reductions combine per-thread partial sums
+
 void vectorSet(const dlong m, const dfloat alpha, dfloat *a){
-  // #pragma omp parallel for
+  #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<m; i++)
     a[i] = alpha;
 }
 
 void vectorRandomize(const dlong m, dfloat *a){
-  // #pragma omp parallel for
+  // drand48 keeps one global state, so this stays serial
   for(dlong i=0; i<m; i++)
     a[i] = (dfloat) drand48();
 }
 
 void vectorScale(const dlong m, const dfloat alpha, dfloat *a){
-  // #pragma omp parallel for
+  #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<m; i++)
     a[i] *= alpha;
 }
 
 void vectorAddScalar(const dlong m, const dfloat alpha, dfloat *a){
-  // #pragma omp parallel for
+  #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<m; i++)
     a[i] += alpha;
 }
@@ -62,11 +65,11 @@ void vectorAddScalar(const dlong m, const dfloat alpha, dfloat *a){
 void vectorAdd(const dlong n, const dfloat alpha, const dfloat *x,
                const dfloat beta, dfloat *y){
   if (beta) {
-    // #pragma omp parallel for
+    #pragma omp parallel for if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++)
       y[i] = beta*y[i] + alpha*x[i];
   } else {
-    // #pragma omp parallel for
+    #pragma omp parallel for if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++)
       y[i] = alpha*x[i];
   }
@@ -75,14 +78,14 @@ void vectorAdd(const dlong n, const dfloat alpha, const dfloat *x,
 // z = beta*y + alpha*x
 void vectorAdd(const dlong n, const dfloat alpha, const dfloat *x,
                const dfloat beta, const dfloat *y, dfloat *z){
-  // #pragma omp parallel for
+  #pragma omp parallel for if(n>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<n; i++)
     z[i] = beta*y[i] + alpha*x[i];
 }
 
 // b = a*b
 void vectorDotStar(const dlong m, const dfloat *a, dfloat *b){
-  // #pragma omp parallel for
+  #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<m; i++)
     b[i] *= a[i];
 }
@@ -91,19 +94,54 @@ void vectorDotStar(const dlong m, const dfloat *a, dfloat *b){
 void vectorDotStar(const dlong m, const dfloat alpha, const dfloat *a,
                    const dfloat *b, const dfloat beta,  dfloat *c){
   if (beta) {
-    // #pragma omp parallel for
+    #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<m; i++)
       c[i] = beta*c[i]+ alpha*a[i]*b[i];
   } else {
-    // #pragma omp parallel for
+    #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<m; i++)
       c[i] = alpha*a[i]*b[i];
   }
 }
 
+// d = alpha*a*b + beta*d and c = gamma*d
+void vectorDotStarAdd(const dlong m, const dfloat alpha, const dfloat *a,
+                      const dfloat *b, const dfloat beta, dfloat *d,
+                      const dfloat gamma, dfloat *c){
+  if (beta) {
+    #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
+    for(dlong i=0; i<m; i++){
+      const dfloat di = beta*d[i] + alpha*a[i]*b[i];
+      d[i] = di;
+      c[i] = gamma*di;
+    }
+  } else {
+    #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
+    for(dlong i=0; i<m; i++){
+      const dfloat di = alpha*a[i]*b[i];
+      d[i] = di;
+      c[i] = gamma*di;
+    }
+  }
+}
+
+// Chebyshev step: x = x + d, r = r - invD*Ad, d = alpha*r + beta*d
+void vectorChebyshevUpdate(const dlong m, const dfloat *invD, const dfloat *Ad,
+                           const dfloat alpha, const dfloat beta,
+                           dfloat *r, dfloat *d, dfloat *x){
+  #pragma omp parallel for if(m>HOST_OMP_MIN_SIZE)
+  for(dlong i=0; i<m; i++){
+    const dfloat di = d[i];
+    const dfloat ri = r[i] - invD[i]*Ad[i];
+    x[i] += di;
+    r[i] = ri;
+    d[i] = alpha*ri + beta*di;
+  }
+}
+
 dfloat vectorNorm(const dlong n, const dfloat *a, MPI_Comm comm){
   dfloat result = 0., gresult = 0.;
-  // #pragma omp parallel for reduction(+:result)
+  #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<n; i++)
     result += a[i]*a[i];
 
@@ -114,7 +152,7 @@ dfloat vectorNorm(const dlong n, const dfloat *a, MPI_Comm comm){
 dfloat vectorInnerProd(const dlong n, const dfloat *a, const dfloat *b,
                        MPI_Comm comm){
   dfloat result = 0., gresult = 0.;
-  // #pragma omp parallel for reduction(+:result)
+  #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<n; i++)
     result += a[i]*b[i];
 
@@ -126,7 +164,7 @@ dfloat vectorMaxAbs(const dlong n, const dfloat *a, MPI_Comm comm){
   dfloat maxVal=0.0;
   dfloat gmaxVal=0.0;
 
-  //  #pragma omp parallel for reduction(max:maxVal)
+  #pragma omp parallel for reduction(max:maxVal) if(n>HOST_OMP_MIN_SIZE)
   for(dlong i=0; i<n; i++){
     dfloat a2 = (a[i] < 0) ? -a[i] : a[i];
     if(maxVal < a2){
@@ -142,22 +180,23 @@ dfloat vectorMaxAbs(const dlong n, const dfloat *a, MPI_Comm comm){
 void kcycleCombinedOp1(const dlong n, dfloat *aDotbc, const dfloat *a,
                       const dfloat *b, const dfloat *c, const dfloat* w,
                       const bool weighted, MPI_Comm comm) {
-  dfloat result[3] = {0.,0.,0.};
+  dfloat aDotb = 0., aDotc = 0., bDotb = 0.;
   if (weighted) {
-    // #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:bDotb)
+    #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:bDotb) if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++) {
-      result[0] += w[i]*a[i]*b[i];
-      result[1] += w[i]*a[i]*c[i];
-      result[2] += w[i]*b[i]*b[i];
+      aDotb += w[i]*a[i]*b[i];
+      aDotc += w[i]*a[i]*c[i];
+      bDotb += w[i]*b[i]*b[i];
     }
   } else {
-    // #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:bDotb)
+    #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:bDotb) if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++) {
-      result[0] += a[i]*b[i];
-      result[1] += a[i]*c[i];
-      result[2] += b[i]*b[i];
+      aDotb += a[i]*b[i];
+      aDotc += a[i]*c[i];
+      bDotb += b[i]*b[i];
     }
   }
+  dfloat result[3] = {aDotb, aDotc, bDotb};
   MPI_Allreduce(result,aDotbc,3,MPI_DFLOAT,MPI_SUM,comm);
 }
 
@@ -165,22 +204,23 @@ void kcycleCombinedOp1(const dlong n, dfloat *aDotbc, const dfloat *a,
 void kcycleCombinedOp2(const dlong n, dfloat *aDotbcd, const dfloat *a,
                        const dfloat *b, const dfloat *c, const dfloat* d,
                        const dfloat *w, const bool weighted, MPI_Comm comm) {
-  dfloat result[3] = {0.,0.,0.};
+  dfloat aDotb = 0., aDotc = 0., aDotd = 0.;
   if (weighted) {
-    // #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:aDotd)
+    #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:aDotd) if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++) {
-      result[0] += w[i]*a[i]*b[i];
-      result[1] += w[i]*a[i]*c[i];
-      result[2] += w[i]*a[i]*d[i];
+      aDotb += w[i]*a[i]*b[i];
+      aDotc += w[i]*a[i]*c[i];
+      aDotd += w[i]*a[i]*d[i];
     }
   } else {
-    // #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:aDotd)
+    #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:aDotd) if(n>HOST_OMP_MIN_SIZE)
     for(dlong i=0; i<n; i++) {
-      result[0] += a[i]*b[i];
-      result[1] += a[i]*c[i];
-      result[2] += a[i]*d[i];
+      aDotb += a[i]*b[i];
+      aDotc += a[i]*c[i];
+      aDotd += a[i]*d[i];
     }
   }
+  dfloat result[3] = {aDotb, aDotc, aDotd};
   MPI_Allreduce(result,aDotbcd,3,MPI_DFLOAT,MPI_SUM,comm);
 }
 
@@ -194,13 +234,13 @@ dfloat vectorAddInnerProd(const dlong n, const dfloat alpha, const dfloat *x,
   dfloat gresult = 0.;
   if (weighted) {
     if (beta) {
-      // #pragma omp parallel for reduction(+:result)
+      #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
       for(dlong i=0; i<n; i++) {
         y[i] = beta*y[i] + alpha*x[i];
         result += w[i]*y[i]*y[i];
       }
     } else {
-      // #pragma omp parallel for reduction(+:result)
+      #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
       for(dlong i=0; i<n; i++) {
         y[i] = alpha*x[i];
         result += w[i]*y[i]*y[i];
@@ -208,13 +248,13 @@ dfloat vectorAddInnerProd(const dlong n, const dfloat alpha, const dfloat *x,
     }
   } else {
     if (beta) {
-      // #pragma omp parallel for reduction(+:result)
+      #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
       for(dlong i=0; i<n; i++) {
         y[i] = beta*y[i] + alpha*x[i];
         result += y[i]*y[i];
       }
     } else {
-      // #pragma omp parallel for reduction(+:result)
+      #pragma omp parallel for reduction(+:result) if(n>HOST_OMP_MIN_SIZE)
       for(dlong i=0; i<n; i++) {
         y[i] = alpha*x[i];
         result += y[i]*y[i];
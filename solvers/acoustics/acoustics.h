@@ -33,16 +33,58 @@ SOFTWARE.
 #include "mesh.h"
 #include "mesh2D.h"
 #include "mesh3D.h"
+#include "kernelProfile.h"
+#include "kernelBuilder.h"
 
 // block size for reduction (hard coded)
 #define blockSize 256
 
+// [EA] Number of incidence angles tabulated in ER vectfit files
+#define ERNangles 91
 
+// [EA] Number of uniform |cos(angle)| bins of the device ER table
+#define ERNcos 128
+
+// [EA] Face node permutations of a triangle face, compact geometry table size
+#define acousticsMaxFaceRot 6
+
+// [EA] Impedance material, one LR or ER vectfit dataset bound to a Gmsh
+// physical surface. Boundary points are packed by material so every batch
+// has uniform pole counts.
+typedef struct{
+
+  int physicalId; // Gmsh physical surface id
+  int type; // 3 = local reaction, 4 = extended reaction
+  dlong Npoles, Nreal, Nimag; // Nimag counts complex conjugate pairs
+
+  dlong Npoints; // local boundary points of this material
+  dlong pointOffset; // first point in mapAccToQ
+  dlong accOffset; // first accumulator
+
+  dfloat *coeffs;
+  occa::memory o_coeffs;
+
+  // built once per pole signature and shared between materials
+  occa::kernel impedanceKernel;
+  occa::kernel updateEIRK4AccKernel;
+
+}acousticsMaterial_t;
 
 typedef struct{
 
   int dim;
   int elementType; // number of edges (3=tri, 4=quad, 6=tet, 12=hex)
+
+  // [EA] OpenMP/Serial backends: element-blocked volume/surface kernels and
+  // first-touch placement of the element fields
+  int cpuMode;
+  int NblockCPU;
+
+  // [EA] Compact face geometry (affine tets): neighbour element and face
+  // rotation code per face, float normals, lift scale and rotation table
+  int compactGeometry;
+  int NfaceRot;
+  occa::memory o_EToEP, o_faceCode, o_faceNormals, o_faceScale, o_faceRot, o_faceNodes;
   
   int Nfields;
 
@@ -59,9 +101,18 @@ typedef struct{
   dfloat *Snapshott;
   dlong snapshotMax;
 
+  // Running DFT of q at [DFT FREQUENCIES], sampled every [DFT EVERY] steps
+  int NdftFreqs;
+  int dftEvery;
+  dlong dftCounter;
+  dfloat *dftFreqs;
+  dfloat *qDFT; // [freq][Re,Im][Nelements*Nfields*Np]
+  occa::memory o_dftFreqs;
+  occa::memory o_qDFT;
+
 
   //---------RECEIVER---------
-  dfloat *qRecv; // Saves pres in receiver element in each timestep
+  dfloat *qRecv; // Saves pres (and particle velocity) at each receiver in each timestep
   dlong qRecvCounter; // To keep track of which timestep we are on
   dlong qRecvCopyCounter;
   dlong *recvElements; // Index to elements where the receivers are located
@@ -69,32 +120,61 @@ typedef struct{
   dfloat *recvXYZ; // XYZ coordinates of receiver
   dlong NReceivers; // Total number of receivers
   dlong NReceiversLocal; // Total number of receivers
-
-  occa::memory o_recvElements;
-  occa::memory o_recvElementsIdx;
+  int NrecvFields; // Channels per receiver, 1: p, Nfields: p,u,v,w ([RECEIVER VELOCITY])
+
+  // Local receivers sorted by element, one group per host element
+  dlong NrecvGroups;
+  dlong *recvGroupStarts; // NrecvGroups+1 offsets into the sorted receivers
+  dlong *recvGroupElements; // Host element of each group
+
+  occa::memory o_recvGroupStarts;
+  occa::memory o_recvGroupElements;
+
+  // In-situ room-acoustic metrics ([ROOM METRICS] TRUE)
+  int metrics;
+  int NmetricBands; // broadband plus octave bands
+  dfloat *metricBands; // centre frequencies, 0 for broadband
+  dfloat *metricCoeffs; // biquad b0 b1 b2 a1 a2 per band
+  dfloat *metricState; // biquad history per receiver and band
+  dfloat *metricEnergy; // squared band pressure per receiver, band and sample
+  dfloat *metricBlockMax; // loudest receiver block so far
+  dfloat decayThreshold; // [DECAY TERMINATION] dB, 0 runs to final time
+  int decayReached; // all local receivers decayed in the latest block
+  dlong NrecvSamples; // receiver samples on the host
+  dlong NtimeStepsDone; // steps taken, less than NtimeSteps after early termination
+
+  // Energy monitor ([ENERGY MONITOR] k > 0)
+  int energyEvery; // steps between energy reductions
+  dfloat energyDecay; // [ENERGY DECAY] dB below peak to stop, 0 off
+  dfloat energyStagnation; // [ENERGY STAGNATION] relative change per check to stop, 0 off
+  dfloat energyStagnationOnset; // [ENERGY STAGNATION ONSET] dB below peak before stagnation is tested
+  dfloat energyGrowth; // [ENERGY GROWTH] energy/peak ratio flagged as unstable
+  dlong NenergyBlocks;
+  dfloat *energyPartial;
+  occa::memory o_energyPartial;
+  dfloat energyLocal, energyGlobal, energyTime;
+  dfloat energyPeak, energyPrev;
+  MPI_Request energyRequest;
+  int energyPending;
+  int unstable;
+  FILE *energyFile;
   //---------RECEIVER---------
 
   dfloat *acc;
   dfloat *rhsacc;
   dfloat *resacc;
-  dlong LRNpoles;
-  dlong LRNRealPoles;
-  dlong LRNImagPoles; // Number of complex conjugate pairs
   dlong NBoundaryPoints;
-  dlong ERNpoles;
-  dlong ERNRealPoles;
-  dlong ERNImagPoles;
 
+  // [EA] Impedance materials ([MATERIALS] table or LRVECTFIT/ERVECTFIT)
+  int Nmaterials;
+  acousticsMaterial_t *materials;
+  int *EToMat; // material of each boundary face, -1 if none
+  dlong NLRAcc, NERAcc; // accumulator lengths, LR block first
+  dfloat *vnAcc;
+  occa::memory o_vnAcc; // normal velocity per impedance boundary point
 
   dfloat BCChangeTime;
-  dfloat *LR;
-  dlong *LRInfo;
-  occa::memory o_LR;
-  occa::memory o_LRInfo;
-  dfloat *ER;
-  dlong *ERInfo;
-  occa::memory o_ER;
-  occa::memory o_ERInfo;
+  int BCChangeMaterial; // LR material the ER points switch to
 
 
   dlong NERComPoints;
@@ -125,7 +205,8 @@ typedef struct{
   occa::memory o_comPointsToSend;
   occa::memory o_vt;
   occa::memory o_vi;
-  occa::memory o_anglei;
+  occa::memory o_ERcos;
+  dfloat ERdx; // distance from the boundary to the wave-splitting points
 
 
 
@@ -178,11 +259,11 @@ typedef struct{
   occa::kernel rkUpdateKernel;
   occa::kernel rkErrorEstimateKernel;
   occa::kernel receiverKernel;
-  occa::kernel updateKernelLR;
-  occa::kernel updateKernelER;
+  occa::kernel updateKernelAcc;
+  occa::kernel updateDFTKernel; // LSERK update fused with the running DFT
+  occa::kernel dftKernel;
+  occa::kernel energyKernel;
   occa::kernel acousticsUpdateEIRK4;
-  occa::kernel acousticsUpdateEIRK4AccLR;
-  occa::kernel acousticsUpdateEIRK4AccER;
   occa::kernel ERangleDetection;
   occa::kernel ERMoveVT;
   occa::kernel ERInsertComVT;
@@ -190,6 +271,7 @@ typedef struct{
   occa::kernel acousticsReceiverInterpolation;
   occa::kernel volumeKernelCurv;
   occa::kernel surfaceKernelCurv;
+  occa::kernel firstTouchKernel;
 
   occa::memory o_q;
   occa::memory o_rhsq;
@@ -214,12 +296,18 @@ typedef struct{
   occa::memory o_errtmp;
   
   //halo data
-  dlong haloBytes;
-  dfloat *sendBuffer;
-  dfloat *recvBuffer;
-  occa::memory o_sendBuffer;
-  occa::memory o_recvBuffer;
-  occa::memory o_haloBuffer;
+  meshHalo_t *halo;
+
+  // kernel counters and their entries
+  // coordinated kernel builds, rank 0 (or one rank per node) compiles
+  kernelBuilder_t *builder;
+
+  kernelProfile_t *profile;
+  int profVolume, profSurface;
+  int profUpdate, profUpdateAcc, profImpedance;
+  int profUpdateEIRK4, profUpdateEIRK4LR, profUpdateEIRK4ER;
+  int profAngleDetection, profReceiver;
+  int profUpdateDFT, profDFT, profEnergy;
 
   // DOPRI5 RK data
   int advSwitch;
@@ -261,6 +349,8 @@ void acousticsFindReceiverElement(acoustics_t *acoustics);
 
 void acousticsRecvIntpolOperators(acoustics_t *acoustics);
 
+void acousticsRecvCopyToHost(acoustics_t *acoustics);
+
 void acousticsPrintReceiversToFile(acoustics_t *acoustics, setupAide &newOptions);
 
 void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dfloat time);
@@ -271,6 +361,40 @@ void acousticsSnapshot(acoustics_t *acoustics, dfloat time, setupAide &newOption
 
 void acousticsSnapshotXYZ(acoustics_t *acoustics, setupAide &newOptions);
 
+void acousticsDFTWrite(acoustics_t *acoustics, setupAide &newOptions);
+
+void acousticsProfileSetup(acoustics_t *acoustics, setupAide &newOptions);
+
+void acousticsCompactGeometrySetup(acoustics_t *acoustics, occa::properties &kernelInfo);
+
+void acousticsMaterialSetup(acoustics_t *acoustics, setupAide &newOptions);
+
+int acousticsMaterialFind(acoustics_t *acoustics, int physicalId);
+
+void acousticsMaterialPack(acoustics_t *acoustics);
+
+void acousticsMaterialKernels(acoustics_t *acoustics, setupAide &newOptions, occa::properties &kernelInfo);
+
+void acousticsImpedance(acoustics_t *acoustics, occa::memory qPtr, occa::memory accPtr, occa::memory rhsaccPtr);
+
+void acousticsUpdateEIRK4Acc(acoustics_t *acoustics, const int stage);
+
+void acousticsMaterialBCChange(acoustics_t *acoustics);
+
+void acousticsMetricsSetup(acoustics_t *acoustics, setupAide &newOptions);
+
+void acousticsMetricsUpdate(acoustics_t *acoustics, dlong start, dlong Nsamples);
+
+int acousticsMetricsStop(acoustics_t *acoustics, int tstep);
+
+void acousticsMetricsWrite(acoustics_t *acoustics, setupAide &newOptions);
+
+void acousticsEnergySetup(acoustics_t *acoustics, setupAide &newOptions);
+
+int acousticsEnergyMonitor(acoustics_t *acoustics, int tstep, dfloat time);
+
+void acousticsEnergyFinalize(acoustics_t *acoustics);
+
 #define TRIANGLES 3
 #define QUADRILATERALS 4
 #define TETRAHEDRA 6
@@ -0,0 +1,168 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.h"
+
+// Energy monitor: every [ENERGY MONITOR] steps the total acoustic energy is
+// reduced on the device and summed over ranks with a non-blocking allreduce.
+// The global value is picked up at the next check, so decisions lag one interval.
+
+void acousticsEnergySetup(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  acoustics->energyEvery = 0;
+  acoustics->energyDecay = 0;
+  acoustics->energyStagnation = 0;
+  acoustics->energyStagnationOnset = 10;
+  acoustics->energyGrowth = 2;
+  newOptions.getArgs("ENERGY MONITOR", acoustics->energyEvery);
+  if(acoustics->energyEvery <= 0){
+    acoustics->energyEvery = 0;
+    return;
+  }
+  newOptions.getArgs("ENERGY DECAY", acoustics->energyDecay);
+  newOptions.getArgs("ENERGY STAGNATION", acoustics->energyStagnation);
+  newOptions.getArgs("ENERGY STAGNATION ONSET", acoustics->energyStagnationOnset);
+  newOptions.getArgs("ENERGY GROWTH", acoustics->energyGrowth);
+
+  acoustics->NenergyBlocks = (mesh->Nelements*mesh->Np+blockSize-1)/blockSize;
+  acoustics->energyPartial = (dfloat*) calloc(acoustics->NenergyBlocks+1, sizeof(dfloat));
+  acoustics->o_energyPartial =
+    mesh->device.malloc((acoustics->NenergyBlocks+1)*sizeof(dfloat), acoustics->energyPartial);
+
+  acoustics->energyPending = 0;
+  acoustics->energyPeak = 0;
+  acoustics->energyPrev = 0;
+
+  acoustics->energyFile = NULL;
+  if(mesh->rank == 0){
+    string PREFIX;
+    newOptions.getArgs("RECEIVERPREFIX", PREFIX);
+    char fname[BUFSIZ];
+    sprintf(fname, "data/%s_Energy.txt", (char*)PREFIX.c_str());
+    acoustics->energyFile = fopen(fname, "w");
+    if(acoustics->energyFile)
+      fprintf(acoustics->energyFile, "# time energy decay[dB]\n");
+  }
+}
+
+// Log the completed global energy and decide whether to stop:
+// 0 continue, 1 decayed or stagnated, 2 unstable
+static int acousticsEnergyCheck(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  MPI_Wait(&acoustics->energyRequest, MPI_STATUS_IGNORE);
+  acoustics->energyPending = 0;
+
+  dfloat E = acoustics->energyGlobal;
+  dfloat t = acoustics->energyTime;
+
+  if(isnan(E) || isinf(E)){
+    if(!mesh->rank) printf("Energy monitor: non-finite energy at t = %g, solution is unstable\n", t);
+    return 2;
+  }
+
+  if(acoustics->energyPeak > 0 && E > acoustics->energyGrowth*acoustics->energyPeak){
+    if(!mesh->rank) printf("Energy monitor: energy grew to %g times its peak at t = %g, solution is unstable\n",
+                           E/acoustics->energyPeak, t);
+    return 2;
+  }
+  acoustics->energyPeak = mymax(acoustics->energyPeak, E);
+
+  dfloat decay = (E > 0 && acoustics->energyPeak > 0) ? 10.0*log10(E/acoustics->energyPeak) : 0;
+  if(acoustics->energyFile){
+    fprintf(acoustics->energyFile, "%.8e %.8e %.4f\n", t, E, decay);
+    fflush(acoustics->energyFile);
+  }
+
+  int stop = 0;
+  if(acoustics->energyDecay > 0 && decay < -acoustics->energyDecay){
+    if(!mesh->rank) printf("Energy monitor: energy decayed by %g dB at t = %g\n", -decay, t);
+    stop = 1;
+  }
+  // propagation is lossless until the wavefront reaches absorbing walls, so the
+  // energy is flat early on; only test stagnation once it has started to decay
+  if(acoustics->energyStagnation > 0 && acoustics->energyPrev > 0 &&
+     decay < -acoustics->energyStagnationOnset &&
+     fabs(E - acoustics->energyPrev) < acoustics->energyStagnation*acoustics->energyPrev){
+    if(!mesh->rank) printf("Energy monitor: energy stagnated at t = %g\n", t);
+    stop = 1;
+  }
+  acoustics->energyPrev = E;
+
+  return stop;
+}
+
+// Called after every step; returns nonzero when the run should stop
+int acousticsEnergyMonitor(acoustics_t *acoustics, int tstep, dfloat time){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  if(!acoustics->energyEvery || (tstep+1)%acoustics->energyEvery) return 0;
+
+  int stop = acoustics->energyPending ? acousticsEnergyCheck(acoustics) : 0;
+
+  if(stop){
+    acoustics->NtimeStepsDone = tstep+1;
+    acoustics->unstable = (stop == 2);
+    return stop;
+  }
+
+  kernelProfileStart(acoustics->profile);
+  acoustics->energyKernel(mesh->Nelements,
+                          mesh->o_vgeo,
+                          mesh->o_MM,
+                          acoustics->o_q,
+                          acoustics->o_energyPartial);
+  kernelProfileStop(acoustics->profile, acoustics->profEnergy);
+
+  acoustics->o_energyPartial.copyTo(acoustics->energyPartial, acoustics->NenergyBlocks*sizeof(dfloat), 0);
+
+  acoustics->energyLocal = 0;
+  for(dlong b = 0; b < acoustics->NenergyBlocks; b++)
+    acoustics->energyLocal += acoustics->energyPartial[b];
+
+  acoustics->energyTime = time;
+  MPI_Iallreduce(&acoustics->energyLocal, &acoustics->energyGlobal, 1, MPI_DFLOAT, MPI_SUM,
+                 mesh->comm, &acoustics->energyRequest);
+  acoustics->energyPending = 1;
+
+  return 0;
+}
+
+// Complete the last outstanding reduction and close the log
+void acousticsEnergyFinalize(acoustics_t *acoustics){
+
+  if(!acoustics->energyEvery) return;
+
+  if(acoustics->energyPending)
+    acoustics->unstable |= (acousticsEnergyCheck(acoustics) == 2);
+
+  if(acoustics->energyFile) fclose(acoustics->energyFile);
+  acoustics->energyFile = NULL;
+}
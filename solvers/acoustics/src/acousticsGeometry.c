@@ -0,0 +1,104 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.h"
+
+// [EA] Compact face geometry for the affine tet surface kernel. Per face it keeps
+// the neighbour element (halo elements included), a code fP + Nfaces*rotation,
+// float normals and the dfloat lift scale sJ*invJ. The rotations are the distinct
+// neighbour face node permutations found in mapP, indexed by local face node; a
+// triangle face has at most 6.
+void acousticsCompactGeometrySetup(acoustics_t *acoustics, occa::properties &kernelInfo){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  const int Nfp = mesh->Nfp;
+  const int Nfaces = mesh->Nfaces;
+  const dlong NtotalFaces = mesh->Nelements*Nfaces;
+
+  dlong *EToEP = (dlong*) calloc(NtotalFaces+1, sizeof(dlong));
+  int *faceCode = (int*) calloc(NtotalFaces+1, sizeof(int));
+  float *faceNormals = (float*) calloc(3*NtotalFaces+1, sizeof(float));
+  dfloat *faceScale = (dfloat*) calloc(NtotalFaces+1, sizeof(dfloat));
+
+  int NfaceRot = 0;
+  int *faceRot = (int*) calloc(acousticsMaxFaceRot*Nfp, sizeof(int));
+  int *perm = (int*) calloc(Nfp, sizeof(int));
+
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int f=0;f<Nfaces;++f){
+      const dlong base = (e*Nfaces+f)*Nfp;
+      const dlong eP = mesh->mapP[base]/(Nfaces*Nfp);
+      const int fP = (mesh->mapP[base]%(Nfaces*Nfp))/Nfp;
+
+      for(int n=0;n<Nfp;++n){
+        perm[n] = mesh->mapP[base+n]%Nfp;
+        if(mesh->vmapP[base+n] != eP*mesh->Np + mesh->faceNodes[fP*Nfp+perm[n]]){
+          printf("COMPACT GEOMETRY: face %d of element %d does not map to a single neighbour face\n", f, e);
+          exit(-1);
+        }
+      }
+
+      int rot = 0;
+      for(;rot<NfaceRot;++rot)
+        if(!memcmp(faceRot+rot*Nfp, perm, Nfp*sizeof(int))) break;
+      if(rot==NfaceRot){
+        // the table size is fixed so every rank and mesh compiles the same kernel
+        if(NfaceRot==acousticsMaxFaceRot){
+          printf("COMPACT GEOMETRY: more than %d face rotations\n", acousticsMaxFaceRot);
+          exit(-1);
+        }
+        memcpy(faceRot+rot*Nfp, perm, Nfp*sizeof(int));
+        ++NfaceRot;
+      }
+
+      const dlong sid = mesh->Nsgeo*(e*Nfaces+f);
+      EToEP[e*Nfaces+f] = eP;
+      faceCode[e*Nfaces+f] = fP + Nfaces*rot;
+      faceNormals[3*(e*Nfaces+f)+0] = (float) mesh->sgeo[sid+NXID];
+      faceNormals[3*(e*Nfaces+f)+1] = (float) mesh->sgeo[sid+NYID];
+      faceNormals[3*(e*Nfaces+f)+2] = (float) mesh->sgeo[sid+NZID];
+      faceScale[e*Nfaces+f] = mesh->sgeo[sid+SJID]*mesh->sgeo[sid+IJID];
+    }
+  }
+
+  acoustics->NfaceRot = NfaceRot;
+  kernelInfo["defines/" "p_maxFaceRot"]= acousticsMaxFaceRot;
+
+  acoustics->o_EToEP = mesh->device.malloc((NtotalFaces+1)*sizeof(dlong), EToEP);
+  acoustics->o_faceCode = mesh->device.malloc((NtotalFaces+1)*sizeof(int), faceCode);
+  acoustics->o_faceNormals = mesh->device.malloc((3*NtotalFaces+1)*sizeof(float), faceNormals);
+  acoustics->o_faceScale = mesh->device.malloc((NtotalFaces+1)*sizeof(dfloat), faceScale);
+  acoustics->o_faceRot = mesh->device.malloc(acousticsMaxFaceRot*Nfp*sizeof(int), faceRot);
+  acoustics->o_faceNodes = mesh->device.malloc(Nfaces*Nfp*sizeof(int), mesh->faceNodes);
+
+  free(EToEP);
+  free(faceCode);
+  free(faceNormals);
+  free(faceScale);
+  free(faceRot);
+  free(perm);
+}
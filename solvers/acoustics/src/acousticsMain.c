@@ -32,11 +32,14 @@ int main(int argc, char **argv){
   // start up MPI
   MPI_Init(&argc, &argv);
 
-  if(argc!=2){
-    printf("usage2: ./acousticsMain setupfile\n");
+  if(argc!=2 && !(argc==3 && !strcmp(argv[2], "prebuild"))){
+    printf("usage2: ./acousticsMain setupfile [prebuild]\n");
     exit(-1);
   }
 
+  // prebuild: compile every kernel the setup file needs into the OCCA cache and stop
+  int prebuild = (argc==3);
+
   // if argv > 2 then should load input data from argv
   setupAide newOptions(argv[1]);
   
@@ -73,30 +76,54 @@ int main(int argc, char **argv){
 
   // set up acoustics stuff
   acoustics_t *acoustics = acousticsSetup(mesh, newOptions, boundaryHeaderFileName);
+  kernelBuilderReport(acoustics->builder);
+  if(prebuild){
+    kernelBuilderFree(acoustics->builder);
+    meshHaloDeviceFree(acoustics->halo);
+    MPI_Finalize();
+    exit(0);
+  }
+
   acousticsFindReceiverElement(acoustics);
   // If receiver is on this core, allocate array for storage
   if(acoustics->NReceiversLocal > 0){
-    acoustics->o_recvElements = 
-      mesh->device.malloc(acoustics->NReceivers*sizeof(dlong), acoustics->recvElements);
-    acoustics->o_recvElementsIdx = 
-      mesh->device.malloc(acoustics->NReceivers*sizeof(dlong), acoustics->recvElementsIdx);
-    acoustics->qRecv = (dfloat*) calloc(acoustics->NReceiversLocal*mesh->NtimeSteps, sizeof(dfloat));
+    acoustics->qRecv = (dfloat*) calloc(acoustics->NReceiversLocal*acoustics->NrecvFields*mesh->NtimeSteps, sizeof(dfloat));
     acoustics->o_qRecv =
-    mesh->device.malloc(acoustics->NReceiversLocal*recvCopyRate*sizeof(dfloat));
+    mesh->device.malloc(acoustics->NReceiversLocal*acoustics->NrecvFields*recvCopyRate*sizeof(dfloat));
     acousticsRecvIntpolOperators(acoustics);
   }
 
+  // octave-band receiver metrics, enabled by [ROOM METRICS] TRUE
+  acousticsMetricsSetup(acoustics, newOptions);
+
+  // energy decay monitor, enabled by [ENERGY MONITOR] k > 0
+  acousticsEnergySetup(acoustics, newOptions);
+
+  // kernel counters, enabled by [KERNEL PROFILE] TRUE
+  acousticsProfileSetup(acoustics, newOptions);
+
   // run
   double startTime, endTime;
   startTime = MPI_Wtime();
   acousticsRun(acoustics, newOptions);
   endTime = MPI_Wtime();
   if(!mesh->rank){printf("Execution time: %lf\n",endTime-startTime);}
+
+  // wall time per degree of freedom per time step, comparable across element types
+  if(!mesh->rank){
+    hlong Ndofs = acoustics->totalElements*mesh->Np*mesh->Nfields;
+    printf("Degrees of freedom: " hlongFormat ", cost per DOF per step: %g s\n",
+           Ndofs, (endTime-startTime)/((double)Ndofs*acoustics->NtimeStepsDone));
+  }
+  kernelProfileReport(acoustics->profile, newOptions);
   acousticsReport(acoustics, mesh->finalTime, newOptions);
 
 
   //---------RECEIVER---------
   acousticsPrintReceiversToFile(acoustics, newOptions);
+  acousticsMetricsWrite(acoustics, newOptions);
+
+  meshHaloDeviceFree(acoustics->halo);
   
   // close down MPI
   MPI_Finalize();
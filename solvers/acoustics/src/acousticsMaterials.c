@@ -0,0 +1,498 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.h"
+
+// [EA] Length of a vectfit coefficient table. Coefficients are kept in file order,
+// LR: A(Nreal) B(Nimag) C(Nimag) lambda(Nreal) alpha(Nimag) beta(Nimag) Yinf
+// ER: A, B and C per incidence angle, shared poles, then Yinf per angle
+static dlong acousticsMaterialNcoeffs(acousticsMaterial_t *mat){
+  if(mat->type == 3)
+    return 1 + 2*mat->Nreal + 4*mat->Nimag;
+
+  return ERNangles + mat->Nreal + mat->Nreal*ERNangles
+    + 2*mat->Nimag*ERNangles + 2*mat->Nimag;
+}
+
+static void acousticsMaterialRead(acousticsMaterial_t *mat, int physicalId, int type, const char *fileName){
+
+  mat->physicalId = physicalId;
+  mat->type = type;
+
+  FILE *fp = fopen(fileName, "r");
+  if(fp == NULL){
+    printf("Could not find %s file: %s\n", (type==3) ? "LRDATA":"ERDATA", fileName);
+    exit(-1);
+  }
+
+  fscanf(fp, "%d %d %d", &mat->Npoles, &mat->Nreal, &mat->Nimag);
+  if(mat->Npoles != mat->Nreal + 2*mat->Nimag){
+    printf("%s: %d poles do not match %d real poles and %d complex pairs\n",
+           fileName, mat->Npoles, mat->Nreal, mat->Nimag);
+    exit(-1);
+  }
+
+  const dlong Ncoeffs = acousticsMaterialNcoeffs(mat);
+  mat->coeffs = (dfloat*) calloc(Ncoeffs, sizeof(dfloat));
+  for(dlong n=0;n<Ncoeffs;++n)
+    fscanf(fp, "%lf", mat->coeffs+n);
+
+  fclose(fp);
+}
+
+int acousticsMaterialFind(acoustics_t *acoustics, int physicalId){
+  for(int m=0;m<acoustics->Nmaterials;++m)
+    if(acoustics->materials[m].physicalId == physicalId)
+      return m;
+
+  return -1;
+}
+
+// [EA] Read the material table and map every impedance face to its material.
+// [MATERIALS] names a file with one "physicalId LR|ER vectfitFile" line per
+// Gmsh physical surface; NONE keeps LRVECTFIT on physical 3 and ERVECTFIT on 4.
+// Faces of a material get EToB = 3 (LR) or 4 (ER), so this runs before EToB is
+// copied to the device.
+void acousticsMaterialSetup(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  newOptions.getArgs("BCCHANGETIME", acoustics->BCChangeTime);
+
+  vector<int> physicalIds, types;
+  vector<string> fileNames;
+
+  string materialsFileName;
+  newOptions.getArgs("MATERIALS", materialsFileName);
+
+  if(materialsFileName.length() && materialsFileName != "NONE"){
+    FILE *fp = fopen((char*)materialsFileName.c_str(), "r");
+    if(fp == NULL){
+      printf("Could not find MATERIALS file: %s\n", (char*)materialsFileName.c_str());
+      exit(-1);
+    }
+
+    char buf[BUFSIZ], typeName[BUFSIZ], fileName[BUFSIZ];
+    while(fgets(buf, BUFSIZ, fp)){
+      int physicalId;
+      if(buf[0] == '#') continue;
+      if(sscanf(buf, "%d %s %s", &physicalId, typeName, fileName) != 3) continue;
+
+      if(strcmp(typeName, "LR") && strcmp(typeName, "ER")){
+        printf("%s: material type of physical surface %d must be LR or ER\n",
+               (char*)materialsFileName.c_str(), physicalId);
+        exit(-1);
+      }
+      physicalIds.push_back(physicalId);
+      types.push_back(strcmp(typeName, "LR") ? 4 : 3);
+      fileNames.push_back(fileName);
+    }
+    fclose(fp);
+  } else {
+    hlong NLRFacesTotal = 0, NERFacesTotal = 0;
+    hlong NLRFacesLocal = mesh->NLRFaces, NERFacesLocal = mesh->NERFaces;
+    MPI_Allreduce(&NLRFacesLocal, &NLRFacesTotal, 1, MPI_HLONG, MPI_SUM, mesh->comm);
+    MPI_Allreduce(&NERFacesLocal, &NERFacesTotal, 1, MPI_HLONG, MPI_SUM, mesh->comm);
+
+    // LR data is also needed when ER boundaries switch to LR at BCCHANGETIME
+    if(NLRFacesTotal || (acoustics->BCChangeTime > 0.0 && NERFacesTotal)){
+      physicalIds.push_back(3);
+      types.push_back(3);
+      fileNames.push_back(newOptions.getArgs("LRVECTFIT"));
+    }
+    if(NERFacesTotal){
+      physicalIds.push_back(4);
+      types.push_back(4);
+      fileNames.push_back(newOptions.getArgs("ERVECTFIT"));
+    }
+  }
+
+  acoustics->Nmaterials = physicalIds.size();
+  acoustics->materials = (acousticsMaterial_t*) calloc(acoustics->Nmaterials+1, sizeof(acousticsMaterial_t));
+  for(int m=0;m<acoustics->Nmaterials;++m){
+    for(int k=0;k<m;++k){
+      if(physicalIds[k] == physicalIds[m]){
+        printf("Physical surface %d has more than one material\n", physicalIds[m]);
+        exit(-1);
+      }
+    }
+    acousticsMaterialRead(acoustics->materials+m, physicalIds[m], types[m], (char*)fileNames[m].c_str());
+  }
+
+  // map faces to materials and recount the LR/ER faces
+  acoustics->EToMat = (int*) calloc(mesh->Nelements*mesh->Nfaces, sizeof(int));
+  mesh->NLRFaces = 0;
+  mesh->NERFaces = 0;
+  for(dlong n=0;n<mesh->Nelements*mesh->Nfaces;++n){
+    const int bc = mesh->EToB[n];
+    const int m = (bc > 0) ? acousticsMaterialFind(acoustics, bc) : -1;
+
+    acoustics->EToMat[n] = m;
+    if(m >= 0){
+      mesh->EToB[n] = acoustics->materials[m].type;
+      if(acoustics->materials[m].type == 3) mesh->NLRFaces++;
+      else mesh->NERFaces++;
+    } else if(bc == 3 || bc == 4){
+      printf("Physical surface %d is a %s boundary without a material\n",
+             bc, (bc==3) ? "Local Reaction":"Extended Reaction");
+      exit(-1);
+    }
+  }
+
+  // [EA] BCChangeTime error checking, ER points continue on the first LR material
+  acoustics->BCChangeMaterial = -1;
+  if(acoustics->BCChangeTime > 0.0){
+    for(int m=0;m<acoustics->Nmaterials;++m){
+      if(acoustics->materials[m].type == 3){
+        acoustics->BCChangeMaterial = m;
+        break;
+      }
+    }
+
+    int NERMaterials = 0;
+    for(int m=0;m<acoustics->Nmaterials;++m){
+      acousticsMaterial_t *mat = acoustics->materials+m;
+      if(mat->type != 4) continue;
+      NERMaterials++;
+      if(acoustics->BCChangeMaterial < 0 ||
+         mat->Npoles != acoustics->materials[acoustics->BCChangeMaterial].Npoles){
+        printf("BCCHANGETIME is greater than 0, but number of poles in Local Reaction and Extended Reaction are not equal!\n");
+        exit(-1);
+      }
+    }
+    if(NERMaterials == 0){
+      printf("BCCHANGETIME is greater than 0 with no Extended Reaction boundaries!\n");
+      exit(-1);
+    }
+  }
+}
+
+// [EA] Number the impedance boundary points so that each material is one
+// contiguous batch: LR materials first, then ER, accumulators in the same order.
+// mapAcc holds the packed point index, mapAccToXYZ/N are indexed by ER point.
+void acousticsMaterialPack(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  mesh->NLRPoints = mesh->Nfp*mesh->NLRFaces;
+  mesh->NERPoints = mesh->Nfp*mesh->NERFaces;
+
+  for(dlong n=0;n<mesh->Nelements*mesh->Nfaces;++n){
+    const int m = acoustics->EToMat[n];
+    if(m >= 0) acoustics->materials[m].Npoints += mesh->Nfp;
+  }
+
+  dlong pointOffset = 0, accOffset = 0;
+  for(int type=3;type<=4;++type){
+    for(int m=0;m<acoustics->Nmaterials;++m){
+      acousticsMaterial_t *mat = acoustics->materials+m;
+      if(mat->type != type) continue;
+      mat->pointOffset = pointOffset;
+      mat->accOffset = accOffset;
+      pointOffset += mat->Npoints;
+      accOffset += mat->Npoints*mat->Npoles;
+    }
+    if(type == 3) acoustics->NLRAcc = accOffset;
+  }
+  acoustics->NERAcc = accOffset - acoustics->NLRAcc;
+
+  dlong RPointsAlloc = mesh->NLRPoints+mesh->NERPoints ? mesh->NLRPoints+mesh->NERPoints:1; // [EA] Occa cannot have pointers to empty arrays
+  dlong NERPointsAlloc = mesh->NERPoints ? mesh->NERPoints:1;
+  mesh->mapAccToQ = (dlong*) calloc(RPointsAlloc, sizeof(dlong));
+  mesh->mapAccToXYZ = (dlong*) calloc(NERPointsAlloc, sizeof(dlong));
+  mesh->mapAccToN = (dlong*) calloc(NERPointsAlloc, sizeof(dlong));
+
+  dlong *counter = (dlong*) calloc(acoustics->Nmaterials+1, sizeof(dlong));
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->Nfp*mesh->Nfaces;++n){
+      const dlong id = e*mesh->Nfp*mesh->Nfaces + n;
+      if(mesh->mapAcc[id] != -2) continue; // not a domain boundary point
+
+      const int face = n/mesh->Nfp;
+      const int m = acoustics->EToMat[face+mesh->Nfaces*e];
+      if(m < 0) continue;
+
+      acousticsMaterial_t *mat = acoustics->materials+m;
+      const dlong pt = mat->pointOffset + counter[m]++;
+
+      const dlong idM = mesh->vmapM[id];
+      const int vidM = idM%mesh->Np;
+      mesh->mapAcc[id] = pt;
+      mesh->mapAccToQ[pt] = e*mesh->Np*mesh->Nfields + vidM;
+
+      if(mat->type == 4){
+        const dlong er = pt - mesh->NLRPoints;
+        mesh->mapAccToXYZ[er] = e*mesh->Np + vidM;
+        if(acoustics->elementType==HEXAHEDRA)
+          mesh->mapAccToN[er] = mesh->Nsgeo*id; // hex normals are stored per face node
+        else
+          mesh->mapAccToN[er] = mesh->Nsgeo*(e*mesh->Nfaces+face);
+      }
+    }
+  }
+  free(counter);
+
+  // [EA] mapAcc to device
+  mesh->o_mapAcc =
+    mesh->device.malloc(mesh->Nelements*mesh->Nfp*mesh->Nfaces*sizeof(dlong),
+                        mesh->mapAcc);
+  mesh->o_mapAccToQ =
+    mesh->device.malloc(RPointsAlloc*sizeof(dlong),
+                        mesh->mapAccToQ);
+  mesh->o_mapAccToXYZ =
+    mesh->device.malloc(NERPointsAlloc*sizeof(dlong),
+                        mesh->mapAccToXYZ);
+  mesh->o_mapAccToN =
+    mesh->device.malloc(NERPointsAlloc*sizeof(dlong),
+                        mesh->mapAccToN);
+
+  acoustics->vnAcc = (dfloat*) calloc(RPointsAlloc, sizeof(dfloat));
+  acoustics->o_vnAcc =
+    mesh->device.malloc(RPointsAlloc*sizeof(dfloat), acoustics->vnAcc);
+}
+
+// [EA] Upload the coefficients and build the impedance and EIRK4 accumulator
+// kernels with the pole counts of each material compiled in. Materials with
+// the same pole signature share one build.
+// [EA] Device layout of an ER material: shared poles lambda(Nreal) alpha(Nimag)
+// beta(Nimag), then ERNcos rows of Yinf A(Nreal) B(Nimag) C(Nimag). Row k holds
+// the coefficients at |cos(angle)| = k/(ERNcos-1), interpolated linearly in angle
+// from the vectfit table, so a boundary point reads two neighbouring rows.
+static dfloat *acousticsMaterialERTable(acousticsMaterial_t *mat, dlong *Ntable){
+
+  const dlong Nreal = mat->Nreal, Nimag = mat->Nimag;
+  const dlong stride = 1 + mat->Npoles;
+
+  // vectfit file offsets
+  const dlong fileB = Nreal*ERNangles;
+  const dlong fileC = fileB + Nimag*ERNangles;
+  const dlong fileLambda = fileC + Nimag*ERNangles;
+  const dlong fileYinf = fileLambda + Nreal + 2*Nimag;
+
+  *Ntable = mat->Npoles + ERNcos*stride;
+  dfloat *table = (dfloat*) calloc(*Ntable, sizeof(dfloat));
+
+  for(dlong p=0;p<mat->Npoles;++p)
+    table[p] = mat->coeffs[fileLambda+p];
+
+  for(int k=0;k<ERNcos;++k){
+    const dfloat angle = acos(k/(dfloat)(ERNcos-1))*180.0/M_PI;
+    int a = (int) floor(angle);
+    if(a > ERNangles-2) a = ERNangles-2;
+    const dfloat w = angle - a;
+
+    dfloat *row = table + mat->Npoles + k*stride;
+#define ERLERP(off, n) ((1.0-w)*mat->coeffs[(off)+a*(n)] + w*mat->coeffs[(off)+(a+1)*(n)])
+    row[0] = ERLERP(fileYinf, 1);
+    for(dlong p=0;p<Nreal;++p)
+      row[1+p] = ERLERP(p, Nreal);
+    for(dlong p=0;p<Nimag;++p){
+      row[1+Nreal+p] = ERLERP(fileB+p, Nimag);
+      row[1+Nreal+Nimag+p] = ERLERP(fileC+p, Nimag);
+    }
+#undef ERLERP
+  }
+
+  return table;
+}
+
+void acousticsMaterialKernels(acoustics_t *acoustics, setupAide &newOptions, occa::properties &kernelInfo){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  const int eirk = newOptions.compareArgs("TIME INTEGRATOR","EIRK4");
+
+  for(int m=0;m<acoustics->Nmaterials;++m){
+    acousticsMaterial_t *mat = acoustics->materials+m;
+
+    if(mat->type == 3){
+      mat->o_coeffs =
+        mesh->device.malloc(acousticsMaterialNcoeffs(mat)*sizeof(dfloat), mat->coeffs);
+    } else {
+      dlong Ntable;
+      dfloat *table = acousticsMaterialERTable(mat, &Ntable);
+      mat->o_coeffs = mesh->device.malloc(Ntable*sizeof(dfloat), table);
+      free(table);
+    }
+
+    int shared = -1;
+    for(int k=0;k<m;++k){
+      acousticsMaterial_t *prev = acoustics->materials+k;
+      if(prev->type == mat->type && prev->Nreal == mat->Nreal && prev->Nimag == mat->Nimag){
+        shared = k;
+        break;
+      }
+    }
+    if(shared >= 0){
+      mat->impedanceKernel = acoustics->materials[shared].impedanceKernel;
+      mat->updateEIRK4AccKernel = acoustics->materials[shared].updateEIRK4AccKernel;
+      continue;
+    }
+
+    occa::properties materialInfo = kernelInfo;
+    const dlong Nreal = mat->Nreal, Nimag = mat->Nimag;
+
+    if(mat->type == 3){
+      // [EA] LR offset defines
+      materialInfo["defines/" "p_LRNpoles"]= mat->Npoles;
+      materialInfo["defines/" "p_LRNreal"]= Nreal;
+      materialInfo["defines/" "p_LRNimag"]= Nimag;
+      materialInfo["defines/" "p_LRA"]= 0;
+      materialInfo["defines/" "p_LRB"]= Nreal;
+      materialInfo["defines/" "p_LRC"]= Nreal + Nimag;
+      materialInfo["defines/" "p_LRLambda"]= Nreal + 2*Nimag;
+      materialInfo["defines/" "p_LRAlpha"]= 2*Nreal + 2*Nimag;
+      materialInfo["defines/" "p_LRBeta"]= 2*Nreal + 3*Nimag;
+      materialInfo["defines/" "p_LRYinf"]= 2*Nreal + 4*Nimag;
+    } else {
+      // [EA] ER offset defines
+      materialInfo["defines/" "p_ERNpoles"]= mat->Npoles;
+      materialInfo["defines/" "p_ERNreal"]= Nreal;
+      materialInfo["defines/" "p_ERNimag"]= Nimag;
+      materialInfo["defines/" "p_ERNcos"]= ERNcos;
+      materialInfo["defines/" "p_ERLambda"]= 0;
+      materialInfo["defines/" "p_ERAlpha"]= Nreal;
+      materialInfo["defines/" "p_ERBeta"]= Nreal + Nimag;
+      materialInfo["defines/" "p_ERTable"]= mat->Npoles;
+      materialInfo["defines/" "p_ERStride"]= 1 + mat->Npoles;
+      materialInfo["defines/" "p_ERYinf"]= 0;
+      materialInfo["defines/" "p_ERA"]= 1;
+      materialInfo["defines/" "p_ERB"]= 1 + Nreal;
+      materialInfo["defines/" "p_ERC"]= 1 + Nreal + Nimag;
+    }
+
+    mat->impedanceKernel =
+      kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsImpedance.okl",
+                               (mat->type==3) ? "acousticsImpedanceLR":"acousticsImpedanceER",
+                               materialInfo);
+
+    if(eirk)
+      mat->updateEIRK4AccKernel =
+        kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
+                                 (mat->type==3) ? "acousticsUpdateEIRK4AccLR":"acousticsUpdateEIRK4AccER",
+                                 materialInfo);
+  }
+}
+
+// [EA] Evaluate the impedance boundaries one material batch at a time
+void acousticsImpedance(acoustics_t *acoustics, occa::memory qPtr, occa::memory accPtr, occa::memory rhsaccPtr){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  if(!acoustics->Nmaterials) return;
+
+  kernelProfileStart(acoustics->profile);
+  for(int m=0;m<acoustics->Nmaterials;++m){
+    acousticsMaterial_t *mat = acoustics->materials+m;
+    if(!mat->Npoints) continue;
+
+    if(mat->type == 3)
+      mat->impedanceKernel(mat->Npoints,
+                           mat->pointOffset,
+                           mat->accOffset,
+                           mesh->o_mapAccToQ,
+                           mat->o_coeffs,
+                           qPtr,
+                           accPtr,
+                           rhsaccPtr,
+                           acoustics->o_vnAcc);
+    else
+      mat->impedanceKernel(mat->Npoints,
+                           mat->pointOffset,
+                           mat->accOffset,
+                           mesh->NLRPoints,
+                           mesh->o_mapAccToQ,
+                           acoustics->o_ERcos,
+                           mat->o_coeffs,
+                           qPtr,
+                           accPtr,
+                           rhsaccPtr,
+                           acoustics->o_vnAcc);
+  }
+  kernelProfileStop(acoustics->profile, acoustics->profImpedance);
+}
+
+// [EA] Implicit accumulator stage of EIRK4 for every material batch
+void acousticsUpdateEIRK4Acc(acoustics_t *acoustics, const int stage){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  for(int type=3;type<=4;++type){
+    if(!(type==3 ? acoustics->NLRAcc : acoustics->NERAcc)) continue;
+
+    kernelProfileStart(acoustics->profile);
+    for(int m=0;m<acoustics->Nmaterials;++m){
+      acousticsMaterial_t *mat = acoustics->materials+m;
+      if(mat->type != type || !mat->Npoints) continue;
+
+      mat->updateEIRK4AccKernel(mat->Npoints,
+                                mat->pointOffset,
+                                mat->accOffset,
+                                mesh->dt,
+                                mesh->o_esdirka,
+                                mesh->o_esdirkb,
+                                mesh->o_mapAccToQ,
+                                mat->o_coeffs,
+                                acoustics->o_k1acc,
+                                acoustics->o_k2acc,
+                                acoustics->o_k3acc,
+                                acoustics->o_k4acc,
+                                acoustics->o_k5acc,
+                                acoustics->o_k6acc,
+                                acoustics->o_resq,
+                                acoustics->o_acc,
+                                acoustics->o_Xacc,
+                                stage);
+    }
+    kernelProfileStop(acoustics->profile, (type==3) ? acoustics->profUpdateEIRK4LR : acoustics->profUpdateEIRK4ER);
+  }
+}
+
+// [EA] ER points continue as local reaction: every ER batch keeps its points and
+// accumulators but takes the coefficients and kernels of the BCChange material
+void acousticsMaterialBCChange(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+  acousticsMaterial_t *lr = acoustics->materials + acoustics->BCChangeMaterial;
+
+  for(int m=0;m<acoustics->Nmaterials;++m){
+    acousticsMaterial_t *mat = acoustics->materials+m;
+    if(mat->type != 4) continue;
+
+    mat->type = 3;
+    mat->Nreal = lr->Nreal;
+    mat->Nimag = lr->Nimag;
+    mat->coeffs = lr->coeffs;
+    mat->o_coeffs = lr->o_coeffs;
+    mat->impedanceKernel = lr->impedanceKernel;
+    mat->updateEIRK4AccKernel = lr->updateEIRK4AccKernel;
+  }
+
+  mesh->NLRPoints += mesh->NERPoints;
+  mesh->NERPoints = 0;
+  acoustics->NLRAcc += acoustics->NERAcc;
+  acoustics->NERAcc = 0;
+}
@@ -0,0 +1,245 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.h"
+
+// In-situ room-acoustic metrics. Receiver pressure is run through an octave-band
+// biquad bank as each block of samples reaches the host; the squared band
+// pressures are kept for Schroeder backward integration at the end of the run.
+
+void acousticsMetricsSetup(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  acoustics->metrics = newOptions.compareArgs("ROOM METRICS","TRUE");
+  acoustics->decayThreshold = 0;
+  acoustics->NrecvSamples = 0;
+  acoustics->NtimeStepsDone = mesh->NtimeSteps;
+  if(!acoustics->metrics) return;
+
+  newOptions.getArgs("DECAY TERMINATION", acoustics->decayThreshold);
+
+  // octave bands below the Nyquist frequency, plus the broadband response (centre 0)
+  vector<dfloat> bands;
+  newOptions.getArgs("METRICS BANDS", bands);
+  dfloat fs = 1.0/mesh->dt;
+
+  acoustics->metricBands = (dfloat*) calloc(bands.size()+1, sizeof(dfloat));
+  acoustics->metricCoeffs = (dfloat*) calloc(5*(bands.size()+1), sizeof(dfloat));
+  acoustics->NmetricBands = 1;
+  for(size_t b = 0; b < bands.size(); b++){
+    if(bands[b] <= 0 || bands[b]*sqrt(2.0) >= 0.5*fs) continue;
+
+    // band-pass biquad with its -3 dB points one octave apart
+    dfloat w0 = 2.0*M_PI*bands[b]/fs;
+    dfloat alpha = sin(w0)*sinh(0.5*log(2.0)*w0/sin(w0));
+    dfloat a0 = 1.0 + alpha;
+    dfloat *c = acoustics->metricCoeffs + 5*acoustics->NmetricBands;
+    c[0] =  alpha/a0;
+    c[1] =  0.0;
+    c[2] = -alpha/a0;
+    c[3] = -2.0*cos(w0)/a0;
+    c[4] = (1.0 - alpha)/a0;
+
+    acoustics->metricBands[acoustics->NmetricBands++] = bands[b];
+  }
+
+  dlong Nchannels = acoustics->NReceiversLocal*acoustics->NmetricBands;
+  acoustics->metricState = (dfloat*) calloc(4*Nchannels, sizeof(dfloat));
+  acoustics->metricEnergy = (dfloat*) calloc(Nchannels*mesh->NtimeSteps, sizeof(dfloat));
+  acoustics->metricBlockMax = (dfloat*) calloc(acoustics->NReceiversLocal, sizeof(dfloat));
+  acoustics->decayReached = 0;
+}
+
+// Filter samples [start, start+Nsamples) of every local receiver and update the decay flag
+void acousticsMetricsUpdate(acoustics_t *acoustics, dlong start, dlong Nsamples){
+
+  mesh_t *mesh = acoustics->mesh;
+  dlong NtimeSteps = mesh->NtimeSteps;
+  int Nbands = acoustics->NmetricBands;
+
+  acoustics->decayReached = 1;
+
+  for(dlong iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
+    const dfloat *p = acoustics->qRecv + iRecv*acoustics->NrecvFields*NtimeSteps;
+    dfloat blockEnergy = 0;
+
+    for(int b = 0; b < Nbands; b++){
+      const dfloat *c = acoustics->metricCoeffs + 5*b;
+      dfloat *s = acoustics->metricState + 4*(iRecv*Nbands + b);
+      dfloat *h2 = acoustics->metricEnergy + (iRecv*Nbands + b)*NtimeSteps;
+
+      for(dlong i = start; i < start+Nsamples; i++){
+        dfloat y = p[i];
+        if(b){
+          // direct form I: s = x[n-1], x[n-2], y[n-1], y[n-2]
+          y = c[0]*p[i] + c[1]*s[0] + c[2]*s[1] - c[3]*s[2] - c[4]*s[3];
+          s[1] = s[0]; s[0] = p[i];
+          s[3] = s[2]; s[2] = y;
+        } else {
+          blockEnergy += y*y;
+        }
+        h2[i] = y*y;
+      }
+    }
+
+    // decayed once the broadband block energy is [DECAY TERMINATION] dB below the loudest block
+    if(blockEnergy > acoustics->metricBlockMax[iRecv])
+      acoustics->metricBlockMax[iRecv] = blockEnergy;
+    if(!(acoustics->metricBlockMax[iRecv] > 0 &&
+         blockEnergy < acoustics->metricBlockMax[iRecv]*pow(10.0, -0.1*acoustics->decayThreshold)))
+      acoustics->decayReached = 0;
+  }
+}
+
+// Collective: true when every receiver on every rank has decayed past the threshold.
+// Checked when a receiver block has just been copied to the host.
+int acousticsMetricsStop(acoustics_t *acoustics, int tstep){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  if(!acoustics->metrics || acoustics->decayThreshold <= 0 || (tstep+1)%recvCopyRate) return 0;
+
+  int localFlags[2] = {acoustics->NReceiversLocal ? acoustics->decayReached : 1,
+                       acoustics->NReceiversLocal ? 1 : 0};
+  int minFlag, NranksWithReceivers;
+  MPI_Allreduce(localFlags+0, &minFlag, 1, MPI_INT, MPI_MIN, mesh->comm);
+  MPI_Allreduce(localFlags+1, &NranksWithReceivers, 1, MPI_INT, MPI_SUM, mesh->comm);
+
+  if(minFlag && NranksWithReceivers){
+    acoustics->NtimeStepsDone = tstep+1;
+    if(!mesh->rank)
+      printf("Receivers decayed by %g dB, stopping after %d of %d steps\n",
+             acoustics->decayThreshold, tstep+1, mesh->NtimeSteps);
+    return 1;
+  }
+  return 0;
+}
+
+// Decay time from a least squares fit of the EDC between hi and lo dB, -1 if not reached
+static dfloat acousticsDecayTime(const dfloat *edc, dlong i0, dlong Ns, dfloat dt, dfloat hi, dfloat lo){
+
+  dlong ia = -1, ib = -1;
+  for(dlong i = i0; i < Ns; i++){
+    if(ia < 0 && edc[i] <= hi) ia = i;
+    if(edc[i] <= lo){ ib = i; break; }
+  }
+  if(ia < 0 || ib <= ia) return -1;
+
+  dfloat st = 0, se = 0, stt = 0, ste = 0, n = ib-ia+1;
+  for(dlong i = ia; i <= ib; i++){
+    dfloat t = i*dt;
+    st += t; se += edc[i]; stt += t*t; ste += t*edc[i];
+  }
+  dfloat slope = (n*ste - st*se)/(n*stt - st*st);
+
+  return slope < 0 ? -60.0/slope : -1;
+}
+
+// Schroeder integration per receiver and band; writes the metrics table and the decay curves
+void acousticsMetricsWrite(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+  if(!acoustics->metrics) return;
+
+  dlong NtimeSteps = mesh->NtimeSteps;
+  dlong Ns = acoustics->NrecvSamples;
+  int Nbands = acoustics->NmetricBands;
+  dfloat dt = mesh->dt;
+
+  string PREFIX;
+  newOptions.getArgs("RECEIVERPREFIX", PREFIX);
+
+  char fname[BUFSIZ];
+  sprintf(fname, "data/%s_Metrics.txt", (char*)PREFIX.c_str());
+
+  // decay curves at 1 ms resolution
+  dlong edcStride = mymax((dlong) (1.0e-3/dt), 1);
+
+  dfloat *edc = (dfloat*) calloc(Nbands*Ns, sizeof(dfloat));
+
+  for(int r = 0; r < mesh->size; r++){
+    if(mesh->rank == r){
+      FILE *fp = fopen(fname, r ? "a" : "w");
+      if(!r) fprintf(fp, "# receiver band[Hz] EDT[s] T20[s] T30[s] C80[dB] D50\n");
+
+      for(dlong iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
+        dlong rIdx = acoustics->recvElementsIdx[iRecv];
+        dlong i0 = 0;
+
+        for(int b = 0; b < Nbands; b++){
+          const dfloat *h2 = acoustics->metricEnergy + (iRecv*Nbands + b)*NtimeSteps;
+          dfloat *e = edc + b*Ns;
+
+          // onset: first sample within 20 dB of the broadband peak
+          if(b == 0){
+            dfloat h2max = 0;
+            for(dlong i = 0; i < Ns; i++) h2max = mymax(h2max, h2[i]);
+            for(i0 = 0; i0 < Ns-1 && h2[i0] < 1.0e-2*h2max; i0++);
+          }
+
+          // backward integration
+          dfloat S = 0;
+          for(dlong i = Ns-1; i >= 0; i--){
+            S += h2[i];
+            e[i] = S;
+          }
+
+          dfloat Stot = e[i0];
+          dlong n50 = i0 + (dlong) (0.05/dt + 0.5);
+          dlong n80 = i0 + (dlong) (0.08/dt + 0.5);
+          dfloat C80 = (n80 < Ns && e[n80] > 0) ? 10.0*log10((Stot - e[n80])/e[n80]) : 0;
+          dfloat D50 = (n50 < Ns && Stot > 0) ? (Stot - e[n50])/Stot : 0;
+
+          for(dlong i = 0; i < Ns; i++)
+            e[i] = (Stot > 0 && e[i] > 0) ? 10.0*log10(e[i]/Stot) : -300;
+
+          fprintf(fp, "%02d %g %.6f %.6f %.6f %.4f %.4f\n", rIdx, acoustics->metricBands[b],
+                  acousticsDecayTime(e, i0, Ns, dt,  0.0, -10.0),
+                  acousticsDecayTime(e, i0, Ns, dt, -5.0, -25.0),
+                  acousticsDecayTime(e, i0, Ns, dt, -5.0, -35.0),
+                  C80, D50);
+        }
+
+        // energy decay curves, one column per band
+        char edcName[BUFSIZ];
+        sprintf(edcName, "data/%s_RecvPoint_%02d_EDC.txt", (char*)PREFIX.c_str(), rIdx);
+        FILE *edcFP = fopen(edcName, "w");
+        for(dlong i = i0; i < Ns; i += edcStride){
+          fprintf(edcFP, "%.6f", (i-i0)*dt);
+          for(int b = 0; b < Nbands; b++)
+            fprintf(edcFP, " %.3f", edc[b*Ns + i]);
+          fprintf(edcFP, "\n");
+        }
+        fclose(edcFP);
+      }
+      fclose(fp);
+    }
+    MPI_Barrier(mesh->comm);
+  }
+
+  free(edc);
+}
@@ -0,0 +1,121 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.h"
+
+// register the acoustics kernels with their analytic per-launch traffic and work
+void acousticsProfileSetup(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  acoustics->profile = kernelProfileSetup(mesh->device, mesh->comm, newOptions);
+
+  kernelProfile_t *prof = acoustics->profile;
+
+  const double sz  = sizeof(dfloat);
+  const double isz = sizeof(dlong);
+
+  const int affine = (acoustics->elementType==TRIANGLES || acoustics->elementType==TETRAHEDRA);
+
+  const double Nelements  = mesh->Nelements;
+  const double Np         = mesh->Np;
+  const double Nfields    = mesh->Nfields;
+  const double NfacesNfp  = mesh->Nfaces*mesh->Nfp;
+  const double Ndofs      = Nelements*Np*Nfields;
+  const double dim        = mesh->dim;
+
+  // accumulator dofs of the local and extended reacting boundary points
+  const double NLRAcc = acoustics->NLRAcc;
+  const double NERAcc = acoustics->NERAcc;
+  const double NaccPoints = mesh->NLRPoints + mesh->NERPoints;
+
+  // volume: read q and geometric factors, write rhsq; derivatives plus chain rule
+  double volumeBytes = sz*(2*Ndofs + Nelements*mesh->Nvgeo*(affine ? 1 : Np));
+  double volumeFlops = Ndofs*(2*dim*(affine ? Np : mesh->Nq) + 2*dim*dim);
+
+  // surface: connectivity, face geometry, both traces, rhsq update and the impedance velocities
+  double surfaceBytes = Nelements*(2*isz*NfacesNfp + sizeof(int)*mesh->Nfaces
+                                   + sz*mesh->Nsgeo*(affine ? mesh->Nfaces : NfacesNfp)
+                                   + sz*2*NfacesNfp*Nfields + sz*2*Np*Nfields)
+    + (sz+isz)*NaccPoints;
+
+  // compact geometry: neighbour element, face code, float normals and lift scale per face
+  if(acoustics->compactGeometry)
+    surfaceBytes = Nelements*mesh->Nfaces*(isz + 2*sizeof(int) + 3*sizeof(float) + sz)
+      + Nelements*(sz*2*NfacesNfp*Nfields + sz*2*Np*Nfields)
+      + (sz+isz)*NaccPoints;
+
+  double surfaceFlops = Nelements*(8*NfacesNfp*Nfields
+                                   + 2*Nfields*(affine ? Np*NfacesNfp : NfacesNfp));
+
+  acoustics->profVolume  = kernelProfileRegister(prof, "acousticsVolume", volumeBytes, volumeFlops);
+  acoustics->profSurface = kernelProfileRegister(prof, "acousticsSurface", surfaceBytes, surfaceFlops);
+
+  // LSERK: read rhsq, resq, q and write resq, q
+  acoustics->profUpdate   = kernelProfileRegister(prof, "acousticsUpdate", 5*sz*Ndofs, 4*Ndofs);
+  acoustics->profUpdateAcc = kernelProfileRegister(prof, "acousticsUpdateAcc",
+                                                  5*sz*(NLRAcc + NERAcc), 4*(NLRAcc + NERAcc));
+
+  // impedance batches: trace pressure and accumulators in, rhsacc and vn out, summed over materials.
+  // ER points also read their incidence cosine and two interpolated coefficient rows.
+  acoustics->profImpedance = kernelProfileRegister(prof, "acousticsImpedance",
+                                                   2*sz*(NLRAcc + NERAcc) + (2*sz+isz)*NaccPoints
+                                                   + sz*mesh->NERPoints + 2*sz*(NERAcc + mesh->NERPoints),
+                                                   5*(NLRAcc + NERAcc) + NaccPoints
+                                                   + 3*(NERAcc + mesh->NERPoints));
+
+  // running DFT: read and write Re/Im per frequency, fused into the last LSERK stage or on its own
+  const double NdftFreqs = acoustics->NdftFreqs;
+  acoustics->profUpdateDFT = kernelProfileRegister(prof, "acousticsUpdateDFT",
+                                                   (5 + 4*NdftFreqs)*sz*Ndofs, (4 + 4*NdftFreqs)*Ndofs);
+  acoustics->profDFT       = kernelProfileRegister(prof, "acousticsDFT",
+                                                   (1 + 4*NdftFreqs)*sz*Ndofs, 4*NdftFreqs*Ndofs);
+
+  // EIRK4: stage s reads q and s stage derivatives and writes one array, averaged over the six stages
+  acoustics->profUpdateEIRK4   = kernelProfileRegister(prof, "acousticsUpdateEIRK4", 5.5*sz*Ndofs, 8*Ndofs);
+  acoustics->profUpdateEIRK4LR = kernelProfileRegister(prof, "acousticsUpdateEIRK4AccLR",
+                                                       5.5*sz*NLRAcc + (sz+isz)*mesh->NLRPoints, 20*NLRAcc);
+  acoustics->profUpdateEIRK4ER = kernelProfileRegister(prof, "acousticsUpdateEIRK4AccER",
+                                                       5.5*sz*NERAcc + (sz+isz)*mesh->NERPoints, 20*NERAcc);
+
+  // energy monitor: q and J per node, tets also apply the mass matrix
+  acoustics->profEnergy = kernelProfileRegister(prof, "acousticsEnergy",
+                                                sz*(Ndofs + Nelements*Np + (affine ? Ndofs*Np : 0)),
+                                                Ndofs*(affine ? 2*Np + 2 : 3));
+
+  // angle detection has no closed form work model; report its time only
+  acoustics->profAngleDetection = kernelProfileRegister(prof, "ERangleDetection", 0, 0);
+
+  // receivers: host element fields once per group, interpolation weights and
+  // recorded channels once per receiver
+  const double NReceivers = acoustics->NReceiversLocal;
+  const double NrecvGroups = acoustics->NrecvGroups;
+  const double NrecvFields = acoustics->NrecvFields;
+  acoustics->profReceiver = kernelProfileRegister(prof, "acousticsReceiverInterpolation",
+                                                  NrecvGroups*(NrecvFields*sz*Np + 3*isz)
+                                                  + NReceivers*(sz*Np + NrecvFields*sz),
+                                                  NReceivers*NrecvFields*2*Np);
+}
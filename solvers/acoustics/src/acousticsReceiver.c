@@ -106,18 +106,158 @@ void acousticsReceiverInterpolation(acoustics_t *acoustics){
   }
 }
 
+// invert the trilinear map of hex e with Newton, returns 1 if xyz lies inside the element
+static int acousticsHexInverseMap(mesh_t *mesh, dlong e, const dfloat *xyz, dfloat *rst){
+
+  const dfloat *EX = mesh->EX + e*mesh->Nverts;
+  const dfloat *EY = mesh->EY + e*mesh->Nverts;
+  const dfloat *EZ = mesh->EZ + e*mesh->Nverts;
+
+  // bounding box rejection before the Newton solve
+  dfloat xmin = EX[0], xmax = EX[0], ymin = EY[0], ymax = EY[0], zmin = EZ[0], zmax = EZ[0];
+  for(int v = 1; v < mesh->Nverts; v++){
+    xmin = mymin(xmin, EX[v]); xmax = mymax(xmax, EX[v]);
+    ymin = mymin(ymin, EY[v]); ymax = mymax(ymax, EY[v]);
+    zmin = mymin(zmin, EZ[v]); zmax = mymax(zmax, EZ[v]);
+  }
+  const dfloat tol = 1.0e-10*(xmax-xmin + ymax-ymin + zmax-zmin);
+  if(xyz[0] < xmin-tol || xyz[0] > xmax+tol ||
+     xyz[1] < ymin-tol || xyz[1] > ymax+tol ||
+     xyz[2] < zmin-tol || xyz[2] > zmax+tol)
+    return 0;
+
+  // vertex signs of the reference hex, see meshPhysicalNodesHex3D
+  const dfloat vr[8] = {-1, 1, 1,-1,-1, 1, 1,-1};
+  const dfloat vs[8] = {-1,-1, 1, 1,-1,-1, 1, 1};
+  const dfloat vt[8] = {-1,-1,-1,-1, 1, 1, 1, 1};
+
+  dfloat r = 0, s = 0, t = 0;
+  for(int it = 0; it < 20; it++){
+    dfloat fx = -xyz[0], fy = -xyz[1], fz = -xyz[2];
+    dfloat xr = 0, xs = 0, xt = 0, yr = 0, ys = 0, yt = 0, zr = 0, zs = 0, zt = 0;
+    for(int v = 0; v < 8; v++){
+      const dfloat ar = 1+vr[v]*r, as = 1+vs[v]*s, at = 1+vt[v]*t;
+      const dfloat Nv  = 0.125*ar*as*at;
+      const dfloat Nvr = 0.125*vr[v]*as*at;
+      const dfloat Nvs = 0.125*vs[v]*ar*at;
+      const dfloat Nvt = 0.125*vt[v]*ar*as;
+      fx += Nv*EX[v]; xr += Nvr*EX[v]; xs += Nvs*EX[v]; xt += Nvt*EX[v];
+      fy += Nv*EY[v]; yr += Nvr*EY[v]; ys += Nvs*EY[v]; yt += Nvt*EY[v];
+      fz += Nv*EZ[v]; zr += Nvr*EZ[v]; zs += Nvs*EZ[v]; zt += Nvt*EZ[v];
+    }
+
+    // Cramer's rule for the Newton update
+    const dfloat J  = xr*(ys*zt-yt*zs) - xs*(yr*zt-yt*zr) + xt*(yr*zs-ys*zr);
+    const dfloat dr = (fx*(ys*zt-yt*zs) - xs*(fy*zt-yt*fz) + xt*(fy*zs-ys*fz))/J;
+    const dfloat ds = (xr*(fy*zt-yt*fz) - fx*(yr*zt-yt*zr) + xt*(yr*fz-fy*zr))/J;
+    const dfloat dt = (xr*(ys*fz-fy*zs) - xs*(yr*fz-fy*zr) + fx*(yr*zs-ys*zr))/J;
+    r -= dr; s -= ds; t -= dt;
+
+    if(fabs(dr)+fabs(ds)+fabs(dt) < 1.0e-13) break;
+  }
+
+  rst[0] = r; rst[1] = s; rst[2] = t;
+
+  const dfloat eps = 1.0e-10;
+  return (fabs(r) <= 1+eps && fabs(s) <= 1+eps && fabs(t) <= 1+eps);
+}
+
+// tensor product Lagrange interpolation row on the GLL nodes of hex e
+static void acousticsHexInterpolationRow(mesh_t *mesh, dlong e, const dfloat *xyz, dfloat *intpol){
+
+  dfloat rst[3];
+  acousticsHexInverseMap(mesh, e, xyz, rst);
+
+  dfloat *l = (dfloat*) calloc(3*mesh->Nq, sizeof(dfloat));
+  for(int a = 0; a < mesh->Nq; a++){
+    for(int d = 0; d < 3; d++){
+      l[d*mesh->Nq+a] = 1.0;
+      for(int b = 0; b < mesh->Nq; b++){
+        if(b != a)
+          l[d*mesh->Nq+a] *= (rst[d]-mesh->gllz[b])/(mesh->gllz[a]-mesh->gllz[b]);
+      }
+    }
+  }
+
+  for(int k = 0; k < mesh->Nq; k++)
+    for(int j = 0; j < mesh->Nq; j++)
+      for(int i = 0; i < mesh->Nq; i++)
+        intpol[i + j*mesh->Nq + k*mesh->Nq*mesh->Nq] = l[i]*l[mesh->Nq+j]*l[2*mesh->Nq+k];
+
+  free(l);
+}
+
+static int acousticsRecvCompare(const void *a, const void *b){
+  const dlong *ra = (const dlong*) a;
+  const dlong *rb = (const dlong*) b;
+
+  if(ra[0] < rb[0]) return -1;
+  if(ra[0] > rb[0]) return +1;
+  if(ra[1] < rb[1]) return -1;
+  if(ra[1] > rb[1]) return +1;
+  return 0;
+}
+
+// Sort the local receivers by host element and build one group per element,
+// so the interpolation kernel loads each element's fields only once.
+static void acousticsRecvGroupSetup(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+  dlong NReceiversLocal = acoustics->NReceiversLocal;
+
+  dlong *pairs = (dlong*) calloc(2*NReceiversLocal, sizeof(dlong));
+  for(dlong iRecv = 0; iRecv < NReceiversLocal; iRecv++){
+    dlong rIdx = acoustics->recvElementsIdx[iRecv];
+    pairs[2*iRecv+0] = acoustics->recvElements[rIdx];
+    pairs[2*iRecv+1] = rIdx;
+  }
+  qsort(pairs, NReceiversLocal, 2*sizeof(dlong), acousticsRecvCompare);
+
+  acoustics->NrecvGroups = 0;
+  acoustics->recvGroupStarts = (dlong*) calloc(NReceiversLocal+1, sizeof(dlong));
+  acoustics->recvGroupElements = (dlong*) calloc(NReceiversLocal, sizeof(dlong));
+  for(dlong iRecv = 0; iRecv < NReceiversLocal; iRecv++){
+    acoustics->recvElementsIdx[iRecv] = pairs[2*iRecv+1];
+    if(iRecv == 0 || pairs[2*iRecv] != pairs[2*(iRecv-1)]){
+      acoustics->recvGroupStarts[acoustics->NrecvGroups] = iRecv;
+      acoustics->recvGroupElements[acoustics->NrecvGroups] = pairs[2*iRecv];
+      acoustics->NrecvGroups++;
+    }
+  }
+  acoustics->recvGroupStarts[acoustics->NrecvGroups] = NReceiversLocal;
+
+  acoustics->o_recvGroupStarts =
+    mesh->device.malloc((acoustics->NrecvGroups+1)*sizeof(dlong), acoustics->recvGroupStarts);
+  acoustics->o_recvGroupElements =
+    mesh->device.malloc(acoustics->NrecvGroups*sizeof(dlong), acoustics->recvGroupElements);
+
+  free(pairs);
+}
+
 // Create interpolation operators
 void acousticsRecvIntpolOperators(acoustics_t *acoustics){
 	
   mesh_t *mesh = acoustics->mesh;
   dfloat *intpol;
   intpol = (dfloat*) calloc(acoustics->NReceiversLocal*mesh->Np, sizeof(dfloat));
+
+  // Rows of the interpolation matrix follow the element-sorted receiver order
+  acousticsRecvGroupSetup(acoustics);
+
+  //Vandermonde Berstein matrix in all receiver points
+  dfloat *VB = (dfloat*) calloc(acoustics->NReceiversLocal*mesh->Np, sizeof(dfloat));
   
   for(int iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
 
     // Receriver element
     dlong rIdx = acoustics->recvElementsIdx[iRecv];
     dlong recvElement = acoustics->recvElements[rIdx];
+
+    if(acoustics->elementType==HEXAHEDRA){
+      acousticsHexInterpolationRow(mesh, recvElement, acoustics->recvXYZ+rIdx*3, intpol+iRecv*mesh->Np);
+      continue;
+    }
+
     dfloat xRecvElement[4];
     dfloat yRecvElement[4];
     dfloat zRecvElement[4];
@@ -143,8 +283,7 @@ void acousticsRecvIntpolOperators(acoustics_t *acoustics){
     dfloat L4_rec = (xRecvElement[0]*yRecvElement[1]*zRecvElement[2] - xRecvElement[0]*yRecvElement[1]*acoustics->recvXYZ[2+rIdx*3] - xRecvElement[0]*yRecvElement[2]*zRecvElement[1] + xRecvElement[0]*yRecvElement[2]*acoustics->recvXYZ[2+rIdx*3] + xRecvElement[0]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[1] - xRecvElement[0]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[2] - xRecvElement[1]*yRecvElement[0]*zRecvElement[2] + xRecvElement[1]*yRecvElement[0]*acoustics->recvXYZ[2+rIdx*3] + xRecvElement[1]*yRecvElement[2]*zRecvElement[0] - xRecvElement[1]*yRecvElement[2]*acoustics->recvXYZ[2+rIdx*3] - xRecvElement[1]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[0] + xRecvElement[1]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[2] + xRecvElement[2]*yRecvElement[0]*zRecvElement[1] - xRecvElement[2]*yRecvElement[0]*acoustics->recvXYZ[2+rIdx*3] - xRecvElement[2]*yRecvElement[1]*zRecvElement[0] + xRecvElement[2]*yRecvElement[1]*acoustics->recvXYZ[2+rIdx*3] + xRecvElement[2]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[0] - xRecvElement[2]*acoustics->recvXYZ[1+rIdx*3]*zRecvElement[1] - acoustics->recvXYZ[0+rIdx*3]*yRecvElement[0]*zRecvElement[1] + acoustics->recvXYZ[0+rIdx*3]*yRecvElement[0]*zRecvElement[2] + acoustics->recvXYZ[0+rIdx*3]*yRecvElement[1]*zRecvElement[0] - acoustics->recvXYZ[0+rIdx*3]*yRecvElement[1]*zRecvElement[2] - acoustics->recvXYZ[0+rIdx*3]*yRecvElement[2]*zRecvElement[0] + acoustics->recvXYZ[0+rIdx*3]*yRecvElement[2]*zRecvElement[1])/(xRecvElement[0]*yRecvElement[1]*zRecvElement[2] - xRecvElement[0]*yRecvElement[1]*zRecvElement[3] - xRecvElement[0]*yRecvElement[2]*zRecvElement[1] + xRecvElement[0]*yRecvElement[2]*zRecvElement[3] + xRecvElement[0]*yRecvElement[3]*zRecvElement[1] - xRecvElement[0]*yRecvElement[3]*zRecvElement[2] - xRecvElement[1]*yRecvElement[0]*zRecvElement[2] + xRecvElement[1]*yRecvElement[0]*zRecvElement[3] + xRecvElement[1]*yRecvElement[2]*zRecvElement[0] - xRecvElement[1]*yRecvElement[2]*zRecvElement[3] - xRecvElement[1]*yRecvElement[3]*zRecvElement[0] + xRecvElement[1]*yRecvElement[3]*zRecvElement[2] + xRecvElement[2]*yRecvElement[0]*zRecvElement[1] - xRecvElement[2]*yRecvElement[0]*zRecvElement[3] - xRecvElement[2]*yRecvElement[1]*zRecvElement[0] + xRecvElement[2]*yRecvElement[1]*zRecvElement[3] + xRecvElement[2]*yRecvElement[3]*zRecvElement[0] - xRecvElement[2]*yRecvElement[3]*zRecvElement[1] - xRecvElement[3]*yRecvElement[0]*zRecvElement[1] + xRecvElement[3]*yRecvElement[0]*zRecvElement[2] + xRecvElement[3]*yRecvElement[1]*zRecvElement[0] - xRecvElement[3]*yRecvElement[1]*zRecvElement[2] - xRecvElement[3]*yRecvElement[2]*zRecvElement[0] + xRecvElement[3]*yRecvElement[2]*zRecvElement[1]);
 
     //Vandermonde Berstein matrix in receiver point
-    dfloat *VB_rec;
-    VB_rec = (dfloat*) calloc(mesh->Np, sizeof(dfloat));
+    dfloat *VB_rec = VB + iRecv*mesh->Np;
 
     int sk = 0;
     for(int l = 0; l <= mesh->N; l++){
@@ -157,32 +296,52 @@ void acousticsRecvIntpolOperators(acoustics_t *acoustics){
         }
       }
     }
-    // interpolation   
-    for(int j = 0; j < mesh->Np; j++){
-      for(int i = 0; i < mesh->Np; i++){
-        intpol[iRecv*mesh->Np+i] += VB_rec[j]*mesh->invVB[i+j*mesh->Np];
+  }
+
+  // interpolation: all tet receivers share the reference inverse Vandermonde,
+  // so apply it once to the stacked receiver rows
+  if(acoustics->elementType!=HEXAHEDRA){
+    for(dlong iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
+      for(int j = 0; j < mesh->Np; j++){
+        const dfloat VBij = VB[iRecv*mesh->Np+j];
+        for(int i = 0; i < mesh->Np; i++){
+          intpol[iRecv*mesh->Np+i] += VBij*mesh->invVB[i+j*mesh->Np];
+        }
       }
     }
-    #if 0
-    printf("new, irecv = %d, ele = %d\n",iRecv,recvElement);
-    for(int i = 0; i < mesh->Np; i++){
-      printf("%.15lf \n",intpol[iRecv*mesh->Np+i]);
-    }
-    printf("\n");
-    #endif
-    free(VB_rec);
   }
 
   acoustics->o_recvintpol = 
         mesh->device.malloc(acoustics->NReceiversLocal*mesh->Np*sizeof(dfloat),intpol);
 
   free(intpol);
+  free(VB);
+}
+
+// Copy the buffered receiver samples, one row per receiver channel, to the host
+void acousticsRecvCopyToHost(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+  dlong NrecvChannels = acoustics->NReceiversLocal*acoustics->NrecvFields;
+
+  for(dlong iChan = 0; iChan < NrecvChannels; iChan++){
+    dlong offset = recvCopyRate*acoustics->qRecvCopyCounter + mesh->NtimeSteps*iChan;
+
+    acoustics->o_qRecv.copyTo(acoustics->qRecv+offset,
+          acoustics->qRecvCounter*sizeof(dfloat), 
+          recvCopyRate*iChan*sizeof(dfloat));  
+  }
+
+  // stream the new block through the metrics filter bank
+  dlong start = recvCopyRate*acoustics->qRecvCopyCounter;
+  acoustics->NrecvSamples = start + acoustics->qRecvCounter;
+  if(acoustics->metrics)
+    acousticsMetricsUpdate(acoustics, start, acoustics->qRecvCounter);
 }
 
 
 
 void acousticsFindReceiverElement(acoustics_t *acoustics){
-  // Only works for tets!
   // [TODO] If receiver point is on the boundary of two cores both will find it! Do some mpi stuff to fix!
   mesh_t *mesh = acoustics->mesh;
 
@@ -198,47 +357,52 @@ void acousticsFindReceiverElement(acoustics_t *acoustics){
     for(dlong i = 0; i < mesh->Nelements; i++){
       // Assume receiver is in element
       dlong isInside = 1;
-      for(int j = 0; j < mesh->Nfaces; j++){
-        dlong fv1 = faceVertices[j][0];
-        dlong fv2 = faceVertices[j][1];
-        dlong fv3 = faceVertices[j][2];
-        dlong fv4 = faceVertices[j][3];
-
-        // b r s defines the plane
-        dfloat b[3] = {mesh->EX[i*mesh->Nverts + fv1],
-                      mesh->EY[i*mesh->Nverts + fv1],
-                      mesh->EZ[i*mesh->Nverts + fv1]};
-        dfloat r[3] = {mesh->EX[i*mesh->Nverts + fv2],
-                      mesh->EY[i*mesh->Nverts + fv2],
-                      mesh->EZ[i*mesh->Nverts + fv2]};
-        dfloat s[3] = {mesh->EX[i*mesh->Nverts + fv3],
-                      mesh->EY[i*mesh->Nverts + fv3],
-                      mesh->EZ[i*mesh->Nverts + fv3]};
+      if(acoustics->elementType==HEXAHEDRA){
+        dfloat rst[3];
+        isInside = acousticsHexInverseMap(mesh, i, recvLoc, rst);
+      } else {
+        for(int j = 0; j < mesh->Nfaces; j++){
+          dlong fv1 = faceVertices[j][0];
+          dlong fv2 = faceVertices[j][1];
+          dlong fv3 = faceVertices[j][2];
+          dlong fv4 = faceVertices[j][3];
+
+          // b r s defines the plane
+          dfloat b[3] = {mesh->EX[i*mesh->Nverts + fv1],
+                        mesh->EY[i*mesh->Nverts + fv1],
+                        mesh->EZ[i*mesh->Nverts + fv1]};
+          dfloat r[3] = {mesh->EX[i*mesh->Nverts + fv2],
+                        mesh->EY[i*mesh->Nverts + fv2],
+                        mesh->EZ[i*mesh->Nverts + fv2]};
+          dfloat s[3] = {mesh->EX[i*mesh->Nverts + fv3],
+                        mesh->EY[i*mesh->Nverts + fv3],
+                        mesh->EZ[i*mesh->Nverts + fv3]};
         
-        // d is the control point (the last point in the tet)
-        dfloat d[3] = {mesh->EX[i*mesh->Nverts + fv4],
-                      mesh->EY[i*mesh->Nverts + fv4],
-                      mesh->EZ[i*mesh->Nverts + fv4]};
-
-
-        // Cross product to get normal vector of plane brs
-        dfloat n[3] = {(r[1]-b[1])*(s[2]-b[2]) - (r[2]-b[2])*(s[1]-b[1]),
-        (r[2]-b[2])*(s[0]-b[0]) - (r[0]-b[0])*(s[2]-b[2]),
-        (r[0]-b[0])*(s[1]-b[1]) - (r[1]-b[1])*(s[0]-b[0])};
-
-
-        // Calculate the plane equation for both receiver and leftover tet point.
-        dfloat planeEqRecv = n[0]*(recvLoc[0]-b[0]) + n[1]*(recvLoc[1]-b[1]) + n[2]*(recvLoc[2]-b[2]);
-        dfloat planeEqOther = n[0]*(d[0]-b[0]) + n[1]*(d[1]-b[1]) + n[2]*(d[2]-b[2]);
-
-        // Check if the two points are on the same side of the plane
-        dlong recvSide = planeEqRecv > 0 ? 1 : -1;
-        dlong otherSide = planeEqOther > 0 ? 1 : -1;
-        planeEqRecv = planeEqRecv >= 0 ? planeEqRecv:-1.0*planeEqRecv;
-        if(recvSide != otherSide && planeEqRecv > 1.0e-15){
-          // Recv is not inside element i
-          isInside = 0;
-          break;
+          // d is the control point (the last point in the tet)
+          dfloat d[3] = {mesh->EX[i*mesh->Nverts + fv4],
+                        mesh->EY[i*mesh->Nverts + fv4],
+                        mesh->EZ[i*mesh->Nverts + fv4]};
+
+
+          // Cross product to get normal vector of plane brs
+          dfloat n[3] = {(r[1]-b[1])*(s[2]-b[2]) - (r[2]-b[2])*(s[1]-b[1]),
+          (r[2]-b[2])*(s[0]-b[0]) - (r[0]-b[0])*(s[2]-b[2]),
+          (r[0]-b[0])*(s[1]-b[1]) - (r[1]-b[1])*(s[0]-b[0])};
+
+
+          // Calculate the plane equation for both receiver and leftover tet point.
+          dfloat planeEqRecv = n[0]*(recvLoc[0]-b[0]) + n[1]*(recvLoc[1]-b[1]) + n[2]*(recvLoc[2]-b[2]);
+          dfloat planeEqOther = n[0]*(d[0]-b[0]) + n[1]*(d[1]-b[1]) + n[2]*(d[2]-b[2]);
+
+          // Check if the two points are on the same side of the plane
+          dlong recvSide = planeEqRecv > 0 ? 1 : -1;
+          dlong otherSide = planeEqOther > 0 ? 1 : -1;
+          planeEqRecv = planeEqRecv >= 0 ? planeEqRecv:-1.0*planeEqRecv;
+          if(recvSide != otherSide && planeEqRecv > 1.0e-15){
+            // Recv is not inside element i
+            isInside = 0;
+            break;
+          }
         }
       }
       //Check if found recv point inside element i
@@ -283,10 +447,18 @@ void acousticsPrintReceiversToFile(acoustics_t *acoustics, setupAide &newOptions
     dfloat y = acoustics->recvXYZ[rIdx*3+1];
     dfloat z = acoustics->recvXYZ[rIdx*3+2];
     acousticsGaussianPulse(x, y, z, 0, &r, &u, &v, &w, sloc, sxyz);
-    fprintf(iFP, "%.15lf %.15lf\n", time, r);
-    for(int i = 0; i < mesh->NtimeSteps; i++){
+    // Columns: time p [u v w]
+    dfloat q0[4] = {r, u, v, w};
+    fprintf(iFP, "%.15lf", time);
+    for(int fld = 0; fld < acoustics->NrecvFields; fld++)
+      fprintf(iFP, " %.15lf", q0[fld]);
+    fprintf(iFP, "\n");
+    for(int i = 0; i < acoustics->NrecvSamples; i++){
       time += mesh->dt;
-      fprintf(iFP, "%.15lf %.15lf\n", time, acoustics->qRecv[i+iRecv*mesh->NtimeSteps]);
+      fprintf(iFP, "%.15lf", time);
+      for(int fld = 0; fld < acoustics->NrecvFields; fld++)
+        fprintf(iFP, " %.15lf", acoustics->qRecv[i+(iRecv*acoustics->NrecvFields+fld)*mesh->NtimeSteps]);
+      fprintf(iFP, "\n");
     }
     fclose(iFP);
   }
@@ -275,3 +275,40 @@ void acousticsSnapshot(acoustics_t *acoustics, dfloat time, setupAide &newOption
   fclose(temp);
   #endif
 }
+
+// Write the running DFT once at the end of the run, one raw binary file per rank:
+// Nelements (dlong), Np, Nfields, NdftFreqs, sizeof(dfloat) (int), the frequencies,
+// the node coordinates x, y, z and then q's Re/Im parts, [freq][Re,Im][element][field][node].
+void acousticsDFTWrite(acoustics_t *acoustics, setupAide &newOptions){
+
+  mesh_t *mesh = acoustics->mesh;
+  dlong Ndofs = mesh->Nelements*mesh->Np*mesh->Nfields;
+
+  acoustics->o_qDFT.copyTo(acoustics->qDFT, 2*acoustics->NdftFreqs*Ndofs*sizeof(dfloat), 0);
+
+  string PREFIX;
+  newOptions.getArgs("SNAPSHOTPREFIX", PREFIX);
+
+  char fname[BUFSIZ];
+  sprintf(fname, "data/snapshot/%s_DFT_%05d.bin", (char*)PREFIX.c_str(), mesh->rank);
+
+  FILE *fp = fopen(fname, "wb");
+  if(fp == NULL){
+    printf("Could not open DFT output file: %s\n", fname);
+    return;
+  }
+
+  int header[4] = {mesh->Np, mesh->Nfields, acoustics->NdftFreqs, (int) sizeof(dfloat)};
+  fwrite(&mesh->Nelements, sizeof(dlong), 1, fp);
+  fwrite(header, sizeof(int), 4, fp);
+  fwrite(acoustics->dftFreqs, sizeof(dfloat), acoustics->NdftFreqs, fp);
+  fwrite(mesh->x, sizeof(dfloat), mesh->Nelements*mesh->Np, fp);
+  fwrite(mesh->y, sizeof(dfloat), mesh->Nelements*mesh->Np, fp);
+  fwrite(mesh->z, sizeof(dfloat), mesh->Nelements*mesh->Np, fp);
+  fwrite(acoustics->qDFT, sizeof(dfloat), 2*acoustics->NdftFreqs*Ndofs, fp);
+  fclose(fp);
+
+  if(mesh->rank == 0)
+    printf("Wrote running DFT at %d frequencies to data/snapshot/%s_DFT_*.bin\n",
+           acoustics->NdftFreqs, (char*)PREFIX.c_str());
+}
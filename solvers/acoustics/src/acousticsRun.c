@@ -47,8 +47,7 @@ void acousticsBCChange(acoustics_t *acoustics, dfloat time){
     acoustics->o_acc.copyFrom(acoustics->acc);
 
     // Swap ER points to LR
-    mesh->NLRPoints = mesh->NERPoints;
-    mesh->NERPoints = 0;
+    acousticsMaterialBCChange(acoustics);
 
     // Make sure this swap only happens once
     acoustics->BCChangeTime = 0.0;
@@ -148,6 +147,20 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
 	  acoustics->o_q.copyFrom(acoustics->o_rkq);
 	}
 
+	// running DFT of the accepted q(time+dt), weighted by the accepted step
+	// since the step size varies (every accepted step is sampled)
+	if(acoustics->NdftFreqs){
+	  kernelProfileStart(acoustics->profile);
+	  acoustics->dftKernel(mesh->Nelements,
+			       acoustics->o_q,
+			       acoustics->NdftFreqs,
+			       acoustics->o_dftFreqs,
+			       mesh->dt,
+			       time+mesh->dt,
+			       acoustics->o_qDFT);
+	  kernelProfileStop(acoustics->profile, acoustics->profDFT);
+	}
+
         time += mesh->dt;
 
         acoustics->facold = mymax(err,1E-4); // hard coded factor ?
@@ -209,6 +222,15 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
       if(tstep % 500 == 0 && !mesh->rank){
         printf("LSERK4 - Step: %d, out of: %d\n",tstep, mesh->NtimeSteps);
       }
+
+      // stop early once all receivers decayed past [DECAY TERMINATION],
+      // or the energy monitor reports decay, stagnation or instability
+      if(acousticsMetricsStop(acoustics, tstep) ||
+         acousticsEnergyMonitor(acoustics, tstep, time+mesh->dt)){
+        if(acoustics->snapshot && snapshotCounter > 0)
+          acousticsSnapshot(acoustics, time, newOptions, snapshotFlag, snapshotCounter);
+        break;
+      }
     }
   } else if (newOptions.compareArgs("TIME INTEGRATOR","EIRK4")){
     dfloat time = 0.0;
@@ -246,6 +268,15 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
       if(tstep % 500 == 0 && !mesh->rank){
         printf("EIRK4 - Step: %d, out of: %d\n",tstep, mesh->NtimeSteps);
       }
+
+      // stop early once all receivers decayed past [DECAY TERMINATION],
+      // or the energy monitor reports decay, stagnation or instability
+      if(acousticsMetricsStop(acoustics, tstep) ||
+         acousticsEnergyMonitor(acoustics, tstep, time+mesh->dt)){
+        if(acoustics->snapshot && snapshotCounter > 0)
+          acousticsSnapshot(acoustics, time, newOptions, snapshotFlag, snapshotCounter);
+        break;
+      }
     }
   } else if(newOptions.compareArgs("TIME INTEGRATOR","EIRK4ADAP")){
     dfloat time = 0.0;
@@ -273,7 +304,7 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
                 acoustics->o_rkerr,
                 acoustics->o_q);
 
-      dlong accLength = mesh->NLRPoints*acoustics->LRNpoles + mesh->NERPoints*acoustics->ERNpoles;
+      dlong accLength = acoustics->NLRAcc + acoustics->NERAcc;
       acoustics->acousticsErrorEIRK4Acc(accLength,
 		            dt,  
 		            mesh->o_esdirke,
@@ -297,19 +328,20 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
 
     }
   }
+  acousticsEnergyFinalize(acoustics);
+  if(acoustics->unstable && !mesh->rank)
+    printf("WARNING: run stopped by the energy monitor, results past the instability are not valid\n");
+
   // [EA] Copy remaining o_qRecv from device to host
   if(acoustics->NReceiversLocal > 0){
 
-    for(int iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
-      dlong offset = recvCopyRate*acoustics->qRecvCopyCounter + mesh->NtimeSteps*iRecv;
-      
-      acoustics->o_qRecv.copyTo(acoustics->qRecv+offset,
-            acoustics->qRecvCounter*sizeof(dfloat), 
-            recvCopyRate*iRecv*sizeof(dfloat));  
-    }
+    acousticsRecvCopyToHost(acoustics);
 
   }
   if(acoustics->snapshot){
     acousticsSnapshotXYZ(acoustics, newOptions);
   }
+  if(acoustics->NdftFreqs){
+    acousticsDFTWrite(acoustics, newOptions);
+  }
 }
@@ -27,6 +27,24 @@ SOFTWARE.
 #include "acoustics.h"
 #include <stdio.h>
 
+// [EA] Element field on the device. In CPU mode its pages are first touched by the
+// OpenMP thread that owns each element block before the host data is copied in.
+static occa::memory acousticsFieldMalloc(acoustics_t *acoustics, dlong Nelements, void *src){
+
+  mesh_t *mesh = acoustics->mesh;
+  const dlong Nentries = mesh->Np*mesh->Nfields;
+  const size_t bytes = Nelements*Nentries*sizeof(dfloat);
+
+  if(!acoustics->cpuMode)
+    return mesh->device.malloc(bytes, src);
+
+  occa::memory o_a = mesh->device.malloc(bytes);
+  acoustics->firstTouchKernel(Nelements, Nentries, o_a);
+  o_a.copyFrom(src);
+
+  return o_a;
+}
+
 acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryHeaderFileName){
   acoustics_t *acoustics = (acoustics_t*) calloc(1, sizeof(acoustics_t));
 
@@ -143,6 +161,20 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
   for(dlong e=0;e<mesh->Nelements;++e){  
 
     for(int f=0;f<mesh->Nfaces;++f){
+      if(acoustics->elementType==HEXAHEDRA){
+        // hex surface factors are stored per face node, sJ/J = 2/h on each node
+        for(int n=0;n<mesh->Nfp;++n){
+          dlong sid = mesh->Nsgeo*(mesh->Nfaces*mesh->Nfp*e + mesh->Nfp*f + n);
+          dfloat sJ   = mesh->sgeo[sid + SJID];
+          dfloat invJ = mesh->sgeo[sid + IJID];
+
+          dfloat hest = 2./(sJ*invJ);
+
+          hmin = mymin(hmin, hest);
+        }
+        continue;
+      }
+
       dlong sid = mesh->Nsgeo*(mesh->Nfaces*e + f);
       dfloat sJ   = mesh->sgeo[sid + SJID];
       dfloat invJ = mesh->sgeo[sid + IJID];
@@ -187,6 +219,8 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
   //---------RECEIVER---------
   acoustics->qRecvCounter = 0; // Counter needed for later
   acoustics->qRecvCopyCounter = 0;
+  // Record particle velocity alongside pressure
+  acoustics->NrecvFields = newOptions.compareArgs("RECEIVER VELOCITY","TRUE") ? mesh->Nfields : 1;
 
 
   // Read from receiver locations file
@@ -234,6 +268,9 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
  kernelInfo["header"].asArray();
  kernelInfo["flags"].asObject();
 
+  // [EA] Impedance materials, remaps EToB before it is copied to the device
+  acousticsMaterialSetup(acoustics, newOptions);
+
   if(acoustics->dim==3)
     meshOccaSetup3D(mesh, newOptions, kernelInfo);
   else
@@ -241,15 +278,36 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
   //add boundary data to kernel info
   kernelInfo["includes"] += boundaryHeaderFileName;
+
+  // [EA] Rank 0 (or one rank per node) compiles, the others load from the OCCA cache
+  acoustics->builder = kernelBuilderSetup(mesh->device, mesh->comm, newOptions);
+
+  // [EA] CPU mode on the OpenMP/Serial backends: blocks of p_NblockCPU elements
+  // (SIMD lanes) per thread and first-touch placement. [CPU KERNELS] FALSE keeps
+  // the GPU kernels on those backends.
+  acoustics->cpuMode = (mesh->device.mode()=="OpenMP" || mesh->device.mode()=="Serial")
+    && !newOptions.compareArgs("CPU KERNELS","FALSE");
+  acoustics->NblockCPU = 8;
+  if(acoustics->cpuMode){
+    newOptions.getArgs("CPU ELEMENT BLOCK", acoustics->NblockCPU);
+    kernelInfo["compiler_flags"] += " -O3 -march=native";
+  }
+  kernelInfo["defines/" "p_NblockCPU"]= acoustics->NblockCPU;
+
+  if(acoustics->cpuMode)
+    acoustics->firstTouchKernel =
+      kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsFirstTouch.okl",
+                               "acousticsFirstTouch",
+                               kernelInfo);
  
   acoustics->o_q =
-    mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), acoustics->q);
+    acousticsFieldMalloc(acoustics, mesh->totalHaloPairs+mesh->Nelements, acoustics->q);
 
   acoustics->o_saveq =
     mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), acoustics->q);
   
   acoustics->o_rhsq =
-    mesh->device.malloc(mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), acoustics->rhsq);
+    acousticsFieldMalloc(acoustics, mesh->Nelements, acoustics->rhsq);
   
   // [EA] Snapshot of solution q
   newOptions.getArgs("SNAPSHOT", acoustics->snapshot);
@@ -261,251 +319,51 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     //acoustics->o_qSnapshot = 
     //    mesh->device.malloc(acoustics->writeSnapshotEvery*mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), acoustics->qSnapshot);
   }
-  // [EA] Read and allocate space for LR/ER accumulators
-  dlong Nangles = 91; // [EA] Number of angles for ER
-  if(mesh->NERFaces){
-    string ERDATAFileName;
-    newOptions.getArgs("ERVECTFIT", ERDATAFileName);
-
-    FILE * ERDATAFILE = fopen((char*)ERDATAFileName.c_str(),"r");
-    if (ERDATAFILE == NULL) {
-      printf("Could not find ERDATA file: %s\n", (char*)ERDATAFileName.c_str());
-      exit(-1);
-    }
-
-    
-
-    fscanf(ERDATAFILE,"%d %d %d",&acoustics->ERNpoles, &acoustics->ERNRealPoles,&acoustics->ERNImagPoles);
-
-    acoustics->ER = (dfloat*) calloc(Nangles + acoustics->ERNRealPoles+acoustics->ERNRealPoles*Nangles 
-    + 2*acoustics->ERNImagPoles*Nangles+2*acoustics->ERNImagPoles, sizeof(dfloat));
-    acoustics->ERInfo = (dlong*) calloc(3,sizeof(dlong));
-
-    acoustics->ERInfo[0] = acoustics->ERNpoles;
-    acoustics->ERInfo[1] = acoustics->ERNRealPoles;
-    acoustics->ERInfo[2] = acoustics->ERNImagPoles;
-
-
-    dlong iReadOffset = 0;
-    for(int iRead = 0; iRead < acoustics->ERNRealPoles*Nangles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNRealPoles*Nangles;
-    for(int iRead = 0; iRead < acoustics->ERNImagPoles*Nangles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNImagPoles*Nangles;
-    for(int iRead = 0; iRead < acoustics->ERNImagPoles*Nangles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNImagPoles*Nangles;
-    for(int iRead = 0; iRead < acoustics->ERNRealPoles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNRealPoles;
-    for(int iRead = 0; iRead < acoustics->ERNImagPoles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNImagPoles;
-    for(int iRead = 0; iRead < acoustics->ERNImagPoles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-      //printf("beta = %f\n",acoustics->ER[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->ERNImagPoles;
-    for(int iRead = 0; iRead < Nangles; iRead++){
-      fscanf(ERDATAFILE,"%lf",&acoustics->ER[iReadOffset+iRead]);
-    }
-    fclose(ERDATAFILE);
-
-
-    acoustics->o_ER = mesh->device.malloc((Nangles + acoustics->ERNRealPoles+acoustics->ERNRealPoles*Nangles 
-    + 2*acoustics->ERNImagPoles*Nangles+2*acoustics->ERNImagPoles)*sizeof(dfloat), acoustics->ER);
-    acoustics->o_ERInfo = mesh->device.malloc(3*sizeof(dlong), acoustics->ERInfo);
-
-  } else {
-      // [EA] To avoid empty pointers as this causes crashes on gpu
-      acoustics->ERNpoles = 1;
-      acoustics->ERNRealPoles = 0;
-      acoustics->ERNImagPoles = 0;
-
-      acoustics->ERInfo = (dlong*) calloc(3,sizeof(dlong));
-      acoustics->ERInfo[0] = 0;
-      acoustics->ERInfo[1] = 0;
-      acoustics->ERInfo[2] = 0;
-      acoustics->o_ER = mesh->device.malloc(1*sizeof(dfloat));
-      acoustics->o_ERInfo = mesh->device.malloc(3*sizeof(dlong), acoustics->ERInfo);
-  }
-  newOptions.getArgs("BCCHANGETIME", acoustics->BCChangeTime);
-  if(mesh->NLRFaces || (acoustics->BCChangeTime > 0.0 && mesh->NERFaces)){
-    // [EA] LR BCs
-    
-    string LRDATAFileName;
-    newOptions.getArgs("LRVECTFIT", LRDATAFileName);
-
-    FILE * LRDATAFILE = fopen((char*)LRDATAFileName.c_str(),"r");
-    if (LRDATAFILE == NULL) {
-      printf("Could not find LRDATA file: %s\n", (char*)LRDATAFileName.c_str());
-      exit(-1);
-    }
-
-    fscanf(LRDATAFILE,"%d %d %d",&acoustics->LRNpoles, &acoustics->LRNRealPoles,&acoustics->LRNImagPoles);
-    
-    acoustics->LR = (dfloat*) calloc(1 + 2*acoustics->LRNRealPoles + 4*acoustics->LRNImagPoles,sizeof(dfloat));
-    acoustics->LRInfo = (dlong*) calloc(3,sizeof(dlong));
-
-    acoustics->LRInfo[0] = acoustics->LRNpoles;
-    acoustics->LRInfo[1] = acoustics->LRNRealPoles;
-    acoustics->LRInfo[2] = acoustics->LRNImagPoles;
-
-    
-    dlong iReadOffset = 0;
-    for(int iRead = 0; iRead < acoustics->LRNRealPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->LRNRealPoles;
-    for(int iRead = 0; iRead < acoustics->LRNImagPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->LRNImagPoles;
-    for(int iRead = 0; iRead < acoustics->LRNImagPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->LRNImagPoles;
-    for(int iRead = 0; iRead < acoustics->LRNRealPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-
-    iReadOffset += acoustics->LRNRealPoles;
-    for(int iRead = 0; iRead < acoustics->LRNImagPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->LRNImagPoles;
-    for(int iRead = 0; iRead < acoustics->LRNImagPoles; iRead++){
-      fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset+iRead]);
-    }
-    iReadOffset += acoustics->LRNImagPoles;
-    fscanf(LRDATAFILE,"%lf",&acoustics->LR[iReadOffset]);
-    fclose(LRDATAFILE);
-    acoustics->o_LR = mesh->device.malloc((1 + 2*acoustics->LRNRealPoles + 4*acoustics->LRNImagPoles)*sizeof(dfloat), acoustics->LR);
-    acoustics->o_LRInfo = mesh->device.malloc(3*sizeof(dlong), acoustics->LRInfo);
-    
-  } else {
-      // [EA] To avoid empty pointers as this causes crashes on gpu
-
-      acoustics->LRNpoles = 1;
-      acoustics->LRNRealPoles = 0;
-      acoustics->LRNImagPoles = 0;
-
-
-      acoustics->LRInfo = (dlong*) calloc(3,sizeof(dlong));
-      acoustics->LRInfo[0] = 0;
-      acoustics->LRInfo[1] = 0;
-      acoustics->LRInfo[2] = 0;
-      acoustics->o_LR = mesh->device.malloc(1*sizeof(dfloat));
-      acoustics->o_LRInfo = mesh->device.malloc(3*sizeof(dlong), acoustics->LRInfo);
-
+  // Running DFT of q, disabled by [DFT FREQUENCIES] 0
+  vector<dfloat> dftFreqs;
+  acoustics->NdftFreqs = 0;
+  acoustics->dftEvery = 1;
+  acoustics->dftCounter = 0;
+  if(newOptions.getArgs("DFT FREQUENCIES", dftFreqs) && dftFreqs[0] > 0){
+    newOptions.getArgs("DFT EVERY", acoustics->dftEvery);
+    if(acoustics->dftEvery < 1) acoustics->dftEvery = 1;
+
+    acoustics->NdftFreqs = dftFreqs.size();
+    acoustics->dftFreqs = (dfloat*) calloc(acoustics->NdftFreqs, sizeof(dfloat));
+    for(int f = 0; f < acoustics->NdftFreqs; f++)
+      acoustics->dftFreqs[f] = dftFreqs[f];
+
+    // Re and Im parts for every frequency, accumulated on the device
+    acoustics->qDFT = (dfloat*) calloc(2*acoustics->NdftFreqs*mesh->Np*mesh->Nelements*mesh->Nfields, sizeof(dfloat));
+    acoustics->o_dftFreqs =
+      mesh->device.malloc(acoustics->NdftFreqs*sizeof(dfloat), acoustics->dftFreqs);
+    acoustics->o_qDFT =
+      mesh->device.malloc(2*acoustics->NdftFreqs*mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), acoustics->qDFT);
   }
 
+  // [EA] Impedance boundary points and accumulators packed by material
   mesh->NboundaryPointsLocal = mesh->Nfp*mesh->NboundaryFacesLocal;
-  mesh->NLRPoints = mesh->Nfp*mesh->NLRFaces;
-  mesh->NERPoints = mesh->Nfp*mesh->NERFaces;
-
-
-  dlong RPointsAlloc = mesh->NLRPoints+mesh->NERPoints ? mesh->NLRPoints+mesh->NERPoints:1; // [EA] Occa cannot have pointers to empty arrays
-  dlong NERPointsAlloc = mesh->NERPoints ? mesh->NERPoints:1;
-  mesh->mapAccToQ = (dlong*) calloc(RPointsAlloc, sizeof(dlong));
-  mesh->mapAccToXYZ = (dlong*) calloc(NERPointsAlloc, sizeof(dlong));
-  mesh->mapAccToN = (dlong*) calloc(NERPointsAlloc, sizeof(dlong));
-
-  hlong counter = 0;
-  hlong counter2 = 0;
-  for(hlong e = 0; e < mesh->Nelements;e++){
-    for(hlong n = 0; n < mesh->Nfp*mesh->Nfaces; n++){
-      hlong id  = e*mesh->Nfp*mesh->Nfaces + n;
-      if(mesh->mapAcc[id] == -2){ // The point id is a domain boundary point
-        int face = n/mesh->Nfp;
-        int bc = mesh->EToB[face+mesh->Nfaces*e];
-        if(bc == 3 || bc == 7){
-          mesh->mapAcc[id] = counter;
-
-
-          dlong idM = mesh->vmapM[id];
-          int vidM = idM%mesh->Np;
-          dlong qbaseM = e*mesh->Np*mesh->Nfields + vidM;
-          mesh->mapAccToQ[counter] = qbaseM;
-          counter++;
-        }
-        if(bc == 4 || bc == 8){
-          mesh->mapAcc[id] = counter2;
-
-          dlong idM = mesh->vmapM[id];
-          int vidM = idM%mesh->Np;
-          dlong qbaseM = e*mesh->Np*mesh->Nfields + vidM;
-          mesh->mapAccToQ[mesh->NLRPoints+counter2] = qbaseM;
-          mesh->mapAccToXYZ[counter2] = e*mesh->Np + vidM;
-          mesh->mapAccToN[counter2] = mesh->Nsgeo*(e*mesh->Nfaces+face);
-          counter2++;
-        }
-      }
-    }
-  }
-  #if 0
-  printf("---MAPACC---\n");
-  for(int i1 = 0; i1 < mesh->Nfp*mesh->Nfaces*mesh->Nelements; i1++){
-    printf("%d\n",mesh->mapAcc[i1]);
-  }
-  printf("---MAPACC---\n");
-  printf("---MAPACCQ---\n");
-  for(int i1 = 0; i1 < RPointsAlloc; i1++){
-    printf("%d\n",mesh->mapAccToQ[i1]);
-  }
-  printf("---MAPACCQ---\n");
-  #endif
-
-  // [EA] mapAcc to device
-  mesh->o_mapAcc =
-    mesh->device.malloc(mesh->Nelements*mesh->Nfp*mesh->Nfaces*sizeof(dlong),
-                        mesh->mapAcc);
-  mesh->o_mapAccToQ =
-    mesh->device.malloc(RPointsAlloc*sizeof(dlong),
-                        mesh->mapAccToQ);
-  mesh->o_mapAccToXYZ =
-    mesh->device.malloc(NERPointsAlloc*sizeof(dlong),
-                        mesh->mapAccToXYZ);
-  mesh->o_mapAccToN =
-    mesh->device.malloc(NERPointsAlloc*sizeof(dlong),
-                        mesh->mapAccToN);
+  acousticsMaterialPack(acoustics);
 
   // [EA] Moved these from below
   kernelInfo["defines/" "p_blockSize"]= blockSize;
   kernelInfo["defines/" "p_Nfields"]= mesh->Nfields; 
+  kernelInfo["defines/" "p_Nverts"]= mesh->Nverts; // selects tet or hex point location in the ER kernels
+  kernelInfo["defines/" "p_recvNfields"]= acoustics->NrecvFields;
 
   
   // [EA] Build interpolation operators for ER wave-splitting points
   
   dfloat dx = 0.01; // [EA] Distance to move wave-splitting points
-  kernelInfo["defines/" "p_ERdx"]= dx; 
+  acoustics->ERdx = dx; // kernel argument, keeps the ER kernels cacheable
 
   acoustics->NERPointsTotal = 0;
   MPI_Allreduce(&mesh->NERPoints, &acoustics->NERPointsTotal, 1, MPI_DLONG, MPI_SUM, mesh->comm);
 
 
-  // [EA] BCChangeTime error checking
-  if(acoustics->BCChangeTime > 0.0){
-    if(acoustics->NERPointsTotal == 0){
-      printf("BCCHANGETIME is greater than 0 with no Extended Reaction boundaries!\n");
-      exit(-1);
-    }
-    if(acoustics->LRInfo[0] != acoustics->ERInfo[0]){
-      printf("BCCHANGETIME is greater than 0, but number of poles in Local Reaction and Extended Reaction are not equal!\n");
-      exit(-1);
-    }
-  }
-
-
   if(acoustics->NERPointsTotal){
     occa::kernel ERInterpolationOperators = 
-              mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+              kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
 				      "ERInterpolationOperators",
 				      kernelInfo);
 
@@ -514,7 +372,11 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     o_EX = mesh->device.malloc(mesh->Nverts*mesh->Nelements*sizeof(dfloat),mesh->EX);
     o_EY = mesh->device.malloc(mesh->Nverts*mesh->Nelements*sizeof(dfloat),mesh->EY);
     o_EZ = mesh->device.malloc(mesh->Nverts*mesh->Nelements*sizeof(dfloat),mesh->EZ);
-    o_invVB = mesh->device.malloc(mesh->Np*mesh->Np*sizeof(dfloat),mesh->invVB);
+    // hexes interpolate with tensor product Lagrange polynomials on the 1D GLL nodes
+    if(acoustics->elementType==HEXAHEDRA)
+      o_invVB = mesh->device.malloc(mesh->Nq*sizeof(dfloat),mesh->gllz);
+    else
+      o_invVB = mesh->device.malloc(mesh->Np*mesh->Np*sizeof(dfloat),mesh->invVB);
 
     acoustics->o_ERintpol = mesh->device.malloc(mesh->Np*2*mesh->NERPoints*sizeof(dfloat));
     acoustics->o_ERintpolElements = mesh->device.malloc(2*mesh->NERPoints*sizeof(dlong));
@@ -622,7 +484,7 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
         o_ERComPointsAllRanks = 
               mesh->device.malloc(NERComPointsAllRanks*3*sizeof(dfloat),ERComPointsAllRanks);  
         occa::kernel ERFindElementsCom = 
-              mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+              kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
               "ERFindElementsCom",
               kernelInfo);
         ERFindElementsCom(NERComPointsAllRanks,o_recvCountsCum,o_recvCounts,mesh->rank,o_ERComPointsAllRanks,
@@ -732,7 +594,7 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
         occa::kernel ERmakeInterpolatorCom;
         ERmakeInterpolatorCom = 
-            mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+            kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
                   "ERmakeInterpolatorCom",
                   kernelInfo);
         if(NComPointsToSendAllRanks){
@@ -815,18 +677,20 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
    #endif
 
     dfloat *tempvt, *tempvi; 
-    dlong *tempanglei;
+    dfloat *tempERcos;
     tempvt = (dfloat*) calloc(mesh->NERPoints*4*3*3, sizeof(dfloat));
     tempvi = (dfloat*) calloc(mesh->NERPoints*3, sizeof(dfloat));
-    tempanglei = (dlong*) calloc(mesh->NERPoints, sizeof(dlong));
+    tempERcos = (dfloat*) calloc(mesh->NERPoints, sizeof(dfloat));
+    // [EA] Normal incidence until the first angle detection
+    for(dlong n=0;n<mesh->NERPoints;++n) tempERcos[n] = 1.0;
     
     acoustics->o_vt = mesh->device.malloc(mesh->NERPoints*4*3*3*sizeof(dfloat),tempvt);
     acoustics->o_vi = mesh->device.malloc(mesh->NERPoints*3*sizeof(dfloat),tempvi);
-    acoustics->o_anglei = mesh->device.malloc(mesh->NERPoints*sizeof(dlong),tempanglei);
+    acoustics->o_ERcos = mesh->device.malloc(mesh->NERPoints*sizeof(dfloat),tempERcos);
 
     free(tempvt);
     free(tempvi);
-    free(tempanglei);
+    free(tempERcos);
 
     // [EA] DEBUG: Print intpol
     #if 0
@@ -852,7 +716,7 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     acoustics->o_ERintpol = mesh->device.malloc(1*sizeof(dfloat));
     acoustics->o_vt = mesh->device.malloc(1*sizeof(dfloat));
     acoustics->o_vi = mesh->device.malloc(1*sizeof(dfloat));
-    acoustics->o_anglei = mesh->device.malloc(1*sizeof(dlong));
+    acoustics->o_ERcos = mesh->device.malloc(1*sizeof(dfloat));
   }
   
   // [EA] erk and esdirk to device
@@ -872,24 +736,24 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
   
   acoustics->acc = 
-    (dfloat*) calloc(acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1, sizeof(dfloat));
+    (dfloat*) calloc(acoustics->NLRAcc + acoustics->NERAcc + 1, sizeof(dfloat));
   acoustics->rhsacc = 
-    (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
+    (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
   acoustics->resacc = 
-    (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
+    (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
   acoustics->o_acc =
-    mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->acc);
+    mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->acc);
   acoustics->o_rhsacc =
-    mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->rhsacc);
+    mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->rhsacc);
   acoustics->o_resacc =
-    mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->resacc);
+    mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->resacc);
 
   if(!mesh->rank){
     cout << "TIME INTEGRATOR (" << newOptions.getArgs("TIME INTEGRATOR") << ")" << endl;
   }
   if (newOptions.compareArgs("TIME INTEGRATOR","LSERK4")){
     acoustics->o_resq =
-      mesh->device.malloc(mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), acoustics->resq);
+      acousticsFieldMalloc(acoustics, mesh->Nelements, acoustics->resq);
   }
 
   if (newOptions.compareArgs("TIME INTEGRATOR","DOPRI5")){
@@ -909,14 +773,14 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
   }
 
   if (newOptions.compareArgs("TIME INTEGRATOR","EIRK4") || newOptions.compareArgs("TIME INTEGRATOR","EIRK4Adap")){
-    acoustics->k1acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
-    acoustics->k2acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
-    acoustics->k3acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
-    acoustics->k4acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
-    acoustics->k5acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
-    acoustics->k6acc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
+    acoustics->k1acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
+    acoustics->k2acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
+    acoustics->k3acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
+    acoustics->k4acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
+    acoustics->k5acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
+    acoustics->k6acc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
 
-    acoustics->Xacc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1), sizeof(dfloat));
+    acoustics->Xacc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1), sizeof(dfloat));
 
     acoustics->k1rhsq = (dfloat*) calloc(mesh->Np*mesh->Nelements*mesh->Nfields, sizeof(dfloat));
     acoustics->k2rhsq = (dfloat*) calloc(mesh->Np*mesh->Nelements*mesh->Nfields, sizeof(dfloat));
@@ -928,20 +792,20 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     acoustics->resq = (dfloat*) calloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields, sizeof(dfloat));
 
     acoustics->o_k1acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k1acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k1acc);
     acoustics->o_k2acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k2acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k2acc);
     acoustics->o_k3acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k3acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k3acc);
     acoustics->o_k4acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k4acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k4acc);
     acoustics->o_k5acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k5acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k5acc);
     acoustics->o_k6acc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->k6acc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->k6acc);
 
     acoustics->o_Xacc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->resacc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->resacc);
 
     acoustics->o_k1rhsq = 
           mesh->device.malloc(mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), acoustics->k1rhsq);
@@ -966,10 +830,10 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     acoustics->rkerr = (dfloat*) calloc((mesh->totalHaloPairs+mesh->Nelements)*mesh->Np*mesh->Nfields,
 				sizeof(dfloat));
 
-    acoustics->rkAcc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1),
+    acoustics->rkAcc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1),
 				sizeof(dfloat));
 
-    acoustics->rkerrAcc = (dfloat*) calloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1),
+    acoustics->rkerrAcc = (dfloat*) calloc((acoustics->NLRAcc + acoustics->NERAcc + 1),
 				sizeof(dfloat));
 
     acoustics->o_rkq =
@@ -977,32 +841,13 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     acoustics->o_rkerr =
       mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), acoustics->rkerr);
     acoustics->o_rkAcc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->rkAcc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->rkAcc);
     acoustics->o_rkerrAcc = 
-          mesh->device.malloc((acoustics->LRInfo[0]*mesh->NLRPoints + acoustics->ERInfo[0]*mesh->NERPoints + 1)*sizeof(dfloat), acoustics->rkerrAcc);
+          mesh->device.malloc((acoustics->NLRAcc + acoustics->NERAcc + 1)*sizeof(dfloat), acoustics->rkerrAcc);
   }
   
-  if(mesh->totalHaloPairs>0){
-    // temporary DEVICE buffer for halo (maximum size Nfields*Np for dfloat)
-    mesh->o_haloBuffer =
-      mesh->device.malloc(mesh->totalHaloPairs*mesh->Np*mesh->Nfields*sizeof(dfloat));
-
-    // MPI send buffer
-    acoustics->haloBytes = mesh->totalHaloPairs*mesh->Np*acoustics->Nfields*sizeof(dfloat);
-
-    acoustics->o_haloBuffer = mesh->device.malloc(acoustics->haloBytes);
-
-#if 0
-    occa::memory o_sendBuffer = mesh->device.mappedAlloc(acoustics->haloBytes, NULL);
-    occa::memory o_recvBuffer = mesh->device.mappedAlloc(acoustics->haloBytes, NULL);
-
-    acoustics->sendBuffer = (dfloat*) o_sendBuffer.getMappedPointer();
-    acoustics->recvBuffer = (dfloat*) o_recvBuffer.getMappedPointer();
-#endif
-
-    acoustics->sendBuffer = (dfloat*) occaHostMallocPinned(mesh->device, acoustics->haloBytes, NULL, acoustics->o_sendBuffer);
-    acoustics->recvBuffer = (dfloat*) occaHostMallocPinned(mesh->device, acoustics->haloBytes, NULL, acoustics->o_recvBuffer);    
-  }
+  // halo exchange buffers (pinned HOST staging only when MPI cannot use DEVICE memory)
+  acoustics->halo = meshHaloDeviceSetup(mesh, mesh->Np*acoustics->Nfields, newOptions);
 
   if(mesh->Ncurv){
     mesh->o_vgeoCurv =
@@ -1013,6 +858,13 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
         mesh->device.malloc(mesh->Nelements*sizeof(dlong), mesh->mapCurv);
   }
 
+  // [EA] Compact face geometry for the affine tet surface kernel, the CPU kernels
+  // keep the full vmapM/vmapP and sgeo
+  acoustics->compactGeometry = newOptions.compareArgs("COMPACT GEOMETRY","TRUE")
+    && acoustics->elementType==TETRAHEDRA && !mesh->Ncurv && !acoustics->cpuMode;
+  if(acoustics->compactGeometry)
+    acousticsCompactGeometrySetup(acoustics, kernelInfo);
+
   //  p_RT, p_rbar, p_ubar, p_vbar
   // p_half, p_two, p_third, p_Nstresses
   
@@ -1047,28 +899,6 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
   //kernelInfo["defines/" "p_blockSize"]= blockSize; // [EA] Moved further up
 
-  // [EA] LR offset defines
-  kernelInfo["defines/" "p_LRA"]= 0;
-  kernelInfo["defines/" "p_LRB"]= acoustics->LRInfo[1];
-  kernelInfo["defines/" "p_LRC"]= acoustics->LRInfo[1] + acoustics->LRInfo[2];
-  kernelInfo["defines/" "p_LRLambda"]= acoustics->LRInfo[1] + 2*acoustics->LRInfo[2];
-  kernelInfo["defines/" "p_LRAlpha"]= 2*acoustics->LRInfo[1] + 2*acoustics->LRInfo[2];
-  kernelInfo["defines/" "p_LRBeta"]= 2*acoustics->LRInfo[1] + 3*acoustics->LRInfo[2];
-  kernelInfo["defines/" "p_LRYinf"]= 2*acoustics->LRInfo[1] + 4*acoustics->LRInfo[2];
-  
-  // [EA] ER offset defines
-  kernelInfo["defines/" "p_ERA"]= 0;
-  kernelInfo["defines/" "p_ERB"]= acoustics->ERInfo[1]*Nangles;
-  kernelInfo["defines/" "p_ERC"]= acoustics->ERInfo[1]*Nangles + acoustics->ERInfo[2]*Nangles;
-  kernelInfo["defines/" "p_ERLambda"]= acoustics->ERInfo[1]*Nangles + 2*acoustics->ERInfo[2]*Nangles;
-  kernelInfo["defines/" "p_ERAlpha"]= acoustics->ERInfo[1]+acoustics->ERInfo[1]*Nangles + 2*acoustics->ERInfo[2]*Nangles;
-  kernelInfo["defines/" "p_ERBeta"]= acoustics->ERInfo[1]+acoustics->ERInfo[1]*Nangles + acoustics->ERInfo[2]+2*acoustics->ERInfo[2]*Nangles;
-  kernelInfo["defines/" "p_ERYinf"]= acoustics->ERInfo[1]+acoustics->ERInfo[1]*Nangles + 2*acoustics->ERInfo[2]+2*acoustics->ERInfo[2]*Nangles;
-
-
-
-
-
   kernelInfo["parser/" "automate-add-barriers"] =  "disabled";
 
   // set kernel name suffix
@@ -1085,127 +915,138 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
+  // [EA] element-blocked CPU variants, currently for affine tets
+  const char *variant = (acoustics->cpuMode && acoustics->elementType==TETRAHEDRA) ? "_cpu" : "";
+
   // kernels from volume file
   sprintf(fileName, DACOUSTICS "/okl/acousticsVolume%s.okl", suffix);
-  sprintf(kernelName, "acousticsVolume%s", suffix);
+  sprintf(kernelName, "acousticsVolume%s%s", suffix, variant);
 
   //printf("fileName=[ %s ] \n", fileName);
   //printf("kernelName=[ %s ]\n", kernelName);
   
-  acoustics->volumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  acoustics->volumeKernel =  kernelBuild(acoustics->builder, fileName, kernelName, kernelInfo);
 
   // kernels from surface file
   sprintf(fileName, DACOUSTICS "/okl/acousticsSurface%s.okl", suffix);
-  sprintf(kernelName, "acousticsSurface%s", suffix);
+  sprintf(kernelName, "acousticsSurface%s%s", suffix,
+          acoustics->compactGeometry ? "_compact" : variant);
   
-  acoustics->surfaceKernel = mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  acoustics->surfaceKernel = kernelBuild(acoustics->builder, fileName, kernelName, kernelInfo);
 
   // kernels from update file
   acoustics->updateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsUpdate",
 				       kernelInfo);
 
-  // [EA] LR update kernel
-  acoustics->updateKernelLR = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
-				       "acousticsUpdateLRAcc",
+  acoustics->updateDFTKernel =
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
+				       "acousticsUpdateDFT",
 				       kernelInfo);
-  acoustics->updateKernelER = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
-				       "acousticsUpdateERAcc",
+  acoustics->dftKernel =
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
+				       "acousticsDFT",
 				       kernelInfo);
-  acoustics->acousticsUpdateEIRK4 = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
-				       "acousticsUpdateEIRK4",
+
+  acoustics->energyKernel =
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsEnergy.okl",
+				       "acousticsEnergy",
 				       kernelInfo);
-  acoustics->acousticsUpdateEIRK4AccLR = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
-				       "acousticsUpdateEIRK4AccLR",
+
+  // [EA] LR/ER accumulator update kernel
+  acoustics->updateKernelAcc = 
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
+				       "acousticsUpdateAcc",
 				       kernelInfo);
-  acoustics->acousticsUpdateEIRK4AccER = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
-				       "acousticsUpdateEIRK4AccER",
+  acoustics->acousticsUpdateEIRK4 = 
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
+				       "acousticsUpdateEIRK4",
 				       kernelInfo);
 
+  // [EA] Impedance and EIRK4 accumulator kernels per material pole signature
+  acousticsMaterialKernels(acoustics, newOptions, kernelInfo);
+
   acoustics->acousticsWSComInterpolation = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
 				       "acousticsWSComInterpolation",
 				       kernelInfo);
 
   acoustics->acousticsReceiverInterpolation = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsReceiverKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsReceiverKernel.okl",
 				       "acousticsReceiverInterpolation",
 				       kernelInfo);
   
   acoustics->ERInsertComVT = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
 				       "ERInsertComVT",
 				       kernelInfo);
   
   acoustics->rkUpdateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsRkUpdate",
 				       kernelInfo);
   acoustics->rkStageKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsRkStage",
 				       kernelInfo);
 
   acoustics->rkErrorEstimateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsErrorEstimate",
 				       kernelInfo);
 
   // [EA] Copy from q to qRecv (Currently not in use, changed to using copyTo instead)
   acoustics->receiverKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsReceiverKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsReceiverKernel.okl",
               "acousticsReceiverKernel",
               kernelInfo);
 
   acoustics->ERMoveVT = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
               "ERMoveVT",
               kernelInfo);
 
 
   // [EA] Detect angle of incoming wave for Extended Reaction boundary condition
   acoustics->ERangleDetection =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsERKernel.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsERKernel.okl",
                 "ERangleDetection",
                 kernelInfo);
   
   acoustics->acousticsErrorEIRK4 = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
                 "acousticsErrorEIRK4",
                 kernelInfo);
 
   acoustics->acousticsErrorEIRK4r = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
                 "acousticsErrorEIRK4r",
                 kernelInfo);
 
   acoustics->acousticsErrorEIRK4Acc = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
                 "acousticsErrorEIRK4Acc",
                 kernelInfo);
 
   acoustics->acousticsErrorEIRK4Accr = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+    kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsUpdate.okl",
                 "acousticsErrorEIRK4Accr",
                 kernelInfo);
 
-  acoustics->volumeKernelCurv = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsVolumeTet3D.okl",
-                "acousticsVolumeTet3DCurv",
-                kernelInfo);
-  acoustics->surfaceKernelCurv = 
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsSurfaceTet3D.okl",
-                "acousticsSurfaceTet3DCurv",
-                kernelInfo);
+  if(acoustics->elementType==TETRAHEDRA){
+    acoustics->volumeKernelCurv = 
+      kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsVolumeTet3D.okl",
+                  "acousticsVolumeTet3DCurv",
+                  kernelInfo);
+    acoustics->surfaceKernelCurv = 
+      kernelBuild(acoustics->builder, DACOUSTICS "/okl/acousticsSurfaceTet3D.okl",
+                  "acousticsSurfaceTet3DCurv",
+                  kernelInfo);
+  }
   // fix this later
   mesh->haloExtractKernel =
-    mesh->device.buildKernel(DHOLMES "/okl/meshHaloExtract3D.okl",
+    kernelBuild(acoustics->builder, DHOLMES "/okl/meshHaloExtract3D.okl",
 				       "meshHaloExtract3D",
 				       kernelInfo);
 
@@ -1224,6 +1065,8 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     newOptions.getArgs("LRVECTFIT", LRFile);
     string ERFile;
     newOptions.getArgs("ERVECTFIT", ERFile);
+    string materialsFile;
+    newOptions.getArgs("MATERIALS", materialsFile);
     printf("-----SETUP PARAMETERS START-----\n");
     printf("N = %d\n",mesh->N);
     printf("Mesh file: %s\n",(char*)mshFileName.c_str());
@@ -1231,36 +1074,40 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
     printf("CFL = %g\n",cfl);
     printf("dt = %g\n",mesh->dt);
     printf("Time integrator: %s\n",(char*)timeInt.c_str());
+    if(acoustics->cpuMode)
+      printf("CPU mode: %s, %d elements per block\n", mesh->device.mode().c_str(), acoustics->NblockCPU);
+    if(acoustics->compactGeometry)
+      printf("Compact geometry: %d face rotations\n", acoustics->NfaceRot);
     printf("Receiver file: %s\n",(char*)recvFile.c_str());
     printf("Local Reaction file: %s\n",(char*)LRFile.c_str());
     printf("Extended Reaction file: %s\n",(char*)ERFile.c_str());
+    printf("Materials file: %s\n",(char*)materialsFile.c_str());
     printf("BCCHANGETIME = %g\n",acoustics->BCChangeTime);
     printf("Boundary conditions on surface indices from .msh file:\n");
     printf("Rigid = [ ");
-    for(int jj = 1; jj < 1000; jj+=2){ // Hardcoded for 500 surfaces, see meshParallelReaderTet3D.c
-      if(1 == mesh->mshPrint[jj]){
-        printf("%d ",mesh->mshPrint[jj-1]);
+    for(hlong jj = 0; jj < mesh->NmshPrint; jj++){
+      if(1 == mesh->mshPrint[2*jj+1]){
+        printf("%d ",mesh->mshPrint[2*jj]);
       }
     }
     printf("]\nFrequency Independent = [ ");
-    for(int jj = 1; jj < 1000; jj+=2){ // Hardcoded for 500 surfaces, see meshParallelReaderTet3D.c
-      if(2 == mesh->mshPrint[jj]){
-        printf("%d ",mesh->mshPrint[jj-1]);
+    for(hlong jj = 0; jj < mesh->NmshPrint; jj++){
+      if(2 == mesh->mshPrint[2*jj+1]){
+        printf("%d ",mesh->mshPrint[2*jj]);
       }
     }
-    printf("]\nLocal Reaction = [ ");
-    for(int jj = 1; jj < 1000; jj+=2){ // Hardcoded for 500 surfaces, see meshParallelReaderTet3D.c
-      if(3 == mesh->mshPrint[jj]){
-        printf("%d ",mesh->mshPrint[jj-1]);
-      }
-    }
-    printf("]\nExtended Reaction = [ ");
-    for(int jj = 1; jj < 1000; jj+=2){ // Hardcoded for 500 surfaces, see meshParallelReaderTet3D.c
-      if(4 == mesh->mshPrint[jj]){
-        printf("%d ",mesh->mshPrint[jj-1]);
+    printf("]\n");
+    for(int m = 0; m < acoustics->Nmaterials; m++){
+      acousticsMaterial_t *mat = acoustics->materials+m;
+      printf("%s material %d (physical %d, %d poles) = [ ",
+             (mat->type==3) ? "Local Reaction":"Extended Reaction", m, mat->physicalId, mat->Npoles);
+      for(hlong jj = 0; jj < mesh->NmshPrint; jj++){
+        if(mat->physicalId == mesh->mshPrint[2*jj+1]){
+          printf("%d ",mesh->mshPrint[2*jj]);
+        }
       }
+      printf("]\n");
     }
-  printf("]\n");
   printf("-----SETUP PARAMETERS END-----\n");
   }
   free(mesh->mshPrint);  
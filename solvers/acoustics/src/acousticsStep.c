@@ -30,6 +30,7 @@ SOFTWARE.
 
 void acousticsVolumeKernel(acoustics_t *acoustics, occa::memory qPtr, occa::memory rhsqPtr){
   mesh_t *mesh = acoustics->mesh;
+  kernelProfileStart(acoustics->profile);
   if(!mesh->Ncurv){
     acoustics->volumeKernel(mesh->Nelements, 
           mesh->o_vgeo, 
@@ -45,12 +46,33 @@ void acousticsVolumeKernel(acoustics_t *acoustics, occa::memory qPtr, occa::memo
         qPtr,
         rhsqPtr);
   }
+  kernelProfileStop(acoustics->profile, acoustics->profVolume);
 }
 
 void acousticsSurfaceKernel(acoustics_t *acoustics, occa::memory qPtr, occa::memory rhsqPtr,
-                      occa::memory accPtr, occa::memory rhsaccPtr, const dfloat currentTime){
+                      const dfloat currentTime){
   mesh_t *mesh = acoustics->mesh;
-  if(!mesh->Ncurv){
+  kernelProfileStart(acoustics->profile);
+  if(acoustics->compactGeometry){
+      acoustics->surfaceKernel(mesh->Nelements,
+           acoustics->NfaceRot,
+           acoustics->o_faceNormals,
+           acoustics->o_faceScale,
+           mesh->o_LIFTT,
+           acoustics->o_faceNodes,
+           acoustics->o_EToEP,
+           acoustics->o_faceCode,
+           acoustics->o_faceRot,
+           mesh->o_EToB,
+           currentTime,
+           mesh->o_x,
+           mesh->o_y,
+           mesh->o_z,
+           qPtr,
+           rhsqPtr,
+           mesh->o_mapAcc,
+           acoustics->o_vnAcc);
+  } else if(!mesh->Ncurv){
       acoustics->surfaceKernel(mesh->Nelements, 
 		       mesh->o_sgeo, 
 		       mesh->o_LIFTT, 
@@ -63,15 +85,8 @@ void acousticsSurfaceKernel(acoustics_t *acoustics, occa::memory qPtr, occa::mem
 		       mesh->o_z, 
 		       qPtr, 
 		       rhsqPtr,
-           accPtr,
-           rhsaccPtr,
            mesh->o_mapAcc,
-           acoustics->o_LR,
-           acoustics->o_LRInfo,
-           mesh->NLRPoints,
-           acoustics->o_anglei,
-           acoustics->o_ER,
-           acoustics->o_ERInfo);
+           acoustics->o_vnAcc);
     } else {
       acoustics->surfaceKernelCurv(mesh->Nelements, 
 		       mesh->o_sgeo, 
@@ -87,16 +102,15 @@ void acousticsSurfaceKernel(acoustics_t *acoustics, occa::memory qPtr, occa::mem
 		       mesh->o_z, 
 		       qPtr, 
 		       rhsqPtr,
-           accPtr,
-           rhsaccPtr,
            mesh->o_mapAcc,
-           acoustics->o_LR,
-           acoustics->o_LRInfo,
-           mesh->NLRPoints,
-           acoustics->o_anglei,
-           acoustics->o_ER,
-           acoustics->o_ERInfo);
+           acoustics->o_vnAcc);
     }
+  kernelProfileStop(acoustics->profile, acoustics->profSurface);
+}
+
+// The running DFT samples q every dftEvery steps
+static int acousticsDFTStep(acoustics_t *acoustics){
+  return acoustics->NdftFreqs && (acoustics->dftCounter % acoustics->dftEvery == 0);
 }
 
 void acousticsDopriStep(acoustics_t *acoustics, setupAide &newOptions, const dfloat time){
@@ -122,17 +136,8 @@ void acousticsDopriStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
     //compute RHS
     // rhsq = F(currentTIme, rkq)
 
-    // extract q halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*acoustics->Nfields;          
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, acoustics->o_rkq, acoustics->o_haloBuffer);
-      
-      // copy extracted halo to HOST 
-      acoustics->o_haloBuffer.copyTo(acoustics->sendBuffer);      
-      
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*acoustics->Nfields*sizeof(dfloat), acoustics->sendBuffer, acoustics->recvBuffer);
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, acoustics->halo, acoustics->o_rkq);
 
     acoustics->volumeKernel(mesh->Nelements, 
 		      mesh->o_vgeo, 
@@ -141,13 +146,7 @@ void acousticsDopriStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
 		      acoustics->o_rhsq);
 
     // wait for q halo data to arrive
-    if(mesh->totalHaloPairs>0){
-      meshHaloExchangeFinish(mesh);
-          
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*acoustics->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      acoustics->o_rkq.copyFrom(acoustics->recvBuffer, acoustics->haloBytes, offset);
-    }
+    meshHaloExchangeDeviceFinish(mesh, acoustics->halo);
 
     acoustics->surfaceKernel(mesh->Nelements, 
 			     mesh->o_sgeo, 
@@ -212,6 +211,7 @@ void acousticsLserkStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
 													mesh->rank);
       }
     }
+    kernelProfileStart(acoustics->profile);
     acoustics->ERangleDetection(mesh->NERPoints,
 														 mesh->NLRPoints,
 														 acoustics->o_vt,
@@ -220,11 +220,13 @@ void acousticsLserkStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
 														 acoustics->o_q,
 														 mesh->o_sgeo,
 														 acoustics->o_ERintpol,
-														 acoustics->o_anglei,
+														 acoustics->o_ERcos,
 														 mesh->o_mapAccToQ,
 														 mesh->o_mapAccToN,
 														 mesh->dt,
+														 acoustics->ERdx,
                              mesh->rank);
+    kernelProfileStop(acoustics->profile, acoustics->profAngleDetection);
 
 
     // Move vt time steps
@@ -235,89 +237,82 @@ void acousticsLserkStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
   for(int rk=0;rk<mesh->Nrk;++rk){
     dfloat currentTime = time + mesh->rkc[rk]*mesh->dt;
       
-    // extract q halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*acoustics->Nfields;
-        
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, acoustics->o_q, acoustics->o_haloBuffer);
-        
-      // copy extracted halo to HOST 
-      acoustics->o_haloBuffer.copyTo(acoustics->sendBuffer);      
-        
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*acoustics->Nfields*sizeof(dfloat), acoustics->sendBuffer, acoustics->recvBuffer);
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, acoustics->halo, acoustics->o_q);
 
     acousticsVolumeKernel(acoustics, acoustics->o_q, acoustics->o_rhsq);
 
+    // impedance boundaries only need local traces, overlap them with the halo exchange
+    acousticsImpedance(acoustics, acoustics->o_q, acoustics->o_acc, acoustics->o_rhsacc);
+
     // wait for q halo data to arrive
-    if(mesh->totalHaloPairs>0){
-      meshHaloExchangeFinish(mesh);
-      
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*acoustics->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      acoustics->o_q.copyFrom(acoustics->recvBuffer, acoustics->haloBytes, offset);
-    }
+    meshHaloExchangeDeviceFinish(mesh, acoustics->halo);
 
-    acousticsSurfaceKernel(acoustics, acoustics->o_q, acoustics->o_rhsq,
-                      acoustics->o_acc, acoustics->o_rhsacc, currentTime);
+    acousticsSurfaceKernel(acoustics, acoustics->o_q, acoustics->o_rhsq, currentTime);
     
     // update solution using Runge-Kutta
-    acoustics->updateKernel(mesh->Nelements, 
+    kernelProfileStart(acoustics->profile);
+    if(rk==mesh->Nrk-1 && acousticsDFTStep(acoustics)){
+      // last stage: accumulate the running DFT of q(time+dt) in the same pass
+      acoustics->updateDFTKernel(mesh->Nelements, 
+		      mesh->dt, 
+		      mesh->rka[rk], 
+		      mesh->rkb[rk], 
+		      acoustics->o_rhsq, 
+		      acoustics->o_resq, 
+		      acoustics->o_q,
+		      acoustics->NdftFreqs,
+		      acoustics->o_dftFreqs,
+		      acoustics->dftEvery*mesh->dt,
+		      time+mesh->dt,
+		      acoustics->o_qDFT);
+      kernelProfileStop(acoustics->profile, acoustics->profUpdateDFT);
+    } else {
+      acoustics->updateKernel(mesh->Nelements, 
 		      mesh->dt, 
 		      mesh->rka[rk], 
 		      mesh->rkb[rk], 
 		      acoustics->o_rhsq, 
 		      acoustics->o_resq, 
 		      acoustics->o_q);
+      kernelProfileStop(acoustics->profile, acoustics->profUpdate);
+    }
 
-    if(mesh->NLRPoints){
-      acoustics->updateKernelLR(mesh->NLRPoints,
-            acoustics->LRInfo[0],
+    if(acoustics->NLRAcc + acoustics->NERAcc){
+      kernelProfileStart(acoustics->profile);
+      acoustics->updateKernelAcc(acoustics->NLRAcc + acoustics->NERAcc,
             mesh->dt,  
             mesh->rka[rk],
             mesh->rkb[rk],
             acoustics->o_rhsacc,
             acoustics->o_resacc,
             acoustics->o_acc);
-    }
-    if(mesh->NERPoints){
-      acoustics->updateKernelER(mesh->NERPoints,
-            acoustics->ERInfo[0],
-            mesh->dt,  
-            mesh->rka[rk],
-            mesh->rkb[rk],
-            acoustics->o_rhsacc,
-            acoustics->o_resacc,
-            acoustics->o_acc,
-            acoustics->LRInfo[0]*mesh->NLRPoints);
+      kernelProfileStop(acoustics->profile, acoustics->profUpdateAcc);
     }
   }
 
   
   //---------RECEIVER---------
   if(acoustics->NReceiversLocal){
-    acoustics->acousticsReceiverInterpolation(acoustics->NReceiversLocal,
-                                      acoustics->o_qRecv,
-                                      acoustics->o_recvElements,
-                                      acoustics->o_recvElementsIdx,
+    kernelProfileStart(acoustics->profile);
+    acoustics->acousticsReceiverInterpolation(acoustics->NrecvGroups,
+                                      acoustics->o_recvGroupStarts,
+                                      acoustics->o_recvGroupElements,
                                       acoustics->o_recvintpol,
                                       acoustics->o_q,
+                                      acoustics->o_qRecv,
                                       acoustics->qRecvCounter);
+    kernelProfileStop(acoustics->profile, acoustics->profReceiver);
     acoustics->qRecvCounter++;
     if(acoustics->qRecvCounter == recvCopyRate){
-      for(int iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
-        dlong offset = recvCopyRate*acoustics->qRecvCopyCounter + mesh->NtimeSteps*iRecv;
-
-        acoustics->o_qRecv.copyTo(acoustics->qRecv+offset,
-              acoustics->qRecvCounter*sizeof(dfloat), 
-              recvCopyRate*iRecv*sizeof(dfloat));  
-      }
+      acousticsRecvCopyToHost(acoustics);
       acoustics->qRecvCounter = 0;
       acoustics->qRecvCopyCounter++;  
     }
   }
   //---------RECEIVER---------
+
+  if(acoustics->NdftFreqs) acoustics->dftCounter++;
   }
 
 void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dfloat time){
@@ -352,6 +347,7 @@ void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dflo
     }
 
     if(mesh->NERPoints){
+      kernelProfileStart(acoustics->profile);
       acoustics->ERangleDetection(mesh->NERPoints,
                                 mesh->NLRPoints,
                                 acoustics->o_vt,
@@ -360,11 +356,13 @@ void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dflo
                                 acoustics->o_q,
                                 mesh->o_sgeo,
                                 acoustics->o_ERintpol,
-                                acoustics->o_anglei,
+                                acoustics->o_ERcos,
                                 mesh->o_mapAccToQ,
                                 mesh->o_mapAccToN,
                                 mesh->dt,
+                                acoustics->ERdx,
                                 mesh->rank);
+      kernelProfileStop(acoustics->profile, acoustics->profAngleDetection);
 
 
       // Move vt time steps
@@ -418,30 +416,18 @@ void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dflo
         break;
     }
     
-    // extract q halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*acoustics->Nfields;
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, qPtr, acoustics->o_haloBuffer);
-        
-      // copy extracted halo to HOST 
-      acoustics->o_haloBuffer.copyTo(acoustics->sendBuffer);      
-        
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*acoustics->Nfields*sizeof(dfloat), acoustics->sendBuffer, acoustics->recvBuffer);
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, acoustics->halo, qPtr);
 
     acousticsVolumeKernel(acoustics, qPtr, rhsqPtr);
 
-    if(mesh->totalHaloPairs>0){
-      meshHaloExchangeFinish(mesh);
-        
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*acoustics->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      qPtr.copyFrom(acoustics->recvBuffer, acoustics->haloBytes, offset);
-    }
+    acousticsImpedance(acoustics, qPtr, accPtr, rhsaccPtr);
+
+    meshHaloExchangeDeviceFinish(mesh, acoustics->halo);
     
-    acousticsSurfaceKernel(acoustics, qPtr, rhsqPtr, accPtr, rhsaccPtr, currentTime);
+    acousticsSurfaceKernel(acoustics, qPtr, rhsqPtr, currentTime);
 
+    kernelProfileStart(acoustics->profile);
     acoustics->acousticsUpdateEIRK4(mesh->Nelements,
             mesh->dt,  
             mesh->o_erka,
@@ -455,69 +441,41 @@ void acousticsEirkStep(acoustics_t *acoustics, setupAide &newOptions, const dflo
             acoustics->o_resq,
             acoustics->o_q,
             s+1);
+    kernelProfileStop(acoustics->profile, acoustics->profUpdateEIRK4);
 
-    if(mesh->NLRPoints){
-    acoustics->acousticsUpdateEIRK4AccLR(mesh->NLRPoints,
-            mesh->dt,  
-            mesh->o_esdirka,
-            mesh->o_esdirkb,
-            mesh->o_mapAccToQ,
-            acoustics->o_LR,
-            acoustics->o_LRInfo,
-            acoustics->o_k1acc,
-            acoustics->o_k2acc,
-            acoustics->o_k3acc,
-            acoustics->o_k4acc,
-            acoustics->o_k5acc,
-            acoustics->o_k6acc,
-            acoustics->o_resq,
-            acoustics->o_acc,
-            acoustics->o_Xacc,
-            s+1);
+    // accumulators, one batch per material
+    acousticsUpdateEIRK4Acc(acoustics, s+1);
+  }
 
-    }
-    if(mesh->NERPoints){
-      acoustics->acousticsUpdateEIRK4AccER(mesh->NERPoints,
-            mesh->NLRPoints,
-            acoustics->LRInfo[0],
-            mesh->dt,  
-            mesh->o_esdirka,
-            mesh->o_esdirkb,
-            mesh->o_mapAccToQ,
-            acoustics->o_ER,
-            acoustics->o_ERInfo,
-            acoustics->o_k1acc,
-            acoustics->o_k2acc,
-            acoustics->o_k3acc,
-            acoustics->o_k4acc,
-            acoustics->o_k5acc,
-            acoustics->o_k6acc,
-            acoustics->o_resq,
-            acoustics->o_acc,
-            acoustics->o_Xacc,
-            s+1);
-    }
+  // running DFT of q(time+dt)
+  if(acousticsDFTStep(acoustics)){
+    kernelProfileStart(acoustics->profile);
+    acoustics->dftKernel(mesh->Nelements,
+            acoustics->o_q,
+            acoustics->NdftFreqs,
+            acoustics->o_dftFreqs,
+            acoustics->dftEvery*mesh->dt,
+            time+mesh->dt,
+            acoustics->o_qDFT);
+    kernelProfileStop(acoustics->profile, acoustics->profDFT);
   }
+  if(acoustics->NdftFreqs) acoustics->dftCounter++;
   
   //---------RECEIVER---------
   if(acoustics->NReceiversLocal){
-    acoustics->acousticsReceiverInterpolation(acoustics->NReceiversLocal,
-                                      acoustics->o_qRecv,
-                                      acoustics->o_recvElements,
-                                      acoustics->o_recvElementsIdx,
+    kernelProfileStart(acoustics->profile);
+    acoustics->acousticsReceiverInterpolation(acoustics->NrecvGroups,
+                                      acoustics->o_recvGroupStarts,
+                                      acoustics->o_recvGroupElements,
                                       acoustics->o_recvintpol,
                                       acoustics->o_q,
+                                      acoustics->o_qRecv,
                                       acoustics->qRecvCounter);
+    kernelProfileStop(acoustics->profile, acoustics->profReceiver);
 
     acoustics->qRecvCounter++;
     if(acoustics->qRecvCounter == recvCopyRate){
-      for(int iRecv = 0; iRecv < acoustics->NReceiversLocal; iRecv++){
-        dlong offset = recvCopyRate*acoustics->qRecvCopyCounter + mesh->NtimeSteps*iRecv;
-
-        acoustics->o_qRecv.copyTo(acoustics->qRecv+offset,
-              acoustics->qRecvCounter*sizeof(dfloat), 
-              recvCopyRate*iRecv*sizeof(dfloat));  
-      }
+      acousticsRecvCopyToHost(acoustics);
       acoustics->qRecvCounter = 0;
       acoustics->qRecvCopyCounter++;  
     } 
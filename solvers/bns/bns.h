@@ -177,6 +177,9 @@ typedef struct{
   occa::memory o_sendBufferPinned;
   occa::memory o_recvBufferPinned;
 
+  // whole element halo exchange (LSERK and SARK)
+  meshHalo_t *halo;
+
 
 
   dfloat *fQM; 
@@ -274,14 +277,12 @@ void bnsSAADRKCoefficients(bns_t *bns, setupAide &options);
 void bnsMRSAABStep(bns_t *bns, int tstep, int haloBytes,
 		   dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options);
 
-void bnsLSERKStep(bns_t *bns, int tstep, int haloBytes,
-		  dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options);
+// LSERK and SARK exchange halos through bns->halo
+void bnsLSERKStep(bns_t *bns, int tstep, setupAide &options);
 
-void bnsSARKStep(bns_t *bns, dfloat time, int haloBytes,
-		 dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options);
+void bnsSARKStep(bns_t *bns, dfloat time, setupAide &options);
 
-void bnsRunEmbedded(bns_t *bns, int haloBytes, dfloat * sendBuffer,
-		    dfloat *recvBuffer, setupAide &options);
+void bnsRunEmbedded(bns_t *bns, setupAide &options);
 
 // Welding Tris
 
@@ -26,11 +26,8 @@
 
 #include "bns.h"
 
-#define BNS_ANSYC 0
-
 // complete a time step using LSERK4
-void bnsLSERKStep(bns_t *bns, int tstep, int haloBytes,
-		  dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options){
+void bnsLSERKStep(bns_t *bns, int tstep, setupAide &options){
 
 
   const dlong offset    = 0.0;
@@ -45,34 +42,8 @@ void bnsLSERKStep(bns_t *bns, int tstep, int haloBytes,
     // intermediate stage time
     dfloat t = bns->startTime + tstep*bns->dt + bns->dt*mesh->rkc[rk];
 
-    if(mesh->totalHaloPairs>0){
-#if BNS_ASYNC 
-      mesh->device.setStream(dataStream);
-
-      int Nentries = mesh->Np*bns->Nfields;
-      mesh->haloExtractKernel(mesh->totalHaloPairs,
-			      Nentries,
-			      mesh->o_haloElementList,
-			      bns->o_q,
-			      mesh->o_haloBuffer);
-
-      // copy extracted halo to HOST
-      mesh->o_haloBuffer.copyTo(sendBuffer,"async: true");
-      mesh->device.setStream(defaultStream);
-
-#else
-      int Nentries = mesh->Np*bns->Nfields;
-      mesh->haloExtractKernel(mesh->totalHaloPairs,
-			      Nentries,
-			      mesh->o_haloElementList,
-			      bns->o_q,
-			      mesh->o_haloBuffer);
-      // copy extracted halo to HOST
-      mesh->o_haloBuffer.copyTo(sendBuffer);
-      // start halo exchange
-      meshHaloExchangeStart(mesh, bns->Nfields*mesh->Np*sizeof(dfloat), sendBuffer, recvBuffer);
-#endif
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, bns->halo, bns->o_q);
 
     // COMPUTE RAMP FUNCTION 
     dfloat fx, fy, fz, intfx, intfy, intfz;
@@ -212,33 +183,8 @@ void bnsLSERKStep(bns_t *bns, int tstep, int haloBytes,
     // VOLUME KERNELS
     occaTimerToc(mesh->device, "RelaxationKernel");
 #endif
-    if(mesh->totalHaloPairs>0){
-
-#if BNS_ASYNC 
-      mesh->device.setStream(dataStream);
-
-      //make sure the async copy is finished
-      mesh->device.finish();
-      // start halo exchange
-      meshHaloExchangeStart(mesh,
-			    bns->Nfields*mesh->Np*sizeof(dfloat),
-			    sendBuffer,
-			    recvBuffer);
-      // wait for halo data to arrive
-      meshHaloExchangeFinish(mesh);
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      bns->o_q.copyFrom(recvBuffer, haloBytes, offset,"async: true");
-      mesh->device.finish();
-
-      mesh->device.setStream(defaultStream);
-#else
-      meshHaloExchangeFinish(mesh);
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      bns->o_q.copyFrom(recvBuffer, haloBytes, offset);
-#endif
-    }
+    // wait for q halo data to arrive
+    meshHaloExchangeDeviceFinish(mesh, bns->halo);
 
 
 
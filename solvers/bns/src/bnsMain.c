@@ -81,6 +81,8 @@ int main(int argc, char **argv){
 
    bnsPlotVTU(bns, "foo.vtu");
    bnsRun(bns,options);
+
+   if(bns->halo) meshHaloDeviceFree(bns->halo);
    
   // close down MPI
   MPI_Finalize();
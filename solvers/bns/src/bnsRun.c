@@ -30,15 +30,13 @@ void bnsRun(bns_t *bns, setupAide &options){
 
   mesh_t  *mesh = bns->mesh; 
 
-  // MPI send buffer
+  // MPI send buffer for the MRSAAB trace exchange
   dfloat *sendBuffer;
   dfloat *recvBuffer;
-  int haloBytes;
+  int haloBytes = 0;
 
   if(options.compareArgs("TIME INTEGRATOR","MRSAAB"))
     haloBytes = mesh->totalHaloPairs*mesh->Nfp*bns->Nfields*mesh->Nfaces*sizeof(dfloat);
-  else
-    haloBytes = mesh->totalHaloPairs*mesh->Np*bns->Nfields*sizeof(dfloat);
 
   if (haloBytes) {
 #if 0
@@ -52,6 +50,10 @@ void bnsRun(bns_t *bns, setupAide &options){
     recvBuffer = (dfloat*) occaHostMallocPinned(mesh->device, haloBytes, NULL, bns->o_recvBufferPinned);
   }
 
+  // LSERK and SARK exchange whole elements through the mesh halo engine
+  if(!options.compareArgs("TIME INTEGRATOR","MRSAAB"))
+    bns->halo = meshHaloDeviceSetup(mesh, mesh->Np*bns->Nfields, options);
+
   if(options.compareArgs("TIME INTEGRATOR","MRSAAB")){
     printf("Populating trace values\n");
     // Populate Trace Buffer
@@ -157,7 +159,7 @@ void bnsRun(bns_t *bns, setupAide &options){
 
       if(options.compareArgs("TIME INTEGRATOR","LSERK")){
         occaTimerTic(mesh->device, "LSERK");  
-        bnsLSERKStep(bns, tstep, haloBytes, sendBuffer, recvBuffer, options);
+        bnsLSERKStep(bns, tstep, options);
         occaTimerToc(mesh->device, "LSERK");
 
 #if 0
@@ -185,7 +187,7 @@ void bnsRun(bns_t *bns, setupAide &options){
       if(options.compareArgs("TIME INTEGRATOR","SARK")){
         occaTimerTic(mesh->device, "SARK");
         dfloat time = tstep*bns->dt;  
-        bnsSARKStep(bns, time, haloBytes, sendBuffer, recvBuffer, options);
+        bnsSARKStep(bns, time, options);
         bns->o_q.copyFrom(bns->o_rkq);
         if(mesh->pmlNelements){
           bns->o_pmlqx.copyFrom(bns->o_rkqx);
@@ -203,7 +205,7 @@ void bnsRun(bns_t *bns, setupAide &options){
   }else if( options.compareArgs("TIME INTEGRATOR", "SARK")){
 
     occaTimerTic(mesh->device, "SARK_TOTAL");
-    bnsRunEmbedded(bns, haloBytes, sendBuffer, recvBuffer, options);
+    bnsRunEmbedded(bns, options);
     occaTimerToc(mesh->device, "SARK_TOTAL");
 
   }else{
@@ -26,8 +26,7 @@ SOFTWARE.
 
 #include "bns.h"
 
-void bnsRunEmbedded(bns_t *bns, int haloBytes, dfloat * sendBuffer,
-		    dfloat *recvBuffer, setupAide &options){
+void bnsRunEmbedded(bns_t *bns, setupAide &options){
 
   mesh_t *mesh = bns->mesh;
 
@@ -92,7 +91,7 @@ void bnsRunEmbedded(bns_t *bns, int haloBytes, dfloat * sendBuffer,
     }
 
     occaTimerTic(mesh->device, "SARK_STEP"); 
-    bnsSARKStep(bns, bns->time, haloBytes, sendBuffer, recvBuffer, options);
+    bnsSARKStep(bns, bns->time, options);
     occaTimerToc(mesh->device, "SARK_STEP"); 
     
     
@@ -159,7 +158,7 @@ void bnsRunEmbedded(bns_t *bns, int haloBytes, dfloat * sendBuffer,
           bnsSAADRKCoefficients(bns, options);
 
           // if(options.compareArgs("TIME INTEGRATOR","SARK"))  // SA Adaptive RK 
-          bnsSARKStep(bns, bns->time, haloBytes, sendBuffer, recvBuffer, options);
+          bnsSARKStep(bns, bns->time, options);
           // shift for output
           bns->o_rkq.copyTo(bns->o_q);
           // output  (print from rkq)
@@ -26,11 +26,8 @@
 
 #include "bns.h"
 
-#define BNS_ANSYC 0
-
 // complete a time step using LSERK4
-void bnsSARKStep(bns_t *bns, dfloat time, int haloBytes,
-		 dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options){
+void bnsSARKStep(bns_t *bns, dfloat time, setupAide &options){
 
 
   // bns->shiftIndex = 0; 
@@ -94,34 +91,8 @@ void bnsSARKStep(bns_t *bns, dfloat time, int haloBytes,
 
     occaTimerToc(mesh->device, "RKStageKernel");  
 
-    if(mesh->totalHaloPairs>0){
-#if BNS_ASYNC 
-      mesh->device.setStream(dataStream);
-
-      int Nentries = mesh->Np*bns->Nfields;
-      mesh->haloExtractKernel(mesh->totalHaloPairs,
-			      Nentries,
-			      mesh->o_haloElementList,
-			      bns->o_rkq,
-			      mesh->o_haloBuffer);
-
-      // copy extracted halo to HOST
-      mesh->o_haloBuffer.copyTo(sendBuffer,"async: true");
-      mesh->device.setStream(defaultStream);
-
-#else
-      int Nentries = mesh->Np*bns->Nfields;
-      mesh->haloExtractKernel(mesh->totalHaloPairs,
-			      Nentries,
-			      mesh->o_haloElementList,
-			      bns->o_rkq,
-			      mesh->o_haloBuffer);
-      // copy extracted halo to HOST
-      mesh->o_haloBuffer.copyTo(sendBuffer);
-      // start halo exchange
-      meshHaloExchangeStart(mesh, bns->Nfields*mesh->Np*sizeof(dfloat), sendBuffer, recvBuffer);
-#endif
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, bns->halo, bns->o_rkq);
     
     // dfloat ramp = 1.0, drampdt = 0.0; 
     // COMPUTE RAMP FUNCTION 
@@ -264,34 +235,8 @@ void bnsSARKStep(bns_t *bns, dfloat time, int haloBytes,
     occaTimerToc(mesh->device, "RelaxationKernel");
 #endif
     
-    if(mesh->totalHaloPairs>0){
-    
-#if BNS_ASYNC 
-      mesh->device.setStream(dataStream);
-
-      //make sure the async copy is finished
-      mesh->device.finish();
-      // start halo exchange
-      meshHaloExchangeStart(mesh,
-			    bns->Nfields*mesh->Np*sizeof(dfloat),
-			    sendBuffer,
-			    recvBuffer);
-      // wait for halo data to arrive
-      meshHaloExchangeFinish(mesh);
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      bns->o_rkq.copyFrom(recvBuffer, haloBytes, offset,"async: true");
-      mesh->device.finish();
-
-      mesh->device.setStream(defaultStream);
-#else
-      meshHaloExchangeFinish(mesh);
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      bns->o_rkq.copyFrom(recvBuffer, haloBytes, offset);
-#endif
-
-    }
+    // wait for q halo data to arrive
+    meshHaloExchangeDeviceFinish(mesh, bns->halo);
 
 
 
@@ -98,19 +98,18 @@ typedef struct{
 
   
   //halo data
-  dlong haloBytes;
-  dfloat *sendBuffer;
-  dfloat *recvBuffer;
-  occa::memory o_sendBuffer;
-  occa::memory o_recvBuffer;
-  occa::memory o_haloBuffer;
-
-  dlong haloStressesBytes;
-  dfloat *sendStressesBuffer;
-  dfloat *recvStressesBuffer;
-  occa::memory o_sendStressesBuffer;
-  occa::memory o_recvStressesBuffer;
-  occa::memory o_haloStressesBuffer;
+  meshHalo_t *halo;
+  meshHalo_t *stressesHalo;
+
+  // with an extended halo of q the stresses of halo elements are computed
+  // locally, so each stage needs a single halo exchange
+  int extendedHalo;
+  meshHaloExtension_t *haloExtension;
+  dlong NqElements; // local, halo and extra halo elements held in q
+  size_t haloVgeoOffset;
+  occa::memory o_extVgeo, o_extSgeo;
+  occa::memory o_extVmapM, o_extVmapP, o_extEToB;
+  occa::memory o_extX, o_extY, o_extZ;
 
   // DOPRI5 RK data
   int advSwitch;
@@ -154,6 +153,8 @@ void cnsBodyForce(dfloat t, dfloat *fx, dfloat *fy, dfloat *fz,
 
 void cnsBrownMinionQuad3D(cns_t *cns);
 
+void cnsExtendedHaloSetup(cns_t *cns, setupAide &options);
+
 #ifdef RENDER
 
 void simpleRayTracer(int     plotNelements,
@@ -0,0 +1,110 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "cns.h"
+
+// append the geometric factors of the halo elements (Nentries per element) to those
+// of the local elements
+static dfloat *cnsExtendHaloFactors(mesh_t *mesh, dfloat *factors, int Nentries){
+
+  dlong Nlocal = mesh->Nelements*Nentries;
+
+  dfloat *extFactors = (dfloat*) calloc(Nlocal + mesh->totalHaloPairs*Nentries, sizeof(dfloat));
+  dfloat *sendBuffer = (dfloat*) calloc(mesh->totalHaloPairs*Nentries+1, sizeof(dfloat));
+
+  memcpy(extFactors, factors, Nlocal*sizeof(dfloat));
+
+  meshHaloExchange(mesh, Nentries*sizeof(dfloat), extFactors, sendBuffer, extFactors+Nlocal);
+
+  free(sendBuffer);
+
+  return extFactors;
+}
+
+// DEVICE data for computing the viscous stresses of halo elements
+void cnsExtendedHaloSetup(cns_t *cns, setupAide &options){
+
+  mesh_t *mesh = cns->mesh;
+  meshHaloExtension_t *ext = cns->haloExtension;
+
+  dlong Nelements = mesh->Nelements + mesh->totalHaloPairs;
+  dlong NfaceNodes = mesh->Nfaces*mesh->Nfp;
+
+  // affine simplices store geometric factors per element, tensor product elements per node
+  int affine = (cns->elementType==TRIANGLES || cns->elementType==TETRAHEDRA);
+  int Nvgeo = affine ? mesh->Nvgeo : mesh->Nvgeo*mesh->Np;
+  int Nsgeo = affine ? mesh->Nfaces*mesh->Nsgeo : NfaceNodes*mesh->Nsgeo;
+
+  dfloat *extVgeo = cnsExtendHaloFactors(mesh, mesh->vgeo, Nvgeo);
+  dfloat *extSgeo = cnsExtendHaloFactors(mesh, mesh->sgeo, Nsgeo);
+
+  cns->haloVgeoOffset = mesh->Nelements*Nvgeo*sizeof(dfloat);
+
+  cns->o_extVgeo = mesh->device.malloc(Nelements*Nvgeo*sizeof(dfloat), extVgeo);
+  cns->o_extSgeo = mesh->device.malloc(Nelements*Nsgeo*sizeof(dfloat), extSgeo);
+
+  // face connectivity of local elements followed by that of the halo elements
+  cns->o_extVmapM = mesh->device.malloc(Nelements*NfaceNodes*sizeof(dlong));
+  cns->o_extVmapP = mesh->device.malloc(Nelements*NfaceNodes*sizeof(dlong));
+  cns->o_extEToB  = mesh->device.malloc(Nelements*mesh->Nfaces*sizeof(int));
+
+  size_t localMapBytes = mesh->Nelements*NfaceNodes*sizeof(dlong);
+  size_t haloMapBytes  = mesh->totalHaloPairs*NfaceNodes*sizeof(dlong);
+  size_t localBBytes   = mesh->Nelements*mesh->Nfaces*sizeof(int);
+  size_t haloBBytes    = mesh->totalHaloPairs*mesh->Nfaces*sizeof(int);
+
+  cns->o_extVmapM.copyFrom(mesh->vmapM, localMapBytes, 0);
+  cns->o_extVmapP.copyFrom(mesh->vmapP, localMapBytes, 0);
+  cns->o_extEToB.copyFrom(mesh->EToB, localBBytes, 0);
+  if(mesh->totalHaloPairs){
+    cns->o_extVmapM.copyFrom(ext->vmapM, haloMapBytes, localMapBytes);
+    cns->o_extVmapP.copyFrom(ext->vmapP, haloMapBytes, localMapBytes);
+    cns->o_extEToB.copyFrom(ext->EToB, haloBBytes, localBBytes);
+  }
+
+  // node coordinates of halo elements are already held after the local ones
+  cns->o_extX = mesh->device.malloc(Nelements*mesh->Np*sizeof(dfloat), mesh->x);
+  cns->o_extY = mesh->device.malloc(Nelements*mesh->Np*sizeof(dfloat), mesh->y);
+  if(mesh->dim==3)
+    cns->o_extZ = mesh->device.malloc(Nelements*mesh->Np*sizeof(dfloat), mesh->z);
+  else
+    cns->o_extZ = cns->o_extY; // unused in 2D
+
+  // one exchange of q for the usual and the extra halo elements
+  cns->halo = meshHaloDeviceExtendedSetup(mesh, ext, mesh->Np*cns->Nfields, options);
+
+  hlong Nextra = ext->Nextra, totalExtra = 0;
+  hlong Nhalo = mesh->totalHaloPairs, totalHalo = 0;
+  MPI_Allreduce(&Nextra, &totalExtra, 1, MPI_HLONG, MPI_SUM, mesh->comm);
+  MPI_Allreduce(&Nhalo, &totalHalo, 1, MPI_HLONG, MPI_SUM, mesh->comm);
+
+  if(mesh->rank==0)
+    printf("Extended halo: %lld halo and %lld extra halo elements\n",
+           (long long int) totalHalo, (long long int) totalExtra);
+
+  free(extVgeo);
+  free(extSgeo);
+}
@@ -75,6 +75,9 @@ int main(int argc, char **argv){
   // run
   cnsRun(cns, options);
 
+  meshHaloDeviceFree(cns->halo);
+  if(cns->stressesHalo) meshHaloDeviceFree(cns->stressesHalo);
+
   // close down MPI
   MPI_Finalize();
 
@@ -194,6 +194,13 @@ void cnsRun(cns_t *cns, setupAide &options){
       cnsReport(cns, time, options);
     }
   }
+
+  mesh->device.finish();
+
+  double elapsed  = timer.toc("Run");
+
+  if(mesh->rank==0)
+    printf("\nRun took %lg seconds for %d steps\n", elapsed, mesh->NtimeSteps);
  }
   
 }
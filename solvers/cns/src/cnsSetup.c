@@ -83,11 +83,22 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
   
   options.getArgs("TSTEPS FOR FORCE OUTPUT",   cns->outputForceStep);
   
+  // single halo exchange per stage: q is received one layer deeper than the
+  // usual halo (not available for the cubed sphere)
+  cns->extendedHalo = options.compareArgs("VISCOUS STRESSES HALO", "EXTENDED")
+    && !(cns->elementType==QUADRILATERALS && cns->dim==3);
+
+  cns->NqElements = mesh->Nelements+mesh->totalHaloPairs;
+  if(cns->extendedHalo){
+    cns->haloExtension = meshHaloExtensionSetup(mesh);
+    cns->NqElements += cns->haloExtension->Nextra;
+  }
+
   // compute samples of q at interpolation nodes
   //  mesh->q    = (dfloat*) calloc((mesh->totalHaloPairs+mesh->Nelements)*mesh->Np*mesh->Nfields,
   //                                sizeof(dfloat));
 
-  cns->q    = (dfloat*) calloc((mesh->totalHaloPairs+mesh->Nelements)*mesh->Np*mesh->Nfields,
+  cns->q    = (dfloat*) calloc(cns->NqElements*mesh->Np*mesh->Nfields,
 			       sizeof(dfloat));
   
   cns->rhsq = (dfloat*) calloc(mesh->Nelements*mesh->Np*mesh->Nfields,
@@ -100,7 +111,7 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
 
   if (options.compareArgs("TIME INTEGRATOR","DOPRI5")){
     int NrkStages = 7;
-    cns->rkq  = (dfloat*) calloc((mesh->totalHaloPairs+mesh->Nelements)*mesh->Np*mesh->Nfields,
+    cns->rkq  = (dfloat*) calloc(cns->NqElements*mesh->Np*mesh->Nfields,
           sizeof(dfloat));
     cns->rkrhsq = (dfloat*) calloc(NrkStages*mesh->Nelements*mesh->Np*mesh->Nfields,
           sizeof(dfloat));
@@ -273,10 +284,10 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
   kernelInfo["includes"] += (char*)boundaryHeaderFileName.c_str();
  
   cns->o_q =
-    mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), cns->q);
+    mesh->device.malloc(mesh->Np*cns->NqElements*mesh->Nfields*sizeof(dfloat), cns->q);
 
   cns->o_saveq =
-    mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), cns->q);
+    mesh->device.malloc(mesh->Np*cns->NqElements*mesh->Nfields*sizeof(dfloat), cns->q);
 
   
   cns->o_viscousStresses =
@@ -297,7 +308,7 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
   if (options.compareArgs("TIME INTEGRATOR","DOPRI5")){
     int NrkStages = 7;
     cns->o_rkq =
-      mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), cns->rkq);
+      mesh->device.malloc(mesh->Np*cns->NqElements*mesh->Nfields*sizeof(dfloat), cns->rkq);
     cns->o_rkrhsq =
       mesh->device.malloc(NrkStages*mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat), cns->rkrhsq);
     cns->o_rkerr =
@@ -315,25 +326,12 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
   cns->o_Vort = mesh->device.malloc(3*mesh->Np*mesh->Nelements*sizeof(dfloat), cns->Vort); // 3 components
   
 
-  if(mesh->totalHaloPairs>0){
-    // temporary DEVICE buffer for halo (maximum size Nfields*Np for dfloat)
-    mesh->o_haloBuffer =
-      mesh->device.malloc(mesh->totalHaloPairs*mesh->Np*mesh->Nfields*sizeof(dfloat));
-
-    cns->o_haloStressesBuffer =
-      mesh->device.malloc(mesh->totalHaloPairs*mesh->Np*cns->Nstresses*sizeof(dfloat));
-  
-    // MPI send buffer
-    cns->haloBytes = mesh->totalHaloPairs*mesh->Np*cns->Nfields*sizeof(dfloat);
-    cns->haloStressesBytes = mesh->totalHaloPairs*mesh->Np*cns->Nstresses*sizeof(dfloat);
-    
-    cns->o_haloBuffer = mesh->device.malloc(cns->haloBytes);
-    cns->o_haloStressesBuffer = mesh->device.malloc(cns->haloStressesBytes);
-    
-    cns->sendBuffer = (dfloat*) occaHostMallocPinned(mesh->device, cns->haloBytes, NULL, cns->o_sendBuffer);
-    cns->recvBuffer = (dfloat*) occaHostMallocPinned(mesh->device, cns->haloBytes, NULL, cns->o_recvBuffer);
-    cns->sendStressesBuffer = (dfloat*) occaHostMallocPinned(mesh->device, cns->haloStressesBytes, NULL, cns->o_sendStressesBuffer);
-    cns->recvStressesBuffer = (dfloat*) occaHostMallocPinned(mesh->device, cns->haloStressesBytes, NULL, cns->o_recvStressesBuffer);
+  // halo exchange buffers for q and viscous stresses
+  if(cns->extendedHalo){
+    cnsExtendedHaloSetup(cns, options);
+  } else {
+    cns->halo         = meshHaloDeviceSetup(mesh, mesh->Np*cns->Nfields, options);
+    cns->stressesHalo = meshHaloDeviceSetup(mesh, mesh->Np*cns->Nstresses, options);
   }
   
   kernelInfo["defines/" "p_Nfields"]= mesh->Nfields;
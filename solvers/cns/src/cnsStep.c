@@ -26,7 +26,84 @@ SOFTWARE.
 
 #include "cns.h"
 
-#define USE_OLD_HALO 1
+// viscous stresses of the local elements from o_q, whose halo exchange is in flight.
+// With the extended halo the stresses of the halo elements are computed here too,
+// otherwise their halo exchange is started
+static void cnsViscousStressesStart(cns_t *cns, const dfloat time,
+                                    dfloat intfx, dfloat intfy, dfloat intfz,
+                                    occa::memory &o_q){
+
+  mesh_t *mesh = cns->mesh;
+
+  // now compute viscous stresses
+  cns->stressesVolumeKernel(mesh->Nelements, 
+                            mesh->o_vgeo, 
+                            mesh->o_Dmatrices,
+                            cns->mu,
+                            o_q, 
+                            cns->o_viscousStresses);
+
+  // wait for q halo data to arrive
+  meshHaloExchangeDeviceFinish(mesh, cns->halo);
+
+  if(cns->extendedHalo){
+    dlong Ntotal = mesh->Nelements+mesh->totalHaloPairs;
+
+    // volume part of the halo element stresses
+    if(mesh->totalHaloPairs){
+      size_t qOffset = mesh->Nelements*mesh->Np*cns->Nfields*sizeof(dfloat);
+      size_t sOffset = mesh->Nelements*mesh->Np*cns->Nstresses*sizeof(dfloat);
+
+      cns->stressesVolumeKernel(mesh->totalHaloPairs, 
+                                cns->o_extVgeo + cns->haloVgeoOffset, 
+                                mesh->o_Dmatrices,
+                                cns->mu,
+                                o_q + qOffset, 
+                                cns->o_viscousStresses + sOffset);
+    }
+
+    // surface part for local and halo elements, using the extra halo elements
+    cns->stressesSurfaceKernel(Ntotal, 
+                               cns->o_extSgeo, 
+                               mesh->o_LIFTT,
+                               cns->o_extVmapM, 
+                               cns->o_extVmapP, 
+                               cns->o_extEToB, 
+                               time,
+                               cns->o_extX, 
+                               cns->o_extY,
+                               cns->o_extZ, 
+                               cns->mu,
+                               intfx, intfy, intfz,
+                               o_q, 
+                               cns->o_viscousStresses);
+  } else {
+    cns->stressesSurfaceKernel(mesh->Nelements, 
+                               mesh->o_sgeo, 
+                               mesh->o_LIFTT,
+                               mesh->o_vmapM, 
+                               mesh->o_vmapP, 
+                               mesh->o_EToB, 
+                               time,
+                               mesh->o_x, 
+                               mesh->o_y,
+                               mesh->o_z, 
+                               cns->mu,
+                               intfx, intfy, intfz,
+                               o_q, 
+                               cns->o_viscousStresses);
+
+    // extract stresses halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, cns->stressesHalo, cns->o_viscousStresses);
+  }
+}
+
+// wait for halo stresses data to arrive
+static void cnsViscousStressesFinish(cns_t *cns){
+
+  if(!cns->extendedHalo)
+    meshHaloExchangeDeviceFinish(cns->mesh, cns->stressesHalo);
+}
 
 void cnsDopriStep(cns_t *cns, setupAide &newOptions, const dfloat time){
 
@@ -57,115 +134,11 @@ void cnsDopriStep(cns_t *cns, setupAide &newOptions, const dfloat time){
     //compute RHS
     // rhsq = F(currentTIme, rkq)
 
-    // extract q halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*cns->Nfields;
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, cns->halo, cns->o_rkq);
 
-#if (USE_OLD_HALO)
-
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_rkq, cns->o_haloBuffer);
-      
-      // copy extracted halo to HOST 
-      cns->o_haloBuffer.copyTo(cns->sendBuffer);      
-      
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nfields*sizeof(dfloat), cns->sendBuffer, cns->recvBuffer);
-#else
-
-      // make sure rkq is updated
-      mesh->device.finish();  
-      
-      // launch haloExtractKernel on 2nd stream
-      mesh->device.setStream(mesh->dataStream);         
-
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_rkq, cns->o_haloBuffer);
-
-      // launch async copy on 2nd stream
-      cns->o_haloBuffer.copyTo(cns->sendBuffer,"async: true");
-
-      // switch to stream0 for Volume kernel
-      mesh->device.setStream(mesh->defaultStream);      
-#endif
-    }
-
-    //    printf("calling stress vol kernel with viscosity %g\n", cns->mu);
-    
-    // now compute viscous stresses
-    cns->stressesVolumeKernel(mesh->Nelements, 
-                              mesh->o_vgeo, 
-                              mesh->o_Dmatrices,
-                              cns->mu,
-                              cns->o_rkq, 
-                              cns->o_viscousStresses);
-
-    // wait for q halo data to arrive
-    if(mesh->totalHaloPairs>0){
-
-#if (!USE_OLD_HALO)
-      // switch dev->currentStream
-      mesh->device.setStream(mesh->dataStream);
-
-      // flush 2nd stream, ensure send buffer is loaded
-      mesh->device.finish();
-
-      // run remaining work on stream0
-      mesh->device.setStream(mesh->defaultStream);  
-
-      // start halo exchange on default stream
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nfields*sizeof(dfloat), cns->sendBuffer, cns->recvBuffer);
-#endif
-      
-      meshHaloExchangeFinish(mesh);
-      
-      // offset for halo daat
-      size_t offset = mesh->Np*cns->Nfields*mesh->Nelements*sizeof(dfloat); 
-      cns->o_rkq.copyFrom(cns->recvBuffer, cns->haloBytes, offset);
-
-    }
-
-    cns->stressesSurfaceKernel(mesh->Nelements, 
-                               mesh->o_sgeo, 
-                               mesh->o_LIFTT,
-                               mesh->o_vmapM, 
-                               mesh->o_vmapP, 
-                               mesh->o_EToB, 
-                               currentTime,
-                               mesh->o_x, 
-                               mesh->o_y,
-                               mesh->o_z, 
-                               cns->mu,
-			       intfx, intfy, intfz,
-                               cns->o_rkq, 
-                               cns->o_viscousStresses);
-
-    // extract stresses halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*cns->Nstresses;
-
-#if (USE_OLD_HALO)
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_viscousStresses, cns->o_haloStressesBuffer);
-      
-      // copy extracted halo to HOST 
-      cns->o_haloStressesBuffer.copyTo(cns->sendStressesBuffer);      
-      
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nstresses*sizeof(dfloat), cns->sendStressesBuffer, cns->recvStressesBuffer);
-#else
-      // launch haloExtractKernel on 2nd stream
-      mesh->device.setStream(mesh->dataStream);                       
-
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_viscousStresses, cns->o_haloStressesBuffer);
-
-      // launch async copy on 2nd stream
-      cns->o_haloStressesBuffer.copyTo(cns->sendStressesBuffer,"async: true");
-      
-      // switch to stream0 for Volume kernel
-      mesh->device.setStream(mesh->defaultStream);                   
-#endif
-				 
-
-      
-    }
+    // viscous stresses (starts their halo exchange unless the halo is extended)
+    cnsViscousStressesStart(cns, currentTime, intfx, intfy, intfz, cns->o_rkq);
 
     // compute volume contribution to DG cns RHS
     if (newOptions.compareArgs("ADVECTION TYPE","CUBATURE")) {
@@ -199,27 +172,7 @@ void cnsDopriStep(cns_t *cns, setupAide &newOptions, const dfloat time){
     }
 
     // wait for halo stresses data to arrive
-    if(mesh->totalHaloPairs>0){
-#if (!USE_OLD_HALO)
-      // switch dev->currentStream
-      mesh->device.setStream(mesh->dataStream);
-
-      // flush 2nd stream, ensure send buffer is loaded
-      mesh->device.finish();
-
-      // run remaining work on stream0
-      mesh->device.setStream(mesh->defaultStream);  
-      
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nstresses*sizeof(dfloat), cns->sendStressesBuffer, cns->recvStressesBuffer);
-#endif
-
-      meshHaloExchangeFinish(mesh);
-	    
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*cns->Nstresses*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      cns->o_viscousStresses.copyFrom(cns->recvStressesBuffer, cns->haloStressesBytes, offset);
-      
-    }
+    cnsViscousStressesFinish(cns);
 
     // compute surface contribution to DG cns RHS (LIFTT ?)
     // THIS ?
@@ -332,63 +285,11 @@ void cnsLserkStep(cns_t *cns, setupAide &newOptions, const dfloat time){
     dfloat fx, fy, fz, intfx, intfy, intfz;
     cnsBodyForce(currentTime , &fx, &fy, &fz, &intfx, &intfy, &intfz);
     
-    // extract q halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*cns->Nfields;
-        
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_q, cns->o_haloBuffer);
-        
-      // copy extracted halo to HOST 
-      cns->o_haloBuffer.copyTo(cns->sendBuffer);      
-        
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nfields*sizeof(dfloat), cns->sendBuffer, cns->recvBuffer);
-    }
+    // extract q halo on DEVICE and start halo exchange
+    meshHaloExchangeDeviceStart(mesh, cns->halo, cns->o_q);
       
-    // now compute viscous stresses
-    cns->stressesVolumeKernel(mesh->Nelements, 
-                              mesh->o_vgeo, 
-                              mesh->o_Dmatrices, 
-                              cns->mu,			      
-                              cns->o_q, 
-                              cns->o_viscousStresses);
-      
-    // wait for q halo data to arrive
-    if(mesh->totalHaloPairs>0){
-      meshHaloExchangeFinish(mesh);
-        
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*cns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      cns->o_q.copyFrom(cns->recvBuffer, cns->haloBytes, offset);
-    }
-      
-    cns->stressesSurfaceKernel(mesh->Nelements, 
-                               mesh->o_sgeo, 
-                               mesh->o_LIFTT,
-                               mesh->o_vmapM, 
-                               mesh->o_vmapP, 
-                               mesh->o_EToB, 
-                               currentTime,
-                               mesh->o_x, 
-                               mesh->o_y,
-                               mesh->o_z, 
-                               cns->mu,
-			       intfx, intfy, intfz,
-                               cns->o_q, 
-                               cns->o_viscousStresses);
-      
-    // extract stresses halo on DEVICE
-    if(mesh->totalHaloPairs>0){
-      int Nentries = mesh->Np*cns->Nstresses;
-          
-      mesh->haloExtractKernel(mesh->totalHaloPairs, Nentries, mesh->o_haloElementList, cns->o_viscousStresses, cns->o_haloStressesBuffer);
-        
-      // copy extracted halo to HOST 
-      cns->o_haloStressesBuffer.copyTo(cns->sendStressesBuffer);      
-          
-      // start halo exchange
-      meshHaloExchangeStart(mesh, mesh->Np*cns->Nstresses*sizeof(dfloat), cns->sendStressesBuffer, cns->recvStressesBuffer);
-    }
+    // viscous stresses (starts their halo exchange unless the halo is extended)
+    cnsViscousStressesStart(cns, currentTime, intfx, intfy, intfz, cns->o_q);
       
     // compute volume contribution to DG cns RHS
     if (newOptions.compareArgs("ADVECTION TYPE","CUBATURE")) {
@@ -423,13 +324,7 @@ void cnsLserkStep(cns_t *cns, setupAide &newOptions, const dfloat time){
     }
 
     // wait for halo stresses data to arrive
-    if(mesh->totalHaloPairs>0){
-      meshHaloExchangeFinish(mesh);
-        
-      // copy halo data to DEVICE
-      size_t offset = mesh->Np*cns->Nstresses*mesh->Nelements*sizeof(dfloat); // offset for halo data
-      cns->o_viscousStresses.copyFrom(cns->recvStressesBuffer, cns->haloStressesBytes, offset);
-    }
+    cnsViscousStressesFinish(cns);
       
     // compute surface contribution to DG cns RHS (LIFTT ?)
     if (newOptions.compareArgs("ADVECTION TYPE","CUBATURE")) {
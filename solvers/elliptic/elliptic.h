@@ -36,6 +36,8 @@ SOFTWARE.
 #include "mesh3D.h"
 #include "parAlmond.hpp"
 #include "ellipticPrecon.h"
+#include "kernelProfile.h"
+#include "kernelBuilder.h"
 
 // block size for reduction (hard coded)
 #define blockSize 256
@@ -115,6 +117,7 @@ typedef struct {
   occa::kernel partialAxKernel;
   occa::kernel partialFloatAxKernel;
   occa::kernel partialCubatureAxKernel;
+  occa::kernel buildDiagKernel; // Jacobi diagonal on the device (continuous quads/hexes)
   
   occa::kernel rhsBCKernel;
   occa::kernel addBCKernel;
@@ -140,6 +143,47 @@ typedef struct {
   dfloat         *tmpNormr;
   occa::memory  o_tmpNormr;
   occa::kernel  updatePCGKernel;
+
+  // pipelined and single reduction PCG
+  occa::memory o_u, o_w, o_m, o_n, o_q, o_s;
+  dfloat       *tmpDots;
+  occa::memory o_tmpDots;
+  occa::kernel pipelinedDotsPCGKernel;
+  occa::kernel pipelinedUpdatePCGKernel;
+  occa::kernel singleReductionUpdatePCGKernel;
+
+  // solution projection: A-orthonormal basis of previous solutions
+  int NprojMax, Nproj;
+  occa::memory o_projX, o_projAX; // basis vectors and their images under A
+  occa::memory o_projX0;          // initial guess handed to the Krylov solver
+  occa::memory o_projE, o_projAE; // new direction and its image under A
+  dfloat       *projAlpha, *projDots, *projLocal;
+  occa::memory o_projAlpha, o_projDots;
+  occa::kernel projectionDotsKernel;
+  occa::kernel projectionCombineKernel;
+
+  // block PCG: NblockFields right hand sides stored blockOffset apart
+  int NblockFields;
+  dlong blockOffset;
+  occa::memory o_blockP, o_blockZ, o_blockAp, o_blockAx;
+  dfloat       *blockDots, *blockLocal, *blockAlpha, *blockBeta;
+  occa::memory o_blockDots, o_blockAlpha, o_blockBeta;
+  occa::kernel partialBlockAxKernel;
+  occa::kernel blockDotsKernel;
+  occa::kernel blockUpdatePCGKernel;
+  occa::kernel blockScaledAddKernel;
+  occa::kernel blockDotMultiplyKernel;
+
+  // fused Chebyshev-Jacobi multigrid smoothing
+  occa::kernel chebyshevJacobiStartKernel;
+  occa::kernel chebyshevJacobiUpdateKernel;
+
+  // coordinated kernel builds, shared with the calling solver and multigrid levels
+  kernelBuilder_t *builder;
+
+  // kernel counters, owned by the calling solver (NULL when not profiled)
+  kernelProfile_t *profile;
+  int profAxGlobal, profAxLocal, profUpdatePCG;
   
 }elliptic_t;
 
@@ -149,6 +193,7 @@ elliptic_t *ellipticSetup(mesh2D *mesh, dfloat lambda, occa::properties &kernelI
 
 void ellipticPreconditioner(elliptic_t *elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_z);
 void ellipticPreconditionerSetup(elliptic_t *elliptic, ogs_t *ogs, dfloat lambda);
+void ellipticPreconditionerRefresh(elliptic_t *elliptic, dfloat lambda);
 
 int  ellipticSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol, occa::memory &o_r, occa::memory &o_x);
 void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &kernelInfo);
@@ -160,6 +205,17 @@ void ellipticEndHaloExchange(elliptic_t *elliptic, occa::memory &o_q, int Nentri
 
 //Linear solvers
 int pcg      (elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT);
+void ellipticProjectionPreSolve(elliptic_t *elliptic, occa::memory &o_r, occa::memory &o_x);
+void ellipticProjectionPostSolve(elliptic_t *elliptic, dfloat lambda, occa::memory &o_x);
+
+void ellipticBlockSolveSetup(elliptic_t *elliptic, int Nfields, dlong offset, occa::properties &kernelInfo);
+void ellipticBlockSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol,
+                        occa::memory &o_r, occa::memory &o_x, int *Niter);
+void ellipticBlockOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq);
+int blockPcg(elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x,
+             const dfloat tol, const int MAXIT, int *Niter);
+int pipelinedPcg(elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT);
+int singleReductionPcg(elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT);
 
 void ellipticScaledAdd(elliptic_t *elliptic, dfloat alpha, occa::memory &o_a, dfloat beta, occa::memory &o_b);
 dfloat ellipticWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a, occa::memory &o_b);
@@ -178,7 +234,11 @@ void ellipticBuildContinuous(elliptic_t* elliptic, dfloat lambda, nonZero_t **A,
 void ellipticBuildJacobi(elliptic_t *elliptic, dfloat lambda, dfloat **invDiagA);
 
 void ellipticBuildLocalPatches(elliptic_t *elliptic, dfloat lambda, dfloat rateTolerance,
-                               dlong *Npataches, dlong **patchesIndex, dfloat **patchesInvA);
+                               dlong *Npataches, dlong **patchesIndex, dfloat **patchesInvA,
+                               dfloat **patchesScale, int *patchesPacked);
+
+void ellipticBuildFastDiagonal(elliptic_t* elliptic, dfloat lambda,
+                               dfloat **fdmS, dfloat **fdmEigs, dfloat **fdmScales);
 
 // //smoother setups
 // void ellipticSetupSmoother(elliptic_t *elliptic, precon_t *precon, dfloat lambda);
@@ -193,6 +253,9 @@ void ellipticSEMFEMSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambda);
 dfloat ellipticUpdatePCG(elliptic_t *elliptic, occa::memory &o_p, occa::memory &o_Ap, dfloat alpha,
 			 occa::memory &o_x, occa::memory &o_r);
 
+// register the Ax and PCG update kernels with a solver's profile, prefix names the solve
+void ellipticProfileSetup(elliptic_t *elliptic, kernelProfile_t *profile, const char *prefix);
+
 // dfloat maxEigSmoothAx(elliptic_t* elliptic, agmgLevel *level);
 
 #define maxNthreads 256
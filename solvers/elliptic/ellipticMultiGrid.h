@@ -55,8 +55,10 @@ public:
   dfloat lambda1, lambda0;
   int ChebyshevIterations;
 
+  //smoother state lives in one workspace, the three vectors are slices of it
   static size_t smootherResidualBytes;
   static dfloat *smootherResidual;
+  static occa::memory o_smootherWorkspace;
   static occa::memory o_smootherResidual;
   static occa::memory o_smootherResidual2;
   static occa::memory o_smootherUpdate;
@@ -65,8 +67,13 @@ public:
   occa::memory o_invDiagA;
 
   //local patch data
+  int packedPatches;
   occa::memory o_invAP, o_patchesIndex, o_invDegreeAP;
 
+  //fast diagonalisation patch data (continuous quads/hexes)
+  bool fastDiagonal;
+  occa::memory o_fdmS, o_fdmEigs, o_fdmScales;
+
   setupAide options;
 
   //build a single level
@@ -103,6 +110,9 @@ public:
 
   void smoothRichardson(occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
+  void smoothChebyshevJacobi(occa::memory &o_r, occa::memory &o_x, bool xIsZero);
+
+  size_t smoothBytes(bool fused);
 
   void smootherLocalPatch(occa::memory &o_r, occa::memory &o_Sr);
   void smootherJacobi    (occa::memory &o_r, occa::memory &o_Sr);
@@ -77,6 +77,8 @@ typedef struct {
   occa::kernel approxFacePatchSolverKernel;
   occa::kernel exactBlockJacobiSolverKernel;
   occa::kernel approxBlockJacobiSolverKernel;
+  occa::kernel approxBlockJacobiSolverPackedKernel;
+  occa::kernel fastDiagonalKernel;
   occa::kernel patchGatherKernel;
   occa::kernel facePatchGatherKernel;
   occa::kernel CGLocalPatchKernel;
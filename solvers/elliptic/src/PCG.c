@@ -221,8 +221,10 @@ dfloat ellipticUpdatePCG(elliptic_t *elliptic,
     // x <= x + alpha*p
     // r <= r - alpha*A*p
     // dot(r,r)
+    kernelProfileStart(elliptic->profile);
     elliptic->updatePCGKernel(mesh->Nelements*mesh->Np, elliptic->NblocksUpdatePCG,
 			      elliptic->o_invDegree, o_p, o_Ap, alpha, o_x, o_r, elliptic->o_tmpNormr);
+    kernelProfileStop(elliptic->profile, elliptic->profUpdatePCG);
 
     elliptic->o_tmpNormr.copyTo(elliptic->tmpNormr);
 
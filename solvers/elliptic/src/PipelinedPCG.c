@@ -0,0 +1,199 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// local parts of r.u, w.u and r.r from one fused device reduction
+static void ellipticPipelinedDots(elliptic_t *elliptic, occa::memory &o_r,
+                                  occa::memory &o_u, occa::memory &o_w, dfloat *dots){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+  dlong Nblocks = elliptic->NblocksUpdatePCG;
+
+  int weighted = elliptic->options.compareArgs("DISCRETIZATION","CONTINUOUS") ? 1 : 0;
+
+  elliptic->pipelinedDotsPCGKernel(Ntotal, Nblocks, weighted, elliptic->o_invDegree,
+                                   o_r, o_u, o_w, elliptic->o_tmpDots);
+
+  elliptic->o_tmpDots.copyTo(elliptic->tmpDots, 3*Nblocks*sizeof(dfloat), 0);
+
+  dots[0] = 0; dots[1] = 0; dots[2] = 0;
+  for(dlong n=0;n<Nblocks;++n){
+    dots[0] += elliptic->tmpDots[3*n+0];
+    dots[1] += elliptic->tmpDots[3*n+1];
+    dots[2] += elliptic->tmpDots[3*n+2];
+  }
+}
+
+// Ghysels-Vanroose pipelined PCG: the single fused reduction of each
+// iteration is overlapped with the preconditioner and operator application
+int pipelinedPcg(elliptic_t* elliptic, dfloat lambda, 
+                 occa::memory &o_r, occa::memory &o_x, 
+                 const dfloat tol, const int MAXIT) {
+
+  mesh_t *mesh = elliptic->mesh;
+  setupAide options = elliptic->options;
+
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  occa::memory &o_p  = elliptic->o_p;
+  occa::memory &o_z  = elliptic->o_z;
+  occa::memory &o_u  = elliptic->o_u;
+  occa::memory &o_w  = elliptic->o_w;
+  occa::memory &o_m  = elliptic->o_m;
+  occa::memory &o_n  = elliptic->o_n;
+  occa::memory &o_q  = elliptic->o_q;
+  occa::memory &o_s  = elliptic->o_s;
+
+  dfloat localDots[3], globalDots[3];
+  dfloat alpha = 0, beta = 0, gammaOld = 0, alphaOld = 0;
+  int Niter = 0;
+
+  /*compute norm b, set the tolerance */
+  dfloat normB = ellipticWeightedNorm2(elliptic, elliptic->o_invDegree, o_r);
+  dfloat TOL =  mymax(tol*tol*normB,tol*tol);
+
+  // r = b - A*x
+  ellipticOperator(elliptic, lambda, o_x, elliptic->o_Ax, dfloatString);
+  ellipticScaledAdd(elliptic, -1.f, elliptic->o_Ax, 1.f, o_r);
+
+  // u = Precon^{-1} r, w = A*u
+  ellipticPreconditioner(elliptic, lambda, o_r, o_u);
+  ellipticOperator(elliptic, lambda, o_u, o_w, dfloatString);
+
+  while(Niter<MAXIT) {
+
+    // start the fused reduction of r.u, w.u, r.r
+    ellipticPipelinedDots(elliptic, o_r, o_u, o_w, localDots);
+
+    MPI_Request request;
+    MPI_Iallreduce(localDots, globalDots, 3, MPI_DFLOAT, MPI_SUM, mesh->comm, &request);
+
+    // m = Precon^{-1} w, n = A*m while the reduction is in flight
+    ellipticPreconditioner(elliptic, lambda, o_w, o_m);
+    ellipticOperator(elliptic, lambda, o_m, o_n, dfloatString);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    const dfloat gamma = globalDots[0];
+    const dfloat delta = globalDots[1];
+    const dfloat rdotr = globalDots[2];
+
+    if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)) 
+      printf("PIPECG: it %d r norm %12.12f \n", Niter, sqrt(rdotr));
+
+    if(rdotr < TOL) break;
+
+    if(Niter>0){
+      beta  = gamma/gammaOld;
+      alpha = gamma/(delta - beta*gamma/alphaOld);
+    } else {
+      beta  = 0;
+      alpha = gamma/delta;
+    }
+
+    // z = n + beta*z, q = m + beta*q, s = w + beta*s, p = u + beta*p
+    // x = x + alpha*p, r = r - alpha*s, u = u - alpha*q, w = w - alpha*z
+    elliptic->pipelinedUpdatePCGKernel(Ntotal, alpha, beta,
+                                       o_m, o_n, o_z, o_q, o_s, o_p,
+                                       o_x, o_r, o_u, o_w);
+
+    gammaOld = gamma;
+    alphaOld = alpha;
+
+    ++Niter;
+  }
+
+  return Niter;
+}
+
+// Chronopoulos-Gear PCG: one fused blocking reduction per iteration
+int singleReductionPcg(elliptic_t* elliptic, dfloat lambda, 
+                       occa::memory &o_r, occa::memory &o_x, 
+                       const dfloat tol, const int MAXIT) {
+
+  mesh_t *mesh = elliptic->mesh;
+  setupAide options = elliptic->options;
+
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  occa::memory &o_p  = elliptic->o_p;
+  occa::memory &o_u  = elliptic->o_u;
+  occa::memory &o_w  = elliptic->o_w;
+  occa::memory &o_s  = elliptic->o_s;
+
+  dfloat localDots[3], globalDots[3];
+  dfloat alpha = 0, beta = 0, gammaOld = 0, alphaOld = 0;
+  int Niter = 0;
+
+  /*compute norm b, set the tolerance */
+  dfloat normB = ellipticWeightedNorm2(elliptic, elliptic->o_invDegree, o_r);
+  dfloat TOL =  mymax(tol*tol*normB,tol*tol);
+
+  // r = b - A*x
+  ellipticOperator(elliptic, lambda, o_x, elliptic->o_Ax, dfloatString);
+  ellipticScaledAdd(elliptic, -1.f, elliptic->o_Ax, 1.f, o_r);
+
+  while(Niter<MAXIT) {
+
+    // u = Precon^{-1} r, w = A*u
+    ellipticPreconditioner(elliptic, lambda, o_r, o_u);
+    ellipticOperator(elliptic, lambda, o_u, o_w, dfloatString);
+
+    // r.u, w.u, r.r in one reduction
+    ellipticPipelinedDots(elliptic, o_r, o_u, o_w, localDots);
+    MPI_Allreduce(localDots, globalDots, 3, MPI_DFLOAT, MPI_SUM, mesh->comm);
+
+    const dfloat gamma = globalDots[0];
+    const dfloat delta = globalDots[1];
+    const dfloat rdotr = globalDots[2];
+
+    if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)) 
+      printf("SRCG: it %d r norm %12.12f \n", Niter, sqrt(rdotr));
+
+    if(rdotr < TOL) break;
+
+    if(Niter>0){
+      beta  = gamma/gammaOld;
+      alpha = gamma/(delta - beta*gamma/alphaOld);
+    } else {
+      beta  = 0;
+      alpha = gamma/delta;
+    }
+
+    // p = u + beta*p, s = w + beta*s, x = x + alpha*p, r = r - alpha*s
+    elliptic->singleReductionUpdatePCGKernel(Ntotal, alpha, beta,
+                                             o_u, o_w, o_p, o_s, o_x, o_r);
+
+    gammaOld = gamma;
+    alphaOld = alpha;
+
+    ++Niter;
+  }
+
+  return Niter;
+}
@@ -0,0 +1,383 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Block PCG for Nfields right hand sides that share one operator (same lambda,
+// boundary conditions and preconditioner). The fields are stored offset apart
+// and every Ax, gather-scatter, preconditioner and reduction handles all of
+// them at once; each field keeps its own alpha/beta and is frozen once it
+// has converged.
+
+void ellipticBlockSolveSetup(elliptic_t *elliptic, int Nfields, dlong offset, occa::properties &kernelInfo){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  dlong Nblocks = elliptic->NblocksUpdatePCG;
+
+  elliptic->NblockFields = Nfields;
+  elliptic->blockOffset = offset;
+
+  elliptic->o_blockP  = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+  elliptic->o_blockZ  = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+  elliptic->o_blockAp = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+  elliptic->o_blockAx = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+
+  elliptic->blockDots  = (dfloat*) calloc(Nfields*Nblocks, sizeof(dfloat));
+  elliptic->blockLocal = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  elliptic->blockAlpha = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  elliptic->blockBeta  = (dfloat*) calloc(Nfields, sizeof(dfloat));
+
+  elliptic->o_blockDots  = mesh->device.malloc(Nfields*Nblocks*sizeof(dfloat), elliptic->blockDots);
+  elliptic->o_blockAlpha = mesh->device.malloc(Nfields*sizeof(dfloat), elliptic->blockAlpha);
+  elliptic->o_blockBeta  = mesh->device.malloc(Nfields*sizeof(dfloat), elliptic->blockBeta);
+
+  occa::properties blockKernelInfo = kernelInfo;
+  blockKernelInfo["defines/" "pfloat"] = dfloatString;
+  blockKernelInfo["defines/" "p_NblockFields"] = Nfields;
+
+  // fused multi-field Ax for the affine GLL hex and tet operators
+  int blockAx = ((elliptic->elementType==HEXAHEDRA &&
+                  !elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR") &&
+                  !elliptic->options.compareArgs("ELLIPTIC INTEGRATION", "CUBATURE")) ||
+                 elliptic->elementType==TETRAHEDRA);
+
+  if (blockAx) {
+    const char *suffix = (elliptic->elementType==HEXAHEDRA) ? "Hex3D" : "Tet3D";
+    char fileName[BUFSIZ], kernelName[BUFSIZ];
+    sprintf(fileName,  DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
+    sprintf(kernelName, "ellipticPartialBlockAx%s", suffix);
+
+    elliptic->partialBlockAxKernel = kernelBuild(elliptic->builder, fileName, kernelName, blockKernelInfo);
+  }
+
+  elliptic->blockDotsKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                             "ellipticBlockDots", blockKernelInfo);
+
+  elliptic->blockUpdatePCGKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                             "ellipticBlockUpdatePCG", blockKernelInfo);
+
+  elliptic->blockScaledAddKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                             "ellipticBlockScaledAdd", blockKernelInfo);
+
+  elliptic->blockDotMultiplyKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                             "ellipticBlockDotMultiply", blockKernelInfo);
+}
+
+// dots[f] = a_f.b_f for all fields with a single global reduction
+static void ellipticBlockDots(elliptic_t *elliptic, occa::memory &o_a, occa::memory &o_b, dfloat *dots){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+  dlong Nblocks = elliptic->NblocksUpdatePCG;
+  int Nfields = elliptic->NblockFields;
+
+  elliptic->blockDotsKernel(Ntotal, Nblocks, Nfields, elliptic->blockOffset,
+                            elliptic->o_invDegree, o_a, o_b, elliptic->o_blockDots);
+
+  elliptic->o_blockDots.copyTo(elliptic->blockDots, Nfields*Nblocks*sizeof(dfloat), 0);
+
+  for(int fld=0;fld<Nfields;++fld){
+    elliptic->blockLocal[fld] = 0;
+    for(dlong n=0;n<Nblocks;++n)
+      elliptic->blockLocal[fld] += elliptic->blockDots[n+fld*Nblocks];
+  }
+
+  MPI_Allreduce(elliptic->blockLocal, dots, Nfields, MPI_DFLOAT, MPI_SUM, mesh->comm);
+}
+
+// b_f = alpha_f a_f + beta_f b_f
+static void ellipticBlockScaledAdd(elliptic_t *elliptic, dfloat *alpha, occa::memory &o_a,
+                                   dfloat *beta, occa::memory &o_b){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+  int Nfields = elliptic->NblockFields;
+
+  elliptic->o_blockAlpha.copyFrom(alpha, Nfields*sizeof(dfloat), 0);
+  elliptic->o_blockBeta.copyFrom(beta, Nfields*sizeof(dfloat), 0);
+
+  elliptic->blockScaledAddKernel(Ntotal, Nfields, elliptic->blockOffset,
+                                 elliptic->o_blockAlpha, o_a, elliptic->o_blockBeta, o_b);
+}
+
+void ellipticBlockOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq){
+
+  mesh_t *mesh = elliptic->mesh;
+  ogs_t *ogs = elliptic->ogs;
+
+  int Nfields = elliptic->NblockFields;
+  dlong offset = elliptic->blockOffset;
+
+  int mapType = (elliptic->elementType==HEXAHEDRA &&
+                 elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? 1:0;
+
+  int integrationType = (elliptic->elementType==HEXAHEDRA &&
+                         elliptic->options.compareArgs("ELLIPTIC INTEGRATION", "CUBATURE")) ? 1:0;
+
+  int blockAx = ((elliptic->elementType==HEXAHEDRA && !mapType && !integrationType) ||
+                 elliptic->elementType==TETRAHEDRA);
+
+  // local Ax on a list of elements for every field
+  for(int list=0;list<2;++list){
+    dlong Nelements = (list==0) ? mesh->NglobalGatherElements : mesh->NlocalGatherElements;
+    occa::memory &o_elementList = (list==0) ? mesh->o_globalGatherElementList : mesh->o_localGatherElementList;
+
+    if(Nelements){
+      if(blockAx){
+        elliptic->partialBlockAxKernel(Nelements, offset, o_elementList,
+                                       mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM,
+                                       lambda, o_q, o_Aq);
+      } else {
+        // no fused kernel for this element, one Ax launch per field
+        for(int fld=0;fld<Nfields;++fld){
+          occa::memory o_qf  = o_q  + fld*offset*sizeof(dfloat);
+          occa::memory o_Aqf = o_Aq + fld*offset*sizeof(dfloat);
+
+          if(integrationType)
+            elliptic->partialCubatureAxKernel(Nelements, o_elementList, mesh->o_cubggeo, mesh->o_cubD,
+                                              mesh->o_cubInterpT, lambda, o_qf, o_Aqf);
+          else if(mapType)
+            elliptic->partialAxKernel(Nelements, o_elementList, elliptic->o_EXYZ, elliptic->o_gllzw,
+                                      mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_qf, o_Aqf);
+          else
+            elliptic->partialAxKernel(Nelements, o_elementList, mesh->o_ggeo,
+                                      mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_qf, o_Aqf);
+        }
+      }
+    }
+
+    // one halo exchange for all fields, overlapped with the local elements
+    if(list==0)
+      ogsGatherScatterManyStart(o_Aq, Nfields, offset, ogsDfloat, ogsAdd, ogs);
+  }
+
+  ogsGatherScatterManyFinish(o_Aq, Nfields, offset, ogsDfloat, ogsAdd, ogs);
+
+  for(int fld=0;fld<Nfields;++fld){
+    occa::memory o_qf  = o_q  + fld*offset*sizeof(dfloat);
+    occa::memory o_Aqf = o_Aq + fld*offset*sizeof(dfloat);
+
+    if(elliptic->allNeumann) {
+      dfloat alpha = 0., alphaG = 0.;
+
+      elliptic->innerProductKernel(mesh->Nelements*mesh->Np, elliptic->o_invDegree, o_qf, elliptic->o_tmp);
+      elliptic->o_tmp.copyTo(elliptic->tmp);
+
+      for(dlong n=0;n<elliptic->Nblock;++n)
+        alpha += elliptic->tmp[n];
+
+      MPI_Allreduce(&alpha, &alphaG, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
+      alphaG *= elliptic->allNeumannPenalty*elliptic->allNeumannScale*elliptic->allNeumannScale;
+
+      mesh->addScalarKernel(mesh->Nelements*mesh->Np, alphaG, o_Aqf);
+    }
+
+    //post-mask
+    if (elliptic->Nmasked)
+      mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Aqf);
+  }
+}
+
+static void ellipticBlockPreconditioner(elliptic_t *elliptic, dfloat lambda,
+                                        occa::memory &o_r, occa::memory &o_z){
+
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  int Nfields = elliptic->NblockFields;
+  dlong offset = elliptic->blockOffset;
+
+  if(options.compareArgs("PRECONDITIONER", "JACOBI")){
+    elliptic->blockDotMultiplyKernel(mesh->Np*mesh->Nelements, Nfields, offset,
+                                     elliptic->precon->o_invDiagA, o_r, o_z);
+  } else if(options.compareArgs("PRECONDITIONER", "NONE")){
+    o_z.copyFrom(o_r, Nfields*offset*sizeof(dfloat));
+  } else {
+    // multilevel preconditioners are applied one field at a time
+    for(int fld=0;fld<Nfields;++fld){
+      occa::memory o_rf = o_r + fld*offset*sizeof(dfloat);
+      occa::memory o_zf = o_z + fld*offset*sizeof(dfloat);
+      ellipticPreconditioner(elliptic, lambda, o_rf, o_zf);
+    }
+  }
+}
+
+int blockPcg(elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x,
+             const dfloat tol, const int MAXIT, int *Niter){
+
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  int Nfields = elliptic->NblockFields;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+  dlong Nblocks = elliptic->NblocksUpdatePCG;
+
+  occa::memory &o_p  = elliptic->o_blockP;
+  occa::memory &o_z  = elliptic->o_blockZ;
+  occa::memory &o_Ap = elliptic->o_blockAp;
+  occa::memory &o_Ax = elliptic->o_blockAx;
+
+  dfloat *alpha = elliptic->blockAlpha;
+  dfloat *beta  = elliptic->blockBeta;
+
+  dfloat *TOL    = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *rdotr  = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *rdotz0 = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *rdotz1 = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *pAp    = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *zdotAp = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  dfloat *ones   = (dfloat*) calloc(Nfields, sizeof(dfloat));
+  int *active    = (int*) calloc(Nfields, sizeof(int));
+
+  int flexible = options.compareArgs("KRYLOV SOLVER", "PCG+FLEXIBLE") ||
+                 options.compareArgs("KRYLOV SOLVER", "PCG,FLEXIBLE");
+
+  /*compute norm b, set the tolerance */
+  ellipticBlockDots(elliptic, o_r, o_r, rdotr);
+  for(int fld=0;fld<Nfields;++fld){
+    TOL[fld] = mymax(tol*tol*rdotr[fld],tol*tol);
+    ones[fld] = 1.;
+    alpha[fld] = -1.;
+  }
+
+  // r = b - A*x
+  ellipticBlockOperator(elliptic, lambda, o_x, o_Ax);
+  ellipticBlockScaledAdd(elliptic, alpha, o_Ax, ones, o_r);
+
+  ellipticBlockDots(elliptic, o_r, o_r, rdotr);
+
+  int Nactive = 0;
+  for(int fld=0;fld<Nfields;++fld){
+    Niter[fld] = 0;
+    active[fld] = (rdotr[fld]>=1E-20);
+    Nactive += active[fld];
+  }
+
+  int it = 0;
+
+  if(Nactive){
+    ellipticBlockPreconditioner(elliptic, lambda, o_r, o_z);
+
+    // p = z
+    o_p.copyFrom(o_z, Nfields*elliptic->blockOffset*sizeof(dfloat));
+
+    ellipticBlockDots(elliptic, o_r, o_z, rdotz0);
+  }
+
+  while(Nactive && it<MAXIT){
+
+    ellipticBlockOperator(elliptic, lambda, o_p, o_Ap);
+
+    ellipticBlockDots(elliptic, o_p, o_Ap, pAp);
+
+    // converged fields get alpha = 0 and are left untouched
+    for(int fld=0;fld<Nfields;++fld)
+      alpha[fld] = (active[fld] && pAp[fld]!=0) ? rdotz0[fld]/pAp[fld] : 0.;
+
+    elliptic->o_blockAlpha.copyFrom(alpha, Nfields*sizeof(dfloat), 0);
+
+    // x <= x + alpha*p, r <= r - alpha*A*p, dot(r,r)
+    elliptic->blockUpdatePCGKernel(Ntotal, Nblocks, Nfields, elliptic->blockOffset,
+                                   elliptic->o_invDegree, o_p, o_Ap, elliptic->o_blockAlpha,
+                                   o_x, o_r, elliptic->o_blockDots);
+
+    elliptic->o_blockDots.copyTo(elliptic->blockDots, Nfields*Nblocks*sizeof(dfloat), 0);
+    for(int fld=0;fld<Nfields;++fld){
+      elliptic->blockLocal[fld] = 0;
+      for(dlong n=0;n<Nblocks;++n)
+        elliptic->blockLocal[fld] += elliptic->blockDots[n+fld*Nblocks];
+    }
+    MPI_Allreduce(elliptic->blockLocal, rdotr, Nfields, MPI_DFLOAT, MPI_SUM, mesh->comm);
+
+    if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)){
+      printf("BlockCG: it %d r norms", it);
+      for(int fld=0;fld<Nfields;++fld) printf(" %12.12f", sqrt(rdotr[fld]));
+      printf("\n");
+    }
+
+    Nactive = 0;
+    for(int fld=0;fld<Nfields;++fld){
+      if(active[fld] && rdotr[fld]<TOL[fld]) active[fld] = 0;
+      Nactive += active[fld];
+    }
+    if(!Nactive) break;
+
+    // z = Precon^{-1} r
+    ellipticBlockPreconditioner(elliptic, lambda, o_r, o_z);
+
+    ellipticBlockDots(elliptic, o_r, o_z, rdotz1);
+
+    if(flexible)
+      ellipticBlockDots(elliptic, o_z, o_Ap, zdotAp);
+
+    for(int fld=0;fld<Nfields;++fld){
+      if(!active[fld])
+        beta[fld] = 0.;
+      else if(flexible)
+        beta[fld] = -alpha[fld]*zdotAp[fld]/rdotz0[fld];
+      else
+        beta[fld] = rdotz1[fld]/rdotz0[fld];
+
+      rdotz0[fld] = rdotz1[fld];
+    }
+
+    // p = z + beta*p
+    ellipticBlockScaledAdd(elliptic, ones, o_z, beta, o_p);
+
+    ++it;
+    for(int fld=0;fld<Nfields;++fld)
+      if(active[fld]) Niter[fld] = it;
+  }
+
+  free(TOL); free(rdotr); free(rdotz0); free(rdotz1);
+  free(pAp); free(zdotAp); free(ones); free(active);
+
+  return it;
+}
+
+// solves the NblockFields systems packed blockOffset apart in o_r and o_x,
+// Niter[f] returns the iterations taken by field f
+void ellipticBlockSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol,
+                        occa::memory &o_r, occa::memory &o_x, int *Niter){
+
+  int maxIter = 1000;
+
+  if(elliptic->options.compareArgs("DISCRETIZATION", "CONTINUOUS")){
+    blockPcg(elliptic, lambda, o_r, o_x, tol, maxIter, Niter);
+  } else {
+    // IPDG operators are applied one field at a time
+    for(int fld=0;fld<elliptic->NblockFields;++fld){
+      occa::memory o_rf = o_r + fld*elliptic->blockOffset*sizeof(dfloat);
+      occa::memory o_xf = o_x + fld*elliptic->blockOffset*sizeof(dfloat);
+      Niter[fld] = ellipticSolve(elliptic, lambda, tol, o_rf, o_xf);
+    }
+  }
+}
@@ -0,0 +1,110 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Fast diagonalisation data for the continuous quad/hex element operators.
+// Each element operator is approximated by its separable part
+//   A_e ~ cr (W x W x K) + cs (W x K x W) + ct (K x W x W) + cm (W x W x W)
+// with K = D^T W D the 1D stiffness and W the GLL weights, so one 1D
+// generalised eigenproblem K S = W S Lambda serves every element and only
+// dim+1 scalars are stored per element instead of a dense Np x Np inverse.
+void ellipticBuildFastDiagonal(elliptic_t* elliptic, dfloat lambda,
+                               dfloat **fdmS, dfloat **fdmEigs, dfloat **fdmScales){
+
+  mesh_t *mesh = elliptic->mesh;
+  const int Nq = mesh->Nq;
+  const int dim = elliptic->dim;
+
+  // symmetric form W^{-1/2} K W^{-1/2} of the 1D stiffness
+  double *A   = (double*) calloc(Nq*Nq, sizeof(double));
+  double *eig = (double*) calloc(Nq, sizeof(double));
+  for (int a=0;a<Nq;a++) {
+    for (int b=0;b<Nq;b++) {
+      double Kab = 0.;
+      for (int k=0;k<Nq;k++)
+        Kab += mesh->gllw[k]*mesh->D[k*Nq+a]*mesh->D[k*Nq+b];
+      A[a+b*Nq] = Kab/sqrt(mesh->gllw[a]*mesh->gllw[b]);
+    }
+  }
+
+  char JOBZ = 'V';
+  char UPLO = 'U';
+  int N = Nq;
+  int LWORK = 3*Nq*Nq;
+  int INFO = -999;
+  double *WORK = (double*) calloc(LWORK, sizeof(double));
+
+  dsyev_(&JOBZ, &UPLO, &N, A, &N, eig, WORK, &LWORK, &INFO);
+
+  if (INFO) {
+    printf("ellipticBuildFastDiagonal: dsyev failed with info = %d\n", INFO);
+    exit(-1);
+  }
+
+  // S = W^{-1/2} V, row i holds the nodal values of the modes
+  *fdmS    = (dfloat*) calloc(Nq*Nq, sizeof(dfloat));
+  *fdmEigs = (dfloat*) calloc(Nq, sizeof(dfloat));
+  for (int i=0;i<Nq;i++)
+    for (int a=0;a<Nq;a++)
+      (*fdmS)[i*Nq+a] = A[i+a*Nq]/sqrt(mesh->gllw[i]);
+
+  for (int a=0;a<Nq;a++) (*fdmEigs)[a] = eig[a];
+  (*fdmEigs)[0] = 0.; //the constant mode is exact in the stiffness
+
+  // per element metric scalings, averaged against the reference quadrature weights
+  const int Nscales = dim+1;
+  *fdmScales = (dfloat*) calloc(mesh->Nelements*Nscales, sizeof(dfloat));
+
+  #pragma omp parallel for
+  for (dlong e=0;e<mesh->Nelements;e++) {
+    const dlong base = e*mesh->Np*mesh->Nggeo;
+
+    dfloat wsum = 0., Grr = 0., Gss = 0., Gtt = 0., JW = 0.;
+    for (int n=0;n<mesh->Np;n++) {
+      const int i = n%Nq;
+      const int j = (n/Nq)%Nq;
+      const int k = n/(Nq*Nq);
+
+      dfloat w = mesh->gllw[i]*mesh->gllw[j];
+      if (dim==3) w *= mesh->gllw[k];
+
+      wsum += w;
+      Grr += mesh->ggeo[base + n + G00ID*mesh->Np];
+      Gss += mesh->ggeo[base + n + G11ID*mesh->Np];
+      if (dim==3) Gtt += mesh->ggeo[base + n + G22ID*mesh->Np];
+      JW  += mesh->ggeo[base + n + GWJID*mesh->Np];
+    }
+
+    dfloat *scale = *fdmScales + e*Nscales;
+    scale[0] = Grr/wsum;
+    scale[1] = Gss/wsum;
+    if (dim==3) scale[2] = Gtt/wsum;
+    scale[dim] = lambda*JW/wsum;
+  }
+
+  free(A); free(eig); free(WORK);
+}
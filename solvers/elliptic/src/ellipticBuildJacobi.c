@@ -63,13 +63,19 @@ void ellipticBuildJacobi(elliptic_t* elliptic, dfloat lambda, dfloat **invDiagA)
     }
   }
 
-  // build some monolithic basis arrays (for quads and hexes)
-  dfloat *B  = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
-  dfloat *Br = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
-  dfloat *Bs = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
-  dfloat *Bt = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
-
-  if (elliptic->elementType==QUADRILATERALS) {
+  // continuous 2D quads and hexes build the diagonal sum-factorised on the device
+  int deviceDiag = options.compareArgs("DISCRETIZATION","CONTINUOUS")
+                && (elliptic->elementType==HEXAHEDRA
+                    || (elliptic->elementType==QUADRILATERALS && elliptic->dim==2));
+
+  // build some monolithic basis arrays (for quads and hexes), only the host builders use them
+  int NpB = deviceDiag ? 0 : mesh->Np;
+  dfloat *B  = (dfloat*) calloc(NpB*NpB, sizeof(dfloat));
+  dfloat *Br = (dfloat*) calloc(NpB*NpB, sizeof(dfloat));
+  dfloat *Bs = (dfloat*) calloc(NpB*NpB, sizeof(dfloat));
+  dfloat *Bt = (dfloat*) calloc(NpB*NpB, sizeof(dfloat));
+
+  if (elliptic->elementType==QUADRILATERALS && !deviceDiag) {
     int mode = 0;
     for(int nj=0;nj<mesh->N+1;++nj){
       for(int ni=0;ni<mesh->N+1;++ni){
@@ -94,7 +100,7 @@ void ellipticBuildJacobi(elliptic_t* elliptic, dfloat lambda, dfloat **invDiagA)
     }
   }
 
-  if (elliptic->elementType==HEXAHEDRA) {
+  if (elliptic->elementType==HEXAHEDRA && !deviceDiag) {
     int mode = 0;
     for(int nk=0;nk<mesh->N+1;++nk){
       for(int nj=0;nj<mesh->N+1;++nj){
@@ -134,7 +140,21 @@ void ellipticBuildJacobi(elliptic_t* elliptic, dfloat lambda, dfloat **invDiagA)
 
   if(mesh->rank==0) printf("Building diagonal...");fflush(stdout);
 
-  if (options.compareArgs("DISCRETIZATION","IPDG")) {
+  if (deviceDiag) {
+    dfloat neumannShift = 0.;
+    if (elliptic->allNeumann)
+      neumannShift = elliptic->allNeumannPenalty*elliptic->allNeumannScale*elliptic->allNeumannScale;
+
+    occa::memory o_diagA = mesh->device.malloc(diagNnum*sizeof(dfloat), diagA);
+
+    elliptic->buildDiagKernel(mesh->Nelements, mesh->o_ggeo, mesh->o_D, elliptic->o_mapB,
+                              lambda, neumannShift, o_diagA);
+
+    ogsGatherScatter(o_diagA, ogsDfloat, ogsAdd, elliptic->ogs);
+
+    o_diagA.copyTo(diagA);
+    o_diagA.free();
+  } else if (options.compareArgs("DISCRETIZATION","IPDG")) {
     switch(elliptic->elementType){
       case TRIANGLES: 
         if (options.compareArgs("BASIS","BERN")) {
@@ -202,7 +222,7 @@ void ellipticBuildJacobi(elliptic_t* elliptic, dfloat lambda, dfloat **invDiagA)
     }
   }
 
-  if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) 
+  if (options.compareArgs("DISCRETIZATION","CONTINUOUS") && !deviceDiag)
     ogsGatherScatter(diagA, ogsDfloat, ogsAdd, elliptic->ogs);
     
   *invDiagA = (dfloat*) calloc(diagNnum, sizeof(dfloat));
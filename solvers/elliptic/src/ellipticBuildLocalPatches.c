@@ -46,13 +46,23 @@ void ellipticBuildLocalPatchesTri2D(elliptic_t* elliptic, dfloat lambda, dfloat
 void ellipticBuildLocalPatchesQuad2D(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
                                    dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA);
 void ellipticBuildLocalPatchesTet3D(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
-                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA);
+                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA,
+                                   dfloat *patchesScale);
 void ellipticBuildLocalPatchesHex3D(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
                                    dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA);
 
 
+// patchesScale[e] multiplies the inverse selected by patchesIndex[e]. When
+// patchesPacked is set each inverse is stored as its packed upper triangle.
 void ellipticBuildLocalPatches(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
-                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA) {
+                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA,
+                                   dfloat **patchesScale, int *patchesPacked) {
+
+  mesh_t *mesh = elliptic->mesh;
+
+  *patchesScale = (dfloat*) calloc(mesh->Nelements, sizeof(dfloat));
+  for (dlong e=0;e<mesh->Nelements;e++) (*patchesScale)[e] = 1.0;
+  *patchesPacked = 0;
 
   switch(elliptic->elementType){
   case TRIANGLES:
@@ -60,12 +70,22 @@ void ellipticBuildLocalPatches(elliptic_t* elliptic, dfloat lambda, dfloat rateT
   case QUADRILATERALS:
     ellipticBuildLocalPatchesQuad2D(elliptic, lambda, rateTolerance, Npatches, patchesIndex, patchesInvA); break;
   case TETRAHEDRA:
-    ellipticBuildLocalPatchesTet3D(elliptic, lambda, rateTolerance, Npatches, patchesIndex, patchesInvA); break;
+    ellipticBuildLocalPatchesTet3D(elliptic, lambda, rateTolerance, Npatches, patchesIndex, patchesInvA, *patchesScale);
+    *patchesPacked = 1;
+    break;
   case HEXAHEDRA:
     ellipticBuildLocalPatchesHex3D(elliptic, lambda, rateTolerance, Npatches, patchesIndex, patchesInvA); break;
   }
 }
 
+//store the symmetrised upper triangle of A row by row
+static void packSymmetricMatrix(int N, dfloat *A, dfloat *Apacked) {
+  dlong id = 0;
+  for (int n=0;n<N;n++)
+    for (int m=n;m<N;m++)
+      Apacked[id++] = 0.5*(A[n*N+m]+A[m*N+n]);
+}
+
 void ellipticBuildLocalPatchesTri2D(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
                                    dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA){
 
@@ -379,8 +399,12 @@ void ellipticBuildLocalPatchesQuad2D(elliptic_t* elliptic, dfloat lambda, dfloat
   free(B); free(Br); free(Bs);
 }
 
+// Tet patches are symmetric, so only the packed upper triangle of each inverse
+// is kept. Elements close to the equilateral reference reuse its inverse,
+// scaled by the ratio of the element and reference operator traces.
 void ellipticBuildLocalPatchesTet3D(elliptic_t* elliptic, dfloat lambda, dfloat rateTolerance,
-                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA){
+                                   dlong *Npatches, dlong **patchesIndex, dfloat **patchesInvA,
+                                   dfloat *patchesScale){
 
   mesh_t *mesh = elliptic->mesh;
   setupAide options = elliptic->options;
@@ -443,23 +467,30 @@ void ellipticBuildLocalPatchesTet3D(elliptic_t* elliptic, dfloat lambda, dfloat
   meshConnectFaceNodes3D(refMesh);
   meshSurfaceGeometricFactorsTet3D(refMesh);
 
+  const int Np = mesh->Np;
+  const dlong NpPacked = Np*(Np+1)/2;
+
   //patch inverse storage
-  *patchesInvA = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
+  *patchesInvA = (dfloat*) calloc(NpPacked, sizeof(dfloat));
   *patchesIndex = (dlong*) calloc(mesh->Nelements, sizeof(dlong));
 
   //temp patch storage
-  dfloat *patchA = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
-  dfloat *invRefAA = (dfloat*) calloc(mesh->Np*mesh->Np, sizeof(dfloat));
+  dfloat *patchA = (dfloat*) calloc(Np*Np, sizeof(dfloat));
+  dfloat *invRefAA = (dfloat*) calloc(Np*Np, sizeof(dfloat));
+  dfloat *refPatchInvA = (dfloat*) calloc(Np*Np, sizeof(dfloat));
 
   //start with reference patch
-  dfloat *refPatchInvA = *patchesInvA;
   if (options.compareArgs("DISCRETIZATION","IPDG")) {
     BuildLocalIpdgPatchAxTet3D(elliptic, refMesh, lambda, MS, 0, refPatchInvA);
   } else if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
     BuildLocalContinuousPatchAxTet3D(elliptic, refMesh, lambda, 0, refPatchInvA);
   }
 
-  matrixInverse(mesh->Np, refPatchInvA);
+  dfloat refTrace = 0.;
+  for (int n=0;n<Np;n++) refTrace += refPatchInvA[n*Np+n];
+
+  matrixInverse(Np, refPatchInvA);
+  packSymmetricMatrix(Np, refPatchInvA, *patchesInvA);
 
   dfloat maxRate =0.;
   dfloat maxCond =0.;
@@ -469,9 +500,9 @@ void ellipticBuildLocalPatchesTet3D(elliptic_t* elliptic, dfloat lambda, dfloat
 
     //build the patch A matrix for this element
     if (options.compareArgs("DISCRETIZATION","IPDG")) {
-      BuildLocalIpdgPatchAxTet3D(elliptic, mesh, lambda, MS, eM, refPatchInvA);
+      BuildLocalIpdgPatchAxTet3D(elliptic, mesh, lambda, MS, eM, patchA);
     } else if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
-      BuildLocalContinuousPatchAxTet3D(elliptic, refMesh, lambda, eM, refPatchInvA);
+      BuildLocalContinuousPatchAxTet3D(elliptic, mesh, lambda, eM, patchA);
     }
 
     dlong eP0 = mesh->EToE[eM*mesh->Nfaces+0];
@@ -479,61 +510,55 @@ void ellipticBuildLocalPatchesTet3D(elliptic_t* elliptic, dfloat lambda, dfloat
     dlong eP2 = mesh->EToE[eM*mesh->Nfaces+2];
     dlong eP3 = mesh->EToE[eM*mesh->Nfaces+3];
 
-    int fP0 = mesh->EToF[eM*mesh->Nfaces+0];
-    int fP1 = mesh->EToF[eM*mesh->Nfaces+1];
-    int fP2 = mesh->EToF[eM*mesh->Nfaces+2];
-    int fP3 = mesh->EToF[eM*mesh->Nfaces+3];
-
     if(eP0>=0 && eP1>=0 && eP2>=0 && eP3>=0){ //check if this is an interior patch
 
-      refPatchInvA = *patchesInvA;
-
-      //hit the patch with the reference inverse
-      for(int n=0;n<mesh->Np;++n){
-        for(int m=0;m<mesh->Np;++m){
-          invRefAA[n*mesh->Np+m] = 0.;
-          for (int k=0;k<mesh->Np;k++) {
-            invRefAA[n*mesh->Np+m] += refPatchInvA[n*mesh->Np+k]*patchA[k*mesh->Np+m];
+      //the reference inverse is rescaled by the size of this element's operator
+      dfloat trace = 0.;
+      for (int n=0;n<Np;n++) trace += patchA[n*Np+n];
+      dfloat scale = refTrace/trace;
+
+      //hit the patch with the scaled reference inverse
+      for(int n=0;n<Np;++n){
+        for(int m=0;m<Np;++m){
+          invRefAA[n*Np+m] = 0.;
+          for (int k=0;k<Np;k++) {
+            invRefAA[n*Np+m] += scale*refPatchInvA[n*Np+k]*patchA[k*Np+m];
           }
         }
       }
 
-      dfloat cond = matrixConditionNumber(mesh->Np,invRefAA);
+      dfloat cond = matrixConditionNumber(Np,invRefAA);
       dfloat rate = (sqrt(cond)-1.)/(sqrt(cond)+1.);
 
-      //printf("Element %d's conditioned patch reports cond = %g and rate = %g \n", eM, cond, rate);
       maxRate = mymax(rate,maxRate);
       maxCond = mymax(cond,maxCond);
 
       if (rate < rateTolerance) {
         (*patchesIndex)[eM] = 0;
+        patchesScale[eM] = scale;
         refPatches++;
         continue;
       }
     }
     ++(*Npatches);
-    *patchesInvA = (dfloat*) realloc(*patchesInvA, (*Npatches)*mesh->Np*mesh->Np*sizeof(dfloat));
+    *patchesInvA = (dfloat*) realloc(*patchesInvA, (*Npatches)*NpPacked*sizeof(dfloat));
 
-    matrixInverse(mesh->Np, patchA);
+    matrixInverse(Np, patchA);
 
-    //copy inverse into patchesInvA
-    for(int n=0;n<mesh->Np;++n){
-      for(int m=0;m<mesh->Np;++m){
-        int id = ((*Npatches)-1)*mesh->Np*mesh->Np + n*mesh->Np + m;
-        (*patchesInvA)[id] = patchA[n*mesh->Np+m];
-      }
-    }
+    //copy the upper triangle of the inverse into patchesInvA
+    packSymmetricMatrix(Np, patchA, *patchesInvA + ((*Npatches)-1)*NpPacked);
 
     (*patchesIndex)[eM] = (*Npatches)-1;
   }
 
-  printf("saving "dlongFormat" full patches\n",*Npatches);
+  printf("saving "dlongFormat" full patches (%g MB packed)\n",*Npatches,
+         (*Npatches)*NpPacked*sizeof(dfloat)/1.e6);
   printf("using "dlongFormat" reference patches\n", refPatches);
   printf("Max condition number = %g, and slowest CG convergence rate = %g\n", maxCond, maxRate);
 
 
   free(refMesh);
-  free(patchA); free(invRefAA);
+  free(patchA); free(invRefAA); free(refPatchInvA);
   free(MS);
 }
 
@@ -42,6 +42,7 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   elliptic->BCType = baseElliptic->BCType;
   elliptic->allNeumann = baseElliptic->allNeumann;
   elliptic->allNeumannPenalty = baseElliptic->allNeumannPenalty;
+  elliptic->builder = baseElliptic->builder;
 
   elliptic->sendBuffer = baseElliptic->sendBuffer;
   elliptic->recvBuffer = baseElliptic->recvBuffer;
@@ -65,6 +66,8 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   elliptic->scaledAddKernel = baseElliptic->scaledAddKernel;
   elliptic->dotMultiplyKernel = baseElliptic->dotMultiplyKernel;
   elliptic->dotDivideKernel = baseElliptic->dotDivideKernel;
+  elliptic->chebyshevJacobiStartKernel = baseElliptic->chebyshevJacobiStartKernel;
+  elliptic->chebyshevJacobiUpdateKernel = baseElliptic->chebyshevJacobiUpdateKernel;
 #endif
 
   //populate the mini-mesh using the mesh struct
@@ -862,188 +865,195 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
-      kernelInfo["defines/" "p_blockSize"]= blockSize;
+  kernelInfo["defines/" "p_blockSize"]= blockSize;
 
-      // add custom defines
-      kernelInfo["defines/" "p_NpP"]= (mesh->Np+mesh->Nfp*mesh->Nfaces);
-      kernelInfo["defines/" "p_Nverts"]= mesh->Nverts;
+  // add custom defines
+  kernelInfo["defines/" "p_NpP"]= (mesh->Np+mesh->Nfp*mesh->Nfaces);
+  kernelInfo["defines/" "p_Nverts"]= mesh->Nverts;
 
-      int Nmax = mymax(mesh->Np, mesh->Nfaces*mesh->Nfp);
-      kernelInfo["defines/" "p_Nmax"]= Nmax;
+  int Nmax = mymax(mesh->Np, mesh->Nfaces*mesh->Nfp);
+  kernelInfo["defines/" "p_Nmax"]= Nmax;
 
-      int maxNodes = mymax(mesh->Np, (mesh->Nfp*mesh->Nfaces));
-      kernelInfo["defines/" "p_maxNodes"]= maxNodes;
+  int maxNodes = mymax(mesh->Np, (mesh->Nfp*mesh->Nfaces));
+  kernelInfo["defines/" "p_maxNodes"]= maxNodes;
 
-      int NblockV = mymax(1,maxNthreads/mesh->Np); // works for CUDA
-      kernelInfo["defines/" "p_NblockV"]= NblockV;
+  int NblockV = mymax(1,maxNthreads/mesh->Np); // works for CUDA
+  kernelInfo["defines/" "p_NblockV"]= NblockV;
 
-      int one = 1; //set to one for now. TODO: try optimizing over these
-      kernelInfo["defines/" "p_NnodesV"]= one;
+  int one = 1; //set to one for now. TODO: try optimizing over these
+  kernelInfo["defines/" "p_NnodesV"]= one;
 
-      int NblockS = mymax(1,maxNthreads/maxNodes); // works for CUDA
-      kernelInfo["defines/" "p_NblockS"]= NblockS;
+  int NblockS = mymax(1,maxNthreads/maxNodes); // works for CUDA
+  kernelInfo["defines/" "p_NblockS"]= NblockS;
 
-      int NblockP = mymax(1,maxNthreads/(4*mesh->Np)); // get close to maxNthreads threads
-      kernelInfo["defines/" "p_NblockP"]= NblockP;
+  int NblockP = mymax(1,maxNthreads/(4*mesh->Np)); // get close to maxNthreads threads
+  kernelInfo["defines/" "p_NblockP"]= NblockP;
 
-      int NblockG;
-      if(mesh->Np<=32) NblockG = ( 32/mesh->Np );
-      else NblockG = mymax(1,maxNthreads/mesh->Np);
-      kernelInfo["defines/" "p_NblockG"]= NblockG;
+  int NblockG;
+  if(mesh->Np<=32) NblockG = ( 32/mesh->Np );
+  else NblockG = mymax(1,maxNthreads/mesh->Np);
+  kernelInfo["defines/" "p_NblockG"]= NblockG;
 
-      //add standard boundary functions
-      char *boundaryHeaderFileName;
-      if (elliptic->dim==2)
-        boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary2D.h");
-      else if (elliptic->dim==3)
-        boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary3D.h");
-      kernelInfo["includes"] += boundaryHeaderFileName;
+  //add standard boundary functions
+  char *boundaryHeaderFileName;
+  if (elliptic->dim==2)
+    boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary2D.h");
+  else if (elliptic->dim==3)
+    boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary3D.h");
+  kernelInfo["includes"] += boundaryHeaderFileName;
 
-      occa::properties dfloatKernelInfo = kernelInfo;
-      occa::properties floatKernelInfo = kernelInfo;
-      floatKernelInfo["defines/" "pfloat"]= "float";
-      dfloatKernelInfo["defines/" "pfloat"]= dfloatString;
+  occa::properties dfloatKernelInfo = kernelInfo;
+  occa::properties floatKernelInfo = kernelInfo;
+  floatKernelInfo["defines/" "pfloat"]= "float";
+  dfloatKernelInfo["defines/" "pfloat"]= dfloatString;
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
-      sprintf(kernelName, "ellipticAx%s", suffix);
-      elliptic->AxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
+  sprintf(fileName, DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
+  sprintf(kernelName, "ellipticAx%s", suffix);
+  elliptic->AxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
 
-      // check for trilinear
-      if(elliptic->elementType!=HEXAHEDRA){
-        sprintf(kernelName, "ellipticPartialAx%s", suffix);
-      }
-      else{
-        if(elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR")){
-          sprintf(kernelName, "ellipticPartialAxTrilinear%s", suffix);
-        }else{
-          sprintf(kernelName, "ellipticPartialAx%s", suffix);
-        }
-      }
+  // check for trilinear
+  if(elliptic->elementType!=HEXAHEDRA){
+    sprintf(kernelName, "ellipticPartialAx%s", suffix);
+  }
+  else{
+    if(elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR")){
+      sprintf(kernelName, "ellipticPartialAxTrilinear%s", suffix);
+    }else{
+      sprintf(kernelName, "ellipticPartialAx%s", suffix);
+    }
+  }
 
-      //sprintf(kernelName, "ellipticPartialAx%s", suffix);
+  //sprintf(kernelName, "ellipticPartialAx%s", suffix);
 
-      elliptic->partialAxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
+  elliptic->partialAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
 
-      elliptic->partialFloatAxKernel = mesh->device.buildKernel(fileName,kernelName,floatKernelInfo);
+  elliptic->partialFloatAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,floatKernelInfo);
 
-      // only for Hex3D - cubature Ax
-      if(elliptic->elementType==HEXAHEDRA){
-	printf("BUILDING partialCubatureAxKernel\n");
-	sprintf(fileName,  DELLIPTIC "/okl/ellipticCubatureAx%s.okl", suffix);
+  // only for Hex3D - cubature Ax
+  if(elliptic->elementType==HEXAHEDRA){
+    printf("BUILDING partialCubatureAxKernel\n");
+    sprintf(fileName,  DELLIPTIC "/okl/ellipticCubatureAx%s.okl", suffix);
 
-	sprintf(kernelName, "ellipticCubaturePartialAx%s", suffix);
-	elliptic->partialCubatureAxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
-      }
+    sprintf(kernelName, "ellipticCubaturePartialAx%s", suffix);
+    elliptic->partialCubatureAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
+  }
 
+  if (elliptic->elementType==HEXAHEDRA ||
+      (elliptic->elementType==QUADRILATERALS && elliptic->dim==2)) {
+    sprintf(fileName, DELLIPTIC "/okl/ellipticBuildDiag%s.okl", suffix);
+    sprintf(kernelName, "ellipticBuildDiag%s", suffix);
+    elliptic->buildDiagKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
+  }
 
-      if (options.compareArgs("BASIS", "BERN")) {
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticGradientBB%s.okl", suffix);
-        sprintf(kernelName, "ellipticGradientBB%s", suffix);
+  if (options.compareArgs("BASIS", "BERN")) {
 
-        elliptic->gradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticGradientBB%s.okl", suffix);
+    sprintf(kernelName, "ellipticGradientBB%s", suffix);
 
-        sprintf(kernelName, "ellipticPartialGradientBB%s", suffix);
-        elliptic->partialGradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    elliptic->gradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdgBB%s.okl", suffix);
-        sprintf(kernelName, "ellipticAxIpdgBB%s", suffix);
-        elliptic->ipdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(kernelName, "ellipticPartialGradientBB%s", suffix);
+    elliptic->partialGradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(kernelName, "ellipticPartialAxIpdgBB%s", suffix);
-        elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdgBB%s.okl", suffix);
+    sprintf(kernelName, "ellipticAxIpdgBB%s", suffix);
+    elliptic->ipdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      } else if (options.compareArgs("BASIS", "NODAL")) {
+    sprintf(kernelName, "ellipticPartialAxIpdgBB%s", suffix);
+    elliptic->partialIpdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticGradient%s.okl", suffix);
-        sprintf(kernelName, "ellipticGradient%s", suffix);
+  } else if (options.compareArgs("BASIS", "NODAL")) {
 
-        elliptic->gradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticGradient%s.okl", suffix);
+    sprintf(kernelName, "ellipticGradient%s", suffix);
 
-        sprintf(kernelName, "ellipticPartialGradient%s", suffix);
-        elliptic->partialGradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    elliptic->gradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdg%s.okl", suffix);
-        sprintf(kernelName, "ellipticAxIpdg%s", suffix);
-        elliptic->ipdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(kernelName, "ellipticPartialGradient%s", suffix);
+    elliptic->partialGradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(kernelName, "ellipticPartialAxIpdg%s", suffix);
-        elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-      }
-    }
-    MPI_Barrier(mesh->comm);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdg%s.okl", suffix);
+    sprintf(kernelName, "ellipticAxIpdg%s", suffix);
+    elliptic->ipdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+    sprintf(kernelName, "ellipticPartialAxIpdg%s", suffix);
+    elliptic->partialIpdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
   }
 
   //new precon struct
   elliptic->precon = (precon_t *) calloc(1,sizeof(precon_t));
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
-      sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
-      sprintf(kernelName, "ellipticBlockJacobiPrecon");
-      elliptic->precon->blockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-
-      sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
-      elliptic->precon->partialblockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
-      sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
-      elliptic->precon->approxBlockJacobiSolverKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-
-      //sizes for the coarsen and prolongation kernels. degree NFine to degree N
-      int NqFine   = (Nf+1);
-      int NqCoarse = (Nc+1);
-      kernelInfo["defines/" "p_NqFine"]= Nf+1;
-      kernelInfo["defines/" "p_NqCoarse"]= Nc+1;
-
-      int NpFine, NpCoarse;
-      switch(elliptic->elementType){
-      case TRIANGLES:
-        NpFine   = (Nf+1)*(Nf+2)/2;
-        NpCoarse = (Nc+1)*(Nc+2)/2;
-        break;
-      case QUADRILATERALS:
-        NpFine   = (Nf+1)*(Nf+1);
-        NpCoarse = (Nc+1)*(Nc+1);
-        break;
-      case TETRAHEDRA:
-        NpFine   = (Nf+1)*(Nf+2)*(Nf+3)/6;
-        NpCoarse = (Nc+1)*(Nc+2)*(Nc+3)/6;
-        break;
-      case HEXAHEDRA:
-        NpFine   = (Nf+1)*(Nf+1)*(Nf+1);
-        NpCoarse = (Nc+1)*(Nc+1)*(Nc+1);
-        break;
-      }
-      kernelInfo["defines/" "p_NpFine"]= NpFine;
-      kernelInfo["defines/" "p_NpCoarse"]= NpCoarse;
-
-      int NblockVFine = maxNthreads/NpFine;
-      int NblockVCoarse = maxNthreads/NpCoarse;
-      kernelInfo["defines/" "p_NblockVFine"]= NblockVFine;
-      kernelInfo["defines/" "p_NblockVCoarse"]= NblockVCoarse;
-
-      // Use the same kernel with quads for the following kenels
-      if(elliptic->dim==3){
-	if(elliptic->elementType==QUADRILATERALS)
-	  suffix = strdup("Quad2D");
-	if(elliptic->elementType==TRIANGLES)
-	  suffix = strdup("Tri2D");
-      }
+  sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
+  sprintf(kernelName, "ellipticBlockJacobiPrecon");
+  elliptic->precon->blockJacobiKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
-      elliptic->precon->coarsenKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
+  elliptic->precon->partialblockJacobiKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
-      elliptic->precon->prolongateKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-    }
-    MPI_Barrier(mesh->comm);
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
+  sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
+  elliptic->precon->approxBlockJacobiSolverKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  sprintf(kernelName, "ellipticApproxBlockJacobiSolverPacked");
+  elliptic->precon->approxBlockJacobiSolverPackedKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  if (elliptic->elementType==HEXAHEDRA ||
+      (elliptic->elementType==QUADRILATERALS && elliptic->dim==2)) {
+    sprintf(fileName, DELLIPTIC "/okl/ellipticFastDiagonal%s.okl", suffix);
+    sprintf(kernelName, "ellipticFastDiagonal%s", suffix);
+    elliptic->precon->fastDiagonalKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
   }
 
+  //sizes for the coarsen and prolongation kernels. degree NFine to degree N
+  int NqFine   = (Nf+1);
+  int NqCoarse = (Nc+1);
+  kernelInfo["defines/" "p_NqFine"]= Nf+1;
+  kernelInfo["defines/" "p_NqCoarse"]= Nc+1;
+
+  int NpFine, NpCoarse;
+  switch(elliptic->elementType){
+  case TRIANGLES:
+    NpFine   = (Nf+1)*(Nf+2)/2;
+    NpCoarse = (Nc+1)*(Nc+2)/2;
+    break;
+  case QUADRILATERALS:
+    NpFine   = (Nf+1)*(Nf+1);
+    NpCoarse = (Nc+1)*(Nc+1);
+    break;
+  case TETRAHEDRA:
+    NpFine   = (Nf+1)*(Nf+2)*(Nf+3)/6;
+    NpCoarse = (Nc+1)*(Nc+2)*(Nc+3)/6;
+    break;
+  case HEXAHEDRA:
+    NpFine   = (Nf+1)*(Nf+1)*(Nf+1);
+    NpCoarse = (Nc+1)*(Nc+1)*(Nc+1);
+    break;
+  }
+  kernelInfo["defines/" "p_NpFine"]= NpFine;
+  kernelInfo["defines/" "p_NpCoarse"]= NpCoarse;
+
+  int NblockVFine = maxNthreads/NpFine;
+  int NblockVCoarse = maxNthreads/NpCoarse;
+  kernelInfo["defines/" "p_NblockVFine"]= NblockVFine;
+  kernelInfo["defines/" "p_NblockVCoarse"]= NblockVCoarse;
+
+  // Use the same kernel with quads for the following kenels
+  if(elliptic->dim==3){
+    if(elliptic->elementType==QUADRILATERALS)
+      suffix = strdup("Quad2D");
+    if(elliptic->elementType==TRIANGLES)
+      suffix = strdup("Tri2D");
+  }
+
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
+  sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
+  elliptic->precon->coarsenKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
+  sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
+  elliptic->precon->prolongateKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
   if(elliptic->elementType==HEXAHEDRA){
     if(options.compareArgs("DISCRETIZATION","CONTINUOUS")){
       if(options.compareArgs("ELEMENT MAP", "TRILINEAR")){
@@ -31,13 +31,16 @@ int main(int argc, char **argv){
   // start up MPI
   MPI_Init(&argc, &argv);
 
-  if(argc!=2){
-    printf("usage: ./ellipticMain setupfile\n");
+  if(argc!=2 && !(argc==3 && !strcmp(argv[2], "prebuild"))){
+    printf("usage: ./ellipticMain setupfile [prebuild]\n");
 
     MPI_Finalize();
     exit(-1);
   }
 
+  // prebuild: compile every kernel the setup file needs into the OCCA cache and stop
+  int prebuild = (argc==3);
+
   // if argv > 2 then should load input data from argv
   setupAide options(argv[1]);
 
@@ -72,6 +75,15 @@ int main(int argc, char **argv){
   kernelInfo["flags"].asObject();
 
   elliptic_t *elliptic = ellipticSetup(mesh, lambda, kernelInfo, options);
+  kernelBuilderReport(elliptic->builder);
+  if(prebuild){
+    MPI_Finalize();
+    exit(0);
+  }
+
+  // kernel counters, enabled by [KERNEL PROFILE] TRUE
+  kernelProfile_t *profile = kernelProfileSetup(mesh->device, mesh->comm, options);
+  ellipticProfileSetup(elliptic, profile, "");
 
   if(options.compareArgs("BENCHMARK", "BK5") ||
      options.compareArgs("BENCHMARK", "BP5")){
@@ -244,6 +256,9 @@ int main(int argc, char **argv){
   }
 #endif
 
+  kernelProfileReport(profile, options);
+  kernelProfileFree(profile);
+
   // close down MPI
   MPI_Finalize();
 
@@ -58,6 +58,8 @@ void MGLevel::prolongate(occa::memory o_x, occa::memory o_Px) {
 void MGLevel::smooth(occa::memory o_rhs, occa::memory o_x, bool x_is_zero) {
   if (stype==RICHARDSON) {
     this->smoothRichardson(o_rhs, o_x, x_is_zero);
+  } else if (stype==CHEBYSHEV&&smtype==JACOBI) {
+    this->smoothChebyshevJacobi(o_rhs, o_x, x_is_zero);
   } else if (stype==CHEBYSHEV) {
     this->smoothChebyshev(o_rhs, o_x, x_is_zero);
   }
@@ -146,14 +148,91 @@ void MGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZer
   elliptic->scaledAddKernel(Nrows, one, o_d, one, o_x);
 }
 
+//Chebyshev with the Jacobi scaling and recurrence fused into one pass per operator apply
+void MGLevel::smoothChebyshevJacobi(occa::memory &o_r, occa::memory &o_x, bool xIsZero) {
+
+  const dfloat theta = 0.5*(lambda1+lambda0);
+  const dfloat delta = 0.5*(lambda1-lambda0);
+  const dfloat invTheta = 1.0/theta;
+  const dfloat sigma = theta/delta;
+  dfloat rho_n = 1./sigma;
+  dfloat rho_np1;
+
+  dfloat one = 1.;
+
+  occa::memory o_res = o_smootherResidual;
+  occa::memory o_Ad  = o_smootherResidual2;
+  occa::memory o_d   = o_smootherUpdate;
+
+  //res = S(r-Ax), d = invTheta*res
+  if (!xIsZero) this->Ax(o_x,o_res);
+  elliptic->chebyshevJacobiStartKernel(Nrows, (int) xIsZero, invTheta,
+                                       o_invDiagA, o_r, o_res, o_d);
+
+  for (int k=0;k<ChebyshevIterations;k++) {
+    this->Ax(o_d,o_Ad);
+
+    rho_np1 = 1.0/(2.*sigma-rho_n);
+    dfloat rhoDivDelta = 2.0*rho_np1/delta;
+
+    //x_k+1 = x_k + d_k, r_k+1 = r_k - SAd_k, d_k+1 = rho_k+1*rho_k*d_k + 2*rho_k+1*r_k+1/delta
+    elliptic->chebyshevJacobiUpdateKernel(Nrows, (int) (xIsZero&&(k==0)),
+                                          rhoDivDelta, rho_np1*rho_n,
+                                          o_invDiagA, o_Ad, o_res, o_d, o_x);
+
+    rho_n = rho_np1;
+  }
+  //x_k+1 = x_k + d_k
+  if (xIsZero&&(ChebyshevIterations==0))
+    elliptic->scaledAddKernel(Nrows, one, o_d, (dfloat) 0., o_x);
+  else
+    elliptic->scaledAddKernel(Nrows, one, o_d, one, o_x);
+}
+
+//smoother vector traffic per V-cycle (pre-smooth from zero plus post-smooth), operator applies excluded
+size_t MGLevel::smoothBytes(bool fused) {
+
+  //vectors streamed by the start, each iteration and the final update
+  size_t startZero, start, iter, last = 3;
+  if (fused) {
+    startZero = 4; start = 5; iter = 8;
+  } else {
+    startZero = 6; start = 9; iter = 12;
+  }
+
+  size_t vectors = startZero + start + 2*(ChebyshevIterations*iter + last);
+  return vectors*Nrows*sizeof(dfloat);
+}
+
 void MGLevel::smootherLocalPatch(occa::memory &o_r, occa::memory &o_Sr) {
 
-  elliptic->precon->approxBlockJacobiSolverKernel(mesh->Nelements,
-                            elliptic->precon->o_patchesIndex,
-                            elliptic->precon->o_invAP,
-                            elliptic->precon->o_invDegreeAP,
+  if (fastDiagonal) {
+    elliptic->precon->fastDiagonalKernel(mesh->Nelements,
+                            o_fdmS,
+                            o_fdmEigs,
+                            o_fdmScales,
+                            o_invDegreeAP,
+                            o_r,
+                            o_Sr);
+
+    //sum the element corrections and keep the Dirichlet nodes fixed
+    ogsGatherScatter(o_Sr, ogsDfloat, ogsAdd, elliptic->ogs);
+    if (elliptic->Nmasked) mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Sr);
+  } else if (packedPatches) {
+    elliptic->precon->approxBlockJacobiSolverPackedKernel(mesh->Nelements,
+                            o_patchesIndex,
+                            o_invAP,
+                            o_invDegreeAP,
                             o_r,
                             o_Sr);
+  } else {
+    elliptic->precon->approxBlockJacobiSolverKernel(mesh->Nelements,
+                            o_patchesIndex,
+                            o_invAP,
+                            o_invDegreeAP,
+                            o_r,
+                            o_Sr);
+  }
 }
 
 void MGLevel::smootherJacobi(occa::memory &o_r, occa::memory &o_Sr) {
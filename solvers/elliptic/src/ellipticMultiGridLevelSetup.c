@@ -28,6 +28,7 @@ SOFTWARE.
 
 size_t  MGLevel::smootherResidualBytes;
 dfloat* MGLevel::smootherResidual;
+occa::memory MGLevel::o_smootherWorkspace;
 occa::memory MGLevel::o_smootherResidual;
 occa::memory MGLevel::o_smootherResidual2;
 occa::memory MGLevel::o_smootherUpdate;
@@ -101,6 +102,9 @@ MGLevel::MGLevel(elliptic_t *ellipticBase, //finest level
 
 void MGLevel::setupSmoother() {
 
+  fastDiagonal = false;
+  packedPatches = 0;
+
   //set up the fine problem smoothing
   if(options.compareArgs("MULTIGRID SMOOTHER","LOCALPATCH")){
     smtype = LOCALPATCH;
@@ -116,14 +120,44 @@ void MGLevel::setupSmoother() {
       rateTolerance = 1.0;
     }
 
-    //initialize the full inverse operators on each 4 element patch
-    ellipticBuildLocalPatches(elliptic, lambda, rateTolerance, &Npatches, &patchesIndex, &invAP);
+    //approximate continuous quad/hex patches are inverted by fast diagonalisation
+    fastDiagonal = (rateTolerance>0.)
+                && options.compareArgs("DISCRETIZATION","CONTINUOUS")
+                && (elliptic->elementType==HEXAHEDRA
+                    || (elliptic->elementType==QUADRILATERALS && elliptic->dim==2));
+
+    dfloat *invDegree;
+    size_t patchBytes;
+
+    if (fastDiagonal) {
+      dfloat *fdmS, *fdmEigs, *fdmScales;
+      ellipticBuildFastDiagonal(elliptic, lambda, &fdmS, &fdmEigs, &fdmScales);
+
+      o_fdmS      = mesh->device.malloc(mesh->Nq*mesh->Nq*sizeof(dfloat), fdmS);
+      o_fdmEigs   = mesh->device.malloc(mesh->Nq*sizeof(dfloat), fdmEigs);
+      o_fdmScales = mesh->device.malloc(mesh->Nelements*(elliptic->dim+1)*sizeof(dfloat), fdmScales);
+      patchBytes  = (mesh->Nq*mesh->Nq + mesh->Nq + mesh->Nelements*(elliptic->dim+1))*sizeof(dfloat);
+
+      invDegree = (dfloat*) calloc(mesh->Nelements,sizeof(dfloat));
+      for (dlong e=0;e<mesh->Nelements;e++) invDegree[e] = 1.0;
 
-    o_invAP = mesh->device.malloc(Npatches*mesh->Np*mesh->Np*sizeof(dfloat),invAP);
-    o_patchesIndex = mesh->device.malloc(mesh->Nelements*sizeof(dlong), patchesIndex);
+      free(fdmS); free(fdmEigs); free(fdmScales);
+    } else {
+      //initialize the inverse operators on each patch, scaled per element
+      ellipticBuildLocalPatches(elliptic, lambda, rateTolerance, &Npatches, &patchesIndex, &invAP,
+                                &invDegree, &packedPatches);
+
+      size_t NpatchEntries = packedPatches ? mesh->Np*(mesh->Np+1)/2 : mesh->Np*mesh->Np;
+      patchBytes = Npatches*NpatchEntries*sizeof(dfloat);
+
+      o_invAP = mesh->device.malloc(patchBytes,invAP);
+      o_patchesIndex = mesh->device.malloc(mesh->Nelements*sizeof(dlong), patchesIndex);
+
+      free(invAP); free(patchesIndex);
+    }
 
-    dfloat *invDegree = (dfloat*) calloc(mesh->Nelements,sizeof(dfloat));
-    for (dlong e=0;e<mesh->Nelements;e++) invDegree[e] = 1.0;
+    if (mesh->rank==0)
+      printf("degree %d patch smoother storage: %g MB on rank 0\n", degree, patchBytes/1.e6);
 
     o_invDegreeAP = mesh->device.malloc(mesh->Nelements*sizeof(dfloat),invDegree);
 
@@ -153,7 +187,7 @@ void MGLevel::setupSmoother() {
       //update diagonal with weight
       o_invDegreeAP.copyFrom(invDegree);
     }
-    free(invDegree); free(invAP); free(patchesIndex);
+    free(invDegree);
 
   } else if (options.compareArgs("MULTIGRID SMOOTHER","DAMPEDJACOBI")) { //default to damped jacobi
     smtype = JACOBI;
@@ -212,6 +246,8 @@ void MGLevel::Report() {
     strcpy(smootherString, "Damped Jacobi   ");
   else if (stype==CHEBYSHEV&&smtype==JACOBI)
     strcpy(smootherString, "Chebyshev       ");
+  else if (stype==RICHARDSON&&smtype==LOCALPATCH&&fastDiagonal)
+    strcpy(smootherString, "Fast Diagonal   ");
   else if (stype==RICHARDSON&&smtype==LOCALPATCH)
     strcpy(smootherString, "Local Patch     ");
   else if (stype==RICHARDSON&&smtype==LOCALPATCH)
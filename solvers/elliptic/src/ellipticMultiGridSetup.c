@@ -247,6 +247,23 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
 
     if (mesh->rank==0)
       printf("--------------------------------------------------------------------------\n");
+
+    //bytes moved by the Chebyshev-Jacobi smoothers of the pMG levels in one V-cycle
+    long long int unfusedBytes = 0, fusedBytes = 0;
+    for(int lev=0; lev<numMGLevels; lev++) {
+      MGLevel *level = (MGLevel*) levels[lev];
+      if (level->stype!=CHEBYSHEV || level->smtype!=JACOBI) continue;
+      unfusedBytes += level->smoothBytes(false);
+      fusedBytes   += level->smoothBytes(true);
+    }
+
+    long long int totalUnfused = 0, totalFused = 0;
+    MPI_Allreduce(&unfusedBytes, &totalUnfused, 1, MPI_LONG_LONG_INT, MPI_SUM, mesh->comm);
+    MPI_Allreduce(&fusedBytes,   &totalFused,   1, MPI_LONG_LONG_INT, MPI_SUM, mesh->comm);
+
+    if ((mesh->rank==0)&&totalUnfused)
+      printf("pMG smoother vector traffic per V-cycle: %g MB fused, %g MB unfused (%4.1f%% saved)\n",
+             totalFused/1.e6, totalUnfused/1.e6, 100.*(totalUnfused-totalFused)/totalUnfused);
   }
 }
 
@@ -255,17 +272,16 @@ void MGLevelAllocateStorage(MGLevel *level, int k, parAlmond::CycleType ctype) {
   // extra storage for smoothing op
   size_t Nbytes = level->Ncols*sizeof(dfloat);
   if (MGLevel::smootherResidualBytes < Nbytes) {
-    if (MGLevel::o_smootherResidual.size()) {
+    if (MGLevel::o_smootherWorkspace.size()) {
       free(MGLevel::smootherResidual);
-      MGLevel::o_smootherResidual.free();
-      MGLevel::o_smootherResidual2.free();
-      MGLevel::o_smootherUpdate.free();
+      MGLevel::o_smootherWorkspace.free();
     }
 
-    MGLevel::smootherResidual = (dfloat *) calloc(level->Ncols,sizeof(dfloat));
-    MGLevel::o_smootherResidual = level->mesh->device.malloc(Nbytes,MGLevel::smootherResidual);
-    MGLevel::o_smootherResidual2 = level->mesh->device.malloc(Nbytes,MGLevel::smootherResidual);
-    MGLevel::o_smootherUpdate = level->mesh->device.malloc(Nbytes,MGLevel::smootherResidual);
+    MGLevel::smootherResidual = (dfloat *) calloc(3*level->Ncols,sizeof(dfloat));
+    MGLevel::o_smootherWorkspace = level->mesh->device.malloc(3*Nbytes,MGLevel::smootherResidual);
+    MGLevel::o_smootherResidual  = MGLevel::o_smootherWorkspace.slice(0*Nbytes, Nbytes);
+    MGLevel::o_smootherResidual2 = MGLevel::o_smootherWorkspace.slice(1*Nbytes, Nbytes);
+    MGLevel::o_smootherUpdate    = MGLevel::o_smootherWorkspace.slice(2*Nbytes, Nbytes);
     MGLevel::smootherResidualBytes = Nbytes;
   }
 
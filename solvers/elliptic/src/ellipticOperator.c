@@ -58,7 +58,8 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
     occa::kernel &partialAxKernel = (strstr(precision, "float")) ? elliptic->partialFloatAxKernel : elliptic->partialAxKernel;
     
     if(mesh->NglobalGatherElements) {
-      
+
+      kernelProfileStart(elliptic->profile);
       if(integrationType==0) { // GLL or non-hex
 	if(mapType==0)
 	  partialAxKernel(mesh->NglobalGatherElements, mesh->o_globalGatherElementList,
@@ -75,6 +76,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
 					  mesh->o_cubInterpT,
 					  lambda, o_q, o_Aq);
       }
+      kernelProfileStop(elliptic->profile, elliptic->profAxGlobal);
     }
 #else
 
@@ -85,6 +87,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
 
 #if 1
     if(mesh->NlocalGatherElements){
+      kernelProfileStart(elliptic->profile);
       if(integrationType==0) { // GLL or non-hex
 	if(mapType==0)
 	  partialAxKernel(mesh->NlocalGatherElements, mesh->o_localGatherElementList,
@@ -104,6 +107,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
 					  o_q,
 					  o_Aq);
       }
+      kernelProfileStop(elliptic->profile, elliptic->profAxLocal);
     }
 #endif
 
@@ -103,3 +103,61 @@ void ellipticPreconditionerSetup(elliptic_t *elliptic, ogs_t *ogs, dfloat lambda
     free(invDiagA);
   }
 }
+
+//update the preconditioner for a new lambda without rebuilding its structure
+void ellipticPreconditionerRefresh(elliptic_t *elliptic, dfloat lambda){
+
+  mesh2D *mesh = elliptic->mesh;
+  precon_t *precon = elliptic->precon;
+  setupAide options = elliptic->options;
+
+  //the projection pairs (x, A x) were built with the old lambda
+  elliptic->Nproj = 0;
+
+  if(options.compareArgs("PRECONDITIONER", "FULLALMOND")){ //same sparsity, new values
+    dlong nnz;
+    nonZero_t *A;
+
+    hlong *globalStarts = (hlong*) calloc(mesh->size+1, sizeof(hlong));
+
+    int basisNp = mesh->Np;
+    dfloat *basis = NULL;
+
+    if (options.compareArgs("BASIS", "BERN")) basis = mesh->VB;
+
+    if (options.compareArgs("DISCRETIZATION", "IPDG")) {
+      ellipticBuildIpdg(elliptic, basisNp, basis, lambda, &A, &nnz, globalStarts);
+    } else if (options.compareArgs("DISCRETIZATION", "CONTINUOUS")) {
+      ogs_t *ogs;
+      ellipticBuildContinuous(elliptic,lambda,&A,&nnz, &ogs, globalStarts);
+      ogsFree(ogs);
+    }
+
+    hlong *Rows = (hlong *) calloc(nnz, sizeof(hlong));
+    hlong *Cols = (hlong *) calloc(nnz, sizeof(hlong));
+    dfloat *Vals = (dfloat*) calloc(nnz,sizeof(dfloat));
+
+    for (dlong n=0;n<nnz;n++) {
+      Rows[n] = A[n].row;
+      Cols[n] = A[n].col;
+      Vals[n] = A[n].val;
+    }
+    free(A);
+    free(globalStarts);
+
+    parAlmond::AMGRefresh(precon->parAlmond, nnz, Rows, Cols, Vals);
+    free(Rows); free(Cols); free(Vals);
+
+  } else if(options.compareArgs("PRECONDITIONER", "JACOBI")) {
+
+    dfloat *invDiagA;
+    ellipticBuildJacobi(elliptic,lambda,&invDiagA);
+    precon->o_invDiagA.copyFrom(invDiagA, mesh->Np*mesh->Nelements*sizeof(dfloat), 0);
+    free(invDiagA);
+
+  } else {
+    if (mesh->rank==0)
+      printf("WARNING: %s preconditioner has no numeric refresh, keeping the old lambda\n",
+             (char*) options.getArgs("PRECONDITIONER").c_str());
+  }
+}
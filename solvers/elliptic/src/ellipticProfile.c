@@ -0,0 +1,69 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// register the Ax and PCG update kernels with their analytic per-launch traffic and work.
+// The profile belongs to the calling solver; prefix tells apart solves that share it.
+void ellipticProfileSetup(elliptic_t *elliptic, kernelProfile_t *profile, const char *prefix){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  elliptic->profile = profile;
+
+  const double sz  = sizeof(dfloat);
+  const double isz = sizeof(dlong);
+
+  const int affine = (elliptic->elementType==TRIANGLES || elliptic->elementType==TETRAHEDRA);
+
+  const double Np  = mesh->Np;
+  const double dim = elliptic->dim;
+
+  // Ax per element: read q and the geometric factors, write Aq. Affine elements apply
+  // the dense stiffness and mass matrices, tensor product elements differentiate
+  // along lines, apply the geometric factors and take the transposed derivatives.
+  const double AxBytes = isz + sz*(2*Np + mesh->Nggeo*(affine ? 1 : Np));
+  const double AxFlops = affine ? 2*Np*Np*(dim*(dim+1)/2 + 1)
+                                : Np*(4*dim*mesh->Nq + dim*(2*dim-1) + 2);
+
+  char name[BUFSIZ];
+
+  sprintf(name, "%sellipticAxGlobal", prefix);
+  elliptic->profAxGlobal = kernelProfileRegister(profile, name,
+                                                 mesh->NglobalGatherElements*AxBytes,
+                                                 mesh->NglobalGatherElements*AxFlops);
+
+  sprintf(name, "%sellipticAxLocal", prefix);
+  elliptic->profAxLocal = kernelProfileRegister(profile, name,
+                                                mesh->NlocalGatherElements*AxBytes,
+                                                mesh->NlocalGatherElements*AxFlops);
+
+  // PCG update: read invDegree, p, Ap, x, r and write x, r; two axpys and a weighted norm
+  const double Ntotal = mesh->Nelements*Np;
+
+  sprintf(name, "%sellipticUpdatePCG", prefix);
+  elliptic->profUpdatePCG = kernelProfileRegister(profile, name, 7*sz*Ntotal, 7*Ntotal);
+}
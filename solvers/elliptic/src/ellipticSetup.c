@@ -272,15 +272,10 @@ elliptic_t *ellipticSetup(mesh_t *mesh, dfloat lambda, occa::properties &kernelI
   //add boundary condition contribution to rhs
   if (options.compareArgs("DISCRETIZATION","IPDG") && 
       !(elliptic->dim==3 && elliptic->elementType==QUADRILATERALS) ) {
-    for(int r=0;r<mesh->size;++r){
-      if(r==mesh->rank){
-	sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBCIpdg%s.okl", suffix);
-	sprintf(kernelName, "ellipticRhsBCIpdg%s", suffix);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBCIpdg%s.okl", suffix);
+    sprintf(kernelName, "ellipticRhsBCIpdg%s", suffix);
 
-	elliptic->rhsBCIpdgKernel = mesh->device.buildKernel(fileName,kernelName, kernelInfo);
-      }
-      MPI_Barrier(mesh->comm);
-    }
+    elliptic->rhsBCIpdgKernel = kernelBuild(elliptic->builder, fileName,kernelName, kernelInfo);
     dfloat zero = 0.f;
     elliptic->rhsBCIpdgKernel(mesh->Nelements,
 			      mesh->o_vmapM,
@@ -300,20 +295,15 @@ elliptic_t *ellipticSetup(mesh_t *mesh, dfloat lambda, occa::properties &kernelI
 
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS") &&
        !(elliptic->dim==3 && elliptic->elementType==QUADRILATERALS) ) {
-    for(int r=0;r<mesh->size;++r){
-      if(r==mesh->rank){
-	sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBC%s.okl", suffix);
-        sprintf(kernelName, "ellipticRhsBC%s", suffix);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBC%s.okl", suffix);
+    sprintf(kernelName, "ellipticRhsBC%s", suffix);
 
-        elliptic->rhsBCKernel = mesh->device.buildKernel(fileName,kernelName, kernelInfo);
+    elliptic->rhsBCKernel = kernelBuild(elliptic->builder, fileName,kernelName, kernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticAddBC%s.okl", suffix);
-        sprintf(kernelName, "ellipticAddBC%s", suffix);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticAddBC%s.okl", suffix);
+    sprintf(kernelName, "ellipticAddBC%s", suffix);
 
-        elliptic->addBCKernel = mesh->device.buildKernel(fileName,kernelName, kernelInfo);
-      }
-      MPI_Barrier(mesh->comm);
-    }
+    elliptic->addBCKernel = kernelBuild(elliptic->builder, fileName,kernelName, kernelInfo);
 
     dfloat zero = 0.f, mone = -1.0f, one = 1.0f;
     if(options.compareArgs("ELLIPTIC INTEGRATION", "NODAL")){
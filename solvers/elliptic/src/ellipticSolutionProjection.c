@@ -0,0 +1,134 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Fischer's projection: the initial guess is the A-orthogonal projection of
+// the solution onto the span of the last NprojMax solutions
+
+// dots[k] = (X_k, y) for k<Nvectors, with one global reduction
+static void ellipticProjectionDots(elliptic_t *elliptic, int Nvectors, occa::memory &o_X,
+                                   occa::memory &o_y, dfloat *dots){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+  dlong Nblocks = elliptic->NblocksUpdatePCG;
+
+  int weighted = elliptic->options.compareArgs("DISCRETIZATION","CONTINUOUS") ? 1 : 0;
+
+  elliptic->projectionDotsKernel(Ntotal, Nblocks, Nvectors, Ntotal, weighted,
+                                 elliptic->o_invDegree, o_X, o_y, elliptic->o_projDots);
+
+  elliptic->o_projDots.copyTo(elliptic->projDots, Nvectors*Nblocks*sizeof(dfloat), 0);
+
+  for(int k=0;k<Nvectors;++k){
+    elliptic->projLocal[k] = 0;
+    for(dlong n=0;n<Nblocks;++n)
+      elliptic->projLocal[k] += elliptic->projDots[n+k*Nblocks];
+  }
+
+  MPI_Allreduce(elliptic->projLocal, dots, Nvectors, MPI_DFLOAT, MPI_SUM, mesh->comm);
+}
+
+// y = beta*y + sum_k alpha[k] X_k
+static void ellipticProjectionCombine(elliptic_t *elliptic, int Nvectors, dfloat *alpha,
+                                      dfloat beta, occa::memory &o_X, occa::memory &o_y){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  elliptic->o_projAlpha.copyFrom(alpha, Nvectors*sizeof(dfloat), 0);
+
+  elliptic->projectionCombineKernel(Ntotal, Nvectors, Ntotal, elliptic->o_projAlpha,
+                                    beta, o_X, o_y);
+}
+
+void ellipticProjectionPreSolve(elliptic_t *elliptic, occa::memory &o_r, occa::memory &o_x){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  // with an empty basis the incoming guess is kept
+  if (elliptic->Nproj>0) {
+    // the basis is A-orthonormal so alpha_k = (X_k, A x) = (X_k, b) and
+    // pcg forms the remaining residual r = b - A x itself
+    ellipticProjectionDots(elliptic, elliptic->Nproj, elliptic->o_projX,
+                           o_r, elliptic->projAlpha);
+
+    ellipticProjectionCombine(elliptic, elliptic->Nproj, elliptic->projAlpha, 0.,
+                              elliptic->o_projX, o_x);
+  }
+
+  o_x.copyTo(elliptic->o_projX0, Ntotal*sizeof(dfloat), 0, 0);
+}
+
+void ellipticProjectionPostSolve(elliptic_t *elliptic, dfloat lambda, occa::memory &o_x){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  occa::memory &o_e  = elliptic->o_projE;
+  occa::memory &o_Ae = elliptic->o_projAE;
+
+  // full basis: restart from the latest solution alone
+  o_x.copyTo(o_e, Ntotal*sizeof(dfloat), 0, 0);
+  if (elliptic->Nproj==elliptic->NprojMax)
+    elliptic->Nproj = 0;
+  else
+    ellipticScaledAdd(elliptic, -1., elliptic->o_projX0, 1., o_e);
+
+  ellipticOperator(elliptic, lambda, o_e, o_Ae, dfloatString);
+
+  // two passes of classical Gram-Schmidt in the A inner product
+  int Nproj = elliptic->Nproj;
+  if (Nproj>0) {
+    for(int pass=0;pass<2;++pass){
+      ellipticProjectionDots(elliptic, Nproj, elliptic->o_projX, o_Ae, elliptic->projAlpha);
+
+      for(int k=0;k<Nproj;++k) elliptic->projAlpha[k] *= -1.;
+
+      ellipticProjectionCombine(elliptic, Nproj, elliptic->projAlpha, 1., elliptic->o_projX,  o_e);
+      ellipticProjectionCombine(elliptic, Nproj, elliptic->projAlpha, 1., elliptic->o_projAX, o_Ae);
+    }
+  }
+
+  dfloat norm2 = 0;
+  ellipticProjectionDots(elliptic, 1, o_e, o_Ae, &norm2);
+
+  // drop directions already (numerically) in the span
+  if (norm2>0) {
+    dfloat invNorm = 1./sqrt(norm2);
+
+    occa::memory o_Xk  = elliptic->o_projX  + Nproj*Ntotal*sizeof(dfloat);
+    occa::memory o_AXk = elliptic->o_projAX + Nproj*Ntotal*sizeof(dfloat);
+
+    // beta=0 so unwritten slots are never read
+    ellipticProjectionCombine(elliptic, 1, &invNorm, 0., o_e,  o_Xk);
+    ellipticProjectionCombine(elliptic, 1, &invNorm, 0., o_Ae, o_AXk);
+
+    elliptic->Nproj++;
+  }
+}
@@ -44,7 +44,17 @@ int ellipticSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol,
   }
 #endif
   
-  Niter = pcg (elliptic, lambda, o_r, o_x, tol, maxIter);
+  // best initial guess in the span of previous solutions
+  if (elliptic->NprojMax) ellipticProjectionPreSolve(elliptic, o_r, o_x);
+
+  if (options.compareArgs("KRYLOV SOLVER", "PIPELINED"))
+    Niter = pipelinedPcg (elliptic, lambda, o_r, o_x, tol, maxIter);
+  else if (options.compareArgs("KRYLOV SOLVER", "SINGLEREDUCTION"))
+    Niter = singleReductionPcg (elliptic, lambda, o_r, o_x, tol, maxIter);
+  else
+    Niter = pcg (elliptic, lambda, o_r, o_x, tol, maxIter);
+
+  if (elliptic->NprojMax) ellipticProjectionPostSolve(elliptic, lambda, o_x);
 
 #if 0
   if(options.compareArgs("VERBOSE","TRUE")){
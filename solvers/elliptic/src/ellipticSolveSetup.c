@@ -32,6 +32,10 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   mesh_t *mesh = elliptic->mesh;
   setupAide options = elliptic->options;
 
+  // solvers that embed the elliptic solve hand over their own builder
+  if (!elliptic->builder)
+    elliptic->builder = kernelBuilderSetup(mesh->device, mesh->comm, options);
+
   //sanity checking
   if (options.compareArgs("BASIS","BERN") && elliptic->elementType!=TRIANGLES) {
     printf("ERROR: BERN basis is only available for triangular elements\n");
@@ -96,6 +100,43 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   elliptic->tmpNormr = (dfloat*) calloc(elliptic->NblocksUpdatePCG,sizeof(dfloat));
   elliptic->o_tmpNormr = mesh->device.malloc(elliptic->NblocksUpdatePCG*sizeof(dfloat), elliptic->tmpNormr);
 
+  if (options.compareArgs("KRYLOV SOLVER", "PIPELINED") ||
+      options.compareArgs("KRYLOV SOLVER", "SINGLEREDUCTION")) {
+    elliptic->o_u = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_w = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_s = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+
+    if (options.compareArgs("KRYLOV SOLVER", "PIPELINED")) {
+      elliptic->o_m = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+      elliptic->o_n = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+      elliptic->o_q = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    }
+
+    elliptic->tmpDots = (dfloat*) calloc(3*elliptic->NblocksUpdatePCG,sizeof(dfloat));
+    elliptic->o_tmpDots = mesh->device.malloc(3*elliptic->NblocksUpdatePCG*sizeof(dfloat), elliptic->tmpDots);
+  }
+
+  // number of previous solutions kept for projected initial guesses
+  elliptic->NprojMax = 0;
+  elliptic->Nproj = 0;
+  options.getArgs("SOLUTION PROJECTION", elliptic->NprojMax);
+  if (elliptic->NprojMax>0) {
+    int NprojMax = elliptic->NprojMax;
+    dlong Nblocks = elliptic->NblocksUpdatePCG;
+
+    elliptic->o_projX  = mesh->device.malloc(NprojMax*Ntotal*sizeof(dfloat));
+    elliptic->o_projAX = mesh->device.malloc(NprojMax*Ntotal*sizeof(dfloat));
+    elliptic->o_projX0 = mesh->device.malloc(Ntotal*sizeof(dfloat));
+    elliptic->o_projE  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_projAE = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+
+    elliptic->projAlpha = (dfloat*) calloc(NprojMax, sizeof(dfloat));
+    elliptic->projLocal = (dfloat*) calloc(NprojMax, sizeof(dfloat));
+    elliptic->projDots  = (dfloat*) calloc(NprojMax*Nblocks, sizeof(dfloat));
+    elliptic->o_projAlpha = mesh->device.malloc(NprojMax*sizeof(dfloat), elliptic->projAlpha);
+    elliptic->o_projDots  = mesh->device.malloc(NprojMax*Nblocks*sizeof(dfloat), elliptic->projDots);
+  }
+
 
   elliptic->o_grad  = mesh->device.malloc(Nall*4*sizeof(dfloat), elliptic->grad);
 
@@ -310,252 +351,291 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
+  //mesh kernels
+  mesh->haloExtractKernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/meshHaloExtract2D.okl",
+                                   "meshHaloExtract2D",
+                                   kernelInfo);
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  mesh->addScalarKernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/addScalar.okl",
+               "addScalar",
+               kernelInfo);
 
-      //mesh kernels
-      mesh->haloExtractKernel =
-        mesh->device.buildKernel(DHOLMES "/okl/meshHaloExtract2D.okl",
-                                       "meshHaloExtract2D",
-                                       kernelInfo);
+  mesh->maskKernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/mask.okl",
+               "mask",
+               kernelInfo);
 
-      mesh->addScalarKernel =
-        mesh->device.buildKernel(DHOLMES "/okl/addScalar.okl",
-                   "addScalar",
-                   kernelInfo);
 
-      mesh->maskKernel =
-        mesh->device.buildKernel(DHOLMES "/okl/mask.okl",
-                   "mask",
-                   kernelInfo);
+  kernelInfo["defines/" "p_blockSize"]= blockSize;
 
 
-      kernelInfo["defines/" "p_blockSize"]= blockSize;
+  mesh->sumKernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/sum.okl",
+               "sum",
+               kernelInfo);
 
+  elliptic->weightedInnerProduct1Kernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/weightedInnerProduct1.okl",
+                                   "weightedInnerProduct1",
+                                   kernelInfo);
 
-      mesh->sumKernel =
-        mesh->device.buildKernel(DHOLMES "/okl/sum.okl",
-                   "sum",
-                   kernelInfo);
+  elliptic->weightedInnerProduct2Kernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/weightedInnerProduct2.okl",
+                                   "weightedInnerProduct2",
+                                   kernelInfo);
 
-      elliptic->weightedInnerProduct1Kernel =
-        mesh->device.buildKernel(DHOLMES "/okl/weightedInnerProduct1.okl",
-                                       "weightedInnerProduct1",
-                                       kernelInfo);
+  elliptic->innerProductKernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/innerProduct.okl",
+                                   "innerProduct",
+                                   kernelInfo);
 
-      elliptic->weightedInnerProduct2Kernel =
-        mesh->device.buildKernel(DHOLMES "/okl/weightedInnerProduct2.okl",
-                                       "weightedInnerProduct2",
+  elliptic->weightedNorm2Kernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/weightedNorm2.okl",
+                                       "weightedNorm2",
                                        kernelInfo);
 
-      elliptic->innerProductKernel =
-        mesh->device.buildKernel(DHOLMES "/okl/innerProduct.okl",
-                                       "innerProduct",
+  elliptic->norm2Kernel =
+    kernelBuild(elliptic->builder, DHOLMES "/okl/norm2.okl",
+                                       "norm2",
                                        kernelInfo);
 
-      elliptic->weightedNorm2Kernel =
-        mesh->device.buildKernel(DHOLMES "/okl/weightedNorm2.okl",
-                                           "weightedNorm2",
-                                           kernelInfo);
 
-      elliptic->norm2Kernel =
-        mesh->device.buildKernel(DHOLMES "/okl/norm2.okl",
-                                           "norm2",
-                                           kernelInfo);
+  elliptic->scaledAddKernel =
+      kernelBuild(elliptic->builder, DHOLMES "/okl/scaledAdd.okl",
+                                     "scaledAdd",
+                                     kernelInfo);
 
+  elliptic->dotMultiplyKernel =
+      kernelBuild(elliptic->builder, DHOLMES "/okl/dotMultiply.okl",
+                                     "dotMultiply",
+                                     kernelInfo);
 
-      elliptic->scaledAddKernel =
-          mesh->device.buildKernel(DHOLMES "/okl/scaledAdd.okl",
-                                         "scaledAdd",
-                                         kernelInfo);
+  elliptic->dotDivideKernel =
+      kernelBuild(elliptic->builder, DHOLMES "/okl/dotDivide.okl",
+                                     "dotDivide",
+                                     kernelInfo);
 
-      elliptic->dotMultiplyKernel =
-          mesh->device.buildKernel(DHOLMES "/okl/dotMultiply.okl",
-                                         "dotMultiply",
-                                         kernelInfo);
+  // add custom defines
+  kernelInfo["defines/" "p_NpP"]= (mesh->Np+mesh->Nfp*mesh->Nfaces);
+  kernelInfo["defines/" "p_Nverts"]= mesh->Nverts;
 
-      elliptic->dotDivideKernel =
-          mesh->device.buildKernel(DHOLMES "/okl/dotDivide.okl",
-                                         "dotDivide",
-                                         kernelInfo);
+  //sizes for the coarsen and prolongation kernels. degree N to degree 1
+  kernelInfo["defines/" "p_NpFine"]= mesh->Np;
+  kernelInfo["defines/" "p_NpCoarse"]= mesh->Nverts;
 
-      // add custom defines
-      kernelInfo["defines/" "p_NpP"]= (mesh->Np+mesh->Nfp*mesh->Nfaces);
-      kernelInfo["defines/" "p_Nverts"]= mesh->Nverts;
 
-      //sizes for the coarsen and prolongation kernels. degree N to degree 1
-      kernelInfo["defines/" "p_NpFine"]= mesh->Np;
-      kernelInfo["defines/" "p_NpCoarse"]= mesh->Nverts;
+  if (elliptic->elementType==QUADRILATERALS || elliptic->elementType==HEXAHEDRA) {
+    kernelInfo["defines/" "p_NqFine"]= mesh->N+1;
+    kernelInfo["defines/" "p_NqCoarse"]= 2;
+  }
 
+  kernelInfo["defines/" "p_NpFEM"]= mesh->NpFEM;
 
-      if (elliptic->elementType==QUADRILATERALS || elliptic->elementType==HEXAHEDRA) {
-        kernelInfo["defines/" "p_NqFine"]= mesh->N+1;
-        kernelInfo["defines/" "p_NqCoarse"]= 2;
-      }
+  int Nmax = mymax(mesh->Np, mesh->Nfaces*mesh->Nfp);
+  kernelInfo["defines/" "p_Nmax"]= Nmax;
 
-      kernelInfo["defines/" "p_NpFEM"]= mesh->NpFEM;
+  int maxNodes = mymax(mesh->Np, (mesh->Nfp*mesh->Nfaces));
+  kernelInfo["defines/" "p_maxNodes"]= maxNodes;
 
-      int Nmax = mymax(mesh->Np, mesh->Nfaces*mesh->Nfp);
-      kernelInfo["defines/" "p_Nmax"]= Nmax;
+  int NblockV = mymax(1,maxNthreads/mesh->Np); // works for CUDA
+  int NnodesV = 1; //hard coded for now
+  kernelInfo["defines/" "p_NblockV"]= NblockV;
+  kernelInfo["defines/" "p_NnodesV"]= NnodesV;
+  kernelInfo["defines/" "p_NblockVFine"]= NblockV;
+  kernelInfo["defines/" "p_NblockVCoarse"]= NblockV;
 
-      int maxNodes = mymax(mesh->Np, (mesh->Nfp*mesh->Nfaces));
-      kernelInfo["defines/" "p_maxNodes"]= maxNodes;
+  int NblockS = mymax(1,maxNthreads/maxNodes); // works for CUDA
+  kernelInfo["defines/" "p_NblockS"]= NblockS;
 
-      int NblockV = mymax(1,maxNthreads/mesh->Np); // works for CUDA
-      int NnodesV = 1; //hard coded for now
-      kernelInfo["defines/" "p_NblockV"]= NblockV;
-      kernelInfo["defines/" "p_NnodesV"]= NnodesV;
-      kernelInfo["defines/" "p_NblockVFine"]= NblockV;
-      kernelInfo["defines/" "p_NblockVCoarse"]= NblockV;
+  int NblockP = mymax(1,maxNthreads/(4*mesh->Np)); // get close to maxNthreads threads
+  kernelInfo["defines/" "p_NblockP"]= NblockP;
 
-      int NblockS = mymax(1,maxNthreads/maxNodes); // works for CUDA
-      kernelInfo["defines/" "p_NblockS"]= NblockS;
+  int NblockG;
+  if(mesh->Np<=32) NblockG = ( 32/mesh->Np );
+  else NblockG = maxNthreads/mesh->Np;
+  kernelInfo["defines/" "p_NblockG"]= NblockG;
 
-      int NblockP = mymax(1,maxNthreads/(4*mesh->Np)); // get close to maxNthreads threads
-      kernelInfo["defines/" "p_NblockP"]= NblockP;
+  kernelInfo["defines/" "p_halfC"]= (int)((mesh->cubNq+1)/2);
+  kernelInfo["defines/" "p_halfN"]= (int)((mesh->Nq+1)/2);
 
-      int NblockG;
-      if(mesh->Np<=32) NblockG = ( 32/mesh->Np );
-      else NblockG = maxNthreads/mesh->Np;
-      kernelInfo["defines/" "p_NblockG"]= NblockG;
+  kernelInfo["defines/" "p_NthreadsUpdatePCG"] = (int) NthreadsUpdatePCG; // WARNING SHOULD BE MULTIPLE OF 32
+  kernelInfo["defines/" "p_NwarpsUpdatePCG"] = (int) (NthreadsUpdatePCG/32); // WARNING: CUDA SPECIFIC
 
-      kernelInfo["defines/" "p_halfC"]= (int)((mesh->cubNq+1)/2);
-      kernelInfo["defines/" "p_halfN"]= (int)((mesh->Nq+1)/2);
+  cout << kernelInfo ;
 
-      kernelInfo["defines/" "p_NthreadsUpdatePCG"] = (int) NthreadsUpdatePCG; // WARNING SHOULD BE MULTIPLE OF 32
-      kernelInfo["defines/" "p_NwarpsUpdatePCG"] = (int) (NthreadsUpdatePCG/32); // WARNING: CUDA SPECIFIC
+  //add standard boundary functions
+  char *boundaryHeaderFileName;
+  if (elliptic->dim==2)
+    boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary2D.h");
+  else if (elliptic->dim==3)
+    boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary3D.h");
+  kernelInfo["includes"] += boundaryHeaderFileName;
 
-      cout << kernelInfo ;
 
-      //add standard boundary functions
-      char *boundaryHeaderFileName;
-      if (elliptic->dim==2)
-        boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary2D.h");
-      else if (elliptic->dim==3)
-        boundaryHeaderFileName = strdup(DELLIPTIC "/data/ellipticBoundary3D.h");
-      kernelInfo["includes"] += boundaryHeaderFileName;
+  sprintf(fileName,  DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
+  sprintf(kernelName, "ellipticAx%s", suffix);
 
+  occa::properties dfloatKernelInfo = kernelInfo;
+  occa::properties floatKernelInfo = kernelInfo;
+  floatKernelInfo["defines/" "pfloat"]= "float";
+  dfloatKernelInfo["defines/" "pfloat"]= dfloatString;
 
-      sprintf(fileName,  DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
-      sprintf(kernelName, "ellipticAx%s", suffix);
+  elliptic->AxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
 
-      occa::properties dfloatKernelInfo = kernelInfo;
-      occa::properties floatKernelInfo = kernelInfo;
-      floatKernelInfo["defines/" "pfloat"]= "float";
-      dfloatKernelInfo["defines/" "pfloat"]= dfloatString;
+  if(elliptic->elementType!=HEXAHEDRA){
+    sprintf(kernelName, "ellipticPartialAx%s", suffix);
+  }
+  else{
+    if(elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR")){
+      sprintf(kernelName, "ellipticPartialAxTrilinear%s", suffix);
+    }else{
+      sprintf(kernelName, "ellipticPartialAx%s", suffix);
+    }
+  }
 
-      elliptic->AxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
+  elliptic->partialAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
+  elliptic->partialFloatAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,floatKernelInfo);
 
-      if(elliptic->elementType!=HEXAHEDRA){
-        sprintf(kernelName, "ellipticPartialAx%s", suffix);
-      }
-      else{
-        if(elliptic->options.compareArgs("ELEMENT MAP", "TRILINEAR")){
-          sprintf(kernelName, "ellipticPartialAxTrilinear%s", suffix);
-        }else{
-          sprintf(kernelName, "ellipticPartialAx%s", suffix);
-        }
-      }
+  // only for Hex3D - cubature Ax
+  if(elliptic->elementType==HEXAHEDRA){
+    printf("BUILDING partialCubatureAxKernel\n");
+    sprintf(fileName,  DELLIPTIC "/okl/ellipticCubatureAx%s.okl", suffix);
 
-      elliptic->partialAxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
-      elliptic->partialFloatAxKernel = mesh->device.buildKernel(fileName,kernelName,floatKernelInfo);
+    sprintf(kernelName, "ellipticCubaturePartialAx%s", suffix);
+    elliptic->partialCubatureAxKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
+  }
 
-      // only for Hex3D - cubature Ax
-      if(elliptic->elementType==HEXAHEDRA){
-	printf("BUILDING partialCubatureAxKernel\n");
-	sprintf(fileName,  DELLIPTIC "/okl/ellipticCubatureAx%s.okl", suffix);
+  if (elliptic->elementType==HEXAHEDRA ||
+      (elliptic->elementType==QUADRILATERALS && elliptic->dim==2)) {
+    sprintf(fileName, DELLIPTIC "/okl/ellipticBuildDiag%s.okl", suffix);
+    sprintf(kernelName, "ellipticBuildDiag%s", suffix);
+    elliptic->buildDiagKernel = kernelBuild(elliptic->builder, fileName,kernelName,dfloatKernelInfo);
+  }
 
-	sprintf(kernelName, "ellipticCubaturePartialAx%s", suffix);
-	elliptic->partialCubatureAxKernel = mesh->device.buildKernel(fileName,kernelName,dfloatKernelInfo);
-      }
+  // combined PCG update and r.r kernel
 
-      // combined PCG update and r.r kernel
+  elliptic->updatePCGKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticUpdatePCG.okl",
+                             "ellipticUpdatePCG", dfloatKernelInfo);
 
-      elliptic->updatePCGKernel =
-	mesh->device.buildKernel(DELLIPTIC "/okl/ellipticUpdatePCG.okl",
-				 "ellipticUpdatePCG", dfloatKernelInfo);
+  // fused reductions and recurrences for pipelined / single reduction PCG
+  elliptic->pipelinedDotsPCGKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticPipelinedPCG.okl",
+                             "ellipticPipelinedDotsPCG", dfloatKernelInfo);
 
+  elliptic->pipelinedUpdatePCGKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticPipelinedPCG.okl",
+                             "ellipticPipelinedUpdatePCG", dfloatKernelInfo);
 
-      // Not implemented for Quad3D !!!!!
-      if (options.compareArgs("BASIS","BERN")) {
+  elliptic->singleReductionUpdatePCGKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticPipelinedPCG.okl",
+                             "ellipticSingleReductionUpdatePCG", dfloatKernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticGradientBB%s.okl", suffix);
-        sprintf(kernelName, "ellipticGradientBB%s", suffix);
+  elliptic->chebyshevJacobiStartKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticChebyshevJacobi.okl",
+                             "ellipticChebyshevJacobiStart", dfloatKernelInfo);
 
-        elliptic->gradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  elliptic->chebyshevJacobiUpdateKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticChebyshevJacobi.okl",
+                             "ellipticChebyshevJacobiUpdate", dfloatKernelInfo);
 
-        sprintf(kernelName, "ellipticPartialGradientBB%s", suffix);
-        elliptic->partialGradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  elliptic->projectionDotsKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticSolutionProjection.okl",
+                             "ellipticProjectionDots", dfloatKernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdgBB%s.okl", suffix);
-        sprintf(kernelName, "ellipticAxIpdgBB%s", suffix);
-        elliptic->ipdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  elliptic->projectionCombineKernel =
+    kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticSolutionProjection.okl",
+                             "ellipticProjectionCombine", dfloatKernelInfo);
 
-        sprintf(kernelName, "ellipticPartialAxIpdgBB%s", suffix);
-        elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      } else if (options.compareArgs("BASIS","NODAL")) {
+  // Not implemented for Quad3D !!!!!
+  if (options.compareArgs("BASIS","BERN")) {
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticGradient%s.okl", suffix);
-        sprintf(kernelName, "ellipticGradient%s", suffix);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticGradientBB%s.okl", suffix);
+    sprintf(kernelName, "ellipticGradientBB%s", suffix);
 
-        elliptic->gradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    elliptic->gradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(kernelName, "ellipticPartialGradient%s", suffix);
-        elliptic->partialGradientKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(kernelName, "ellipticPartialGradientBB%s", suffix);
+    elliptic->partialGradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdg%s.okl", suffix);
-        sprintf(kernelName, "ellipticAxIpdg%s", suffix);
-        elliptic->ipdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdgBB%s.okl", suffix);
+    sprintf(kernelName, "ellipticAxIpdgBB%s", suffix);
+    elliptic->ipdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        sprintf(kernelName, "ellipticPartialAxIpdg%s", suffix);
-        elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
-      }
+    sprintf(kernelName, "ellipticPartialAxIpdgBB%s", suffix);
+    elliptic->partialIpdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      // Use the same kernel with quads for the following kenels
-      if(elliptic->dim==3){
-	if(elliptic->elementType==QUADRILATERALS)
-	  suffix = strdup("Quad2D");
-	else if(elliptic->elementType==TRIANGLES)
-	  suffix = strdup("Tri2D");
-      }
+  } else if (options.compareArgs("BASIS","NODAL")) {
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
-      elliptic->precon->coarsenKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(fileName, DELLIPTIC "/okl/ellipticGradient%s.okl", suffix);
+    sprintf(kernelName, "ellipticGradient%s", suffix);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
-      elliptic->precon->prolongateKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    elliptic->gradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
+    sprintf(kernelName, "ellipticPartialGradient%s", suffix);
+    elliptic->partialGradientKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
+    sprintf(fileName, DELLIPTIC "/okl/ellipticAxIpdg%s.okl", suffix);
+    sprintf(kernelName, "ellipticAxIpdg%s", suffix);
+    elliptic->ipdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
-      sprintf(kernelName, "ellipticBlockJacobiPrecon");
-      elliptic->precon->blockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+    sprintf(kernelName, "ellipticPartialAxIpdg%s", suffix);
+    elliptic->partialIpdgKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+  }
 
-      sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
-      elliptic->precon->partialblockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  // Use the same kernel with quads for the following kenels
+  if(elliptic->dim==3){
+    if(elliptic->elementType==QUADRILATERALS)
+      suffix = strdup("Quad2D");
+    else if(elliptic->elementType==TRIANGLES)
+      suffix = strdup("Tri2D");
+  }
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
-      sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
-      elliptic->precon->approxBlockJacobiSolverKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
+  sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
+  elliptic->precon->coarsenKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-      if (   elliptic->elementType == TRIANGLES
-          || elliptic->elementType == TETRAHEDRA) {
-        elliptic->precon->SEMFEMInterpKernel =
-          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
-                     "ellipticSEMFEMInterp",
-                     kernelInfo);
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
+  sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
+  elliptic->precon->prolongateKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
 
-        elliptic->precon->SEMFEMAnterpKernel =
-          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
-                     "ellipticSEMFEMAnterp",
-                     kernelInfo);
-      }
-    }
-    MPI_Barrier(mesh->comm);
+
+
+  sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
+  sprintf(kernelName, "ellipticBlockJacobiPrecon");
+  elliptic->precon->blockJacobiKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
+  elliptic->precon->partialblockJacobiKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
+  sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
+  elliptic->precon->approxBlockJacobiSolverKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  sprintf(kernelName, "ellipticApproxBlockJacobiSolverPacked");
+  elliptic->precon->approxBlockJacobiSolverPackedKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+
+  if (elliptic->elementType==HEXAHEDRA ||
+      (elliptic->elementType==QUADRILATERALS && elliptic->dim==2)) {
+    sprintf(fileName, DELLIPTIC "/okl/ellipticFastDiagonal%s.okl", suffix);
+    sprintf(kernelName, "ellipticFastDiagonal%s", suffix);
+    elliptic->precon->fastDiagonalKernel = kernelBuild(elliptic->builder, fileName,kernelName,kernelInfo);
+  }
+
+  if (   elliptic->elementType == TRIANGLES
+      || elliptic->elementType == TETRAHEDRA) {
+    elliptic->precon->SEMFEMInterpKernel =
+      kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
+                 "ellipticSEMFEMInterp",
+                 kernelInfo);
+
+    elliptic->precon->SEMFEMAnterpKernel =
+      kernelBuild(elliptic->builder, DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
+                 "ellipticSEMFEMAnterp",
+                 kernelInfo);
   }
 
   long long int pre = mesh->device.memoryAllocated();
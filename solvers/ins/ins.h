@@ -60,6 +60,8 @@ typedef struct {
   dfloat time;
   int tstep, frame;
   dfloat g0, ig0, lambda;      // helmhotz solver -lap(u) + lamda u
+  dfloat preconLambda;         // lambda the velocity preconditioners were built for
+  double velocitySetupTime;    // wall time of the velocity solver setup
   dfloat startTime;   
   dfloat finalTime;   
 
@@ -75,6 +77,7 @@ typedef struct {
   int ARKswitch;
   
   int NiterU, NiterV, NiterW, NiterP;
+  int blockVelocitySolve; // U, V and W solved together by uSolver's block PCG
 
 
   //solver tolerances
@@ -163,11 +166,19 @@ typedef struct {
   occa::kernel constrainKernel;
   
   occa::memory o_U, o_P;
+
+  // EXTBDF history levels live in a ring of Nstages+1 slots of o_U, o_P,
+  // o_NU and o_GP: level s is in slot historyIndex[s] and the spare slot
+  // historyIndex[Nstages] holds the new rkU/rkP
+  int *historyIndex;
+  occa::memory o_historyIndex;
   occa::memory o_rhsU, o_rhsV, o_rhsW, o_rhsP; 
+  occa::memory o_rhsUVW; // packed storage behind o_rhsU, o_rhsV, o_rhsW
 
   occa::memory o_NU, o_LU, o_GP;
   occa::memory o_GU;
 
+  occa::memory o_UVWH; // packed storage behind o_UH, o_VH, o_WH
   occa::memory o_UH, o_VH, o_WH;
   occa::memory o_rkU, o_rkP, o_PI;
   occa::memory o_rkNU, o_rkLU, o_rkGP;
@@ -175,6 +186,7 @@ typedef struct {
   occa::memory o_Vort, o_Div;
 
   occa::memory o_vHaloBuffer, o_pHaloBuffer; 
+  meshHalo_t *vHalo; // advection halo exchange
   occa::memory o_velocityHaloGatherTmp;
 
   //ARK data
@@ -226,6 +238,12 @@ typedef struct {
   occa::kernel vorticityKernel;
   occa::kernel isoSurfaceKernel;
 
+  // coordinated kernel builds, shared with the elliptic solves
+  kernelBuilder_t *builder;
+
+  // kernel counters ([KERNEL PROFILE] TRUE), shared with the elliptic solves
+  kernelProfile_t *profile;
+  int profAdvectionVolume, profAdvectionSurface, profGradientVolume, profDivergenceVolume;
 
 }ins_t;
 
@@ -234,6 +252,8 @@ ins_t *insSetup(mesh_t *mesh, setupAide options);
 void insRunARK(ins_t *ins);
 void insRunEXTBDF(ins_t *ins);
 
+void insProfileSetup(ins_t *ins, setupAide &options);
+
 void insPlotVTU(ins_t *ins, char *fileNameBase);
 void insReport(ins_t *ins, dfloat time,  int tstep);
 void insError(ins_t *ins, dfloat time);
@@ -248,6 +268,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
 
 void insVelocityRhs  (ins_t *ins, dfloat time, int stage, occa::memory o_rhsU, occa::memory o_rhsV, occa::memory o_rhsW);
 void insVelocitySolve(ins_t *ins, dfloat time, int stage, occa::memory o_rhsU, occa::memory o_rhsV, occa::memory o_rhsW, occa::memory o_rkU);
+void insPreconditionerRefresh(ins_t *ins);
 void insVelocityUpdate(ins_t *ins, dfloat time, int stage, occa::memory o_rkGP, occa::memory o_rkU);
 
 void insPressureRhs  (ins_t *ins, dfloat time, int stage);
@@ -262,6 +283,10 @@ void insIsoPlotVTU(ins_t *ins, char *fileName);
 void insRestartWrite(ins_t *ins, setupAide &options, dfloat time); 
 void insRestartRead(ins_t *ins, setupAide &options); 
 
+void insHistorySetup(ins_t *ins);
+void insHistoryRotate(ins_t *ins);
+occa::memory insHistoryLevel(ins_t *ins, occa::memory &o_history, int Nfields, int s);
+
 void insBrownMinionQuad3D(ins_t *ins);
 // customized hex writer
 extern "C"
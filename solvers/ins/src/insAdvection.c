@@ -38,20 +38,15 @@ void insAdvection(ins_t *ins, dfloat time, occa::memory o_U, occa::memory o_NU){
                                  mesh->o_haloElementList,
                                  ins->fieldOffset,
                                  o_U,
-                                 ins->o_vHaloBuffer);
+                                 ins->vHalo->o_haloBuffer);
 
-    // copy extracted halo to HOST 
-    ins->o_vHaloBuffer.copyTo(ins->vSendBuffer);           
-  
-    // start halo exchange
-    meshHaloExchangeStart(mesh,
-                         mesh->Np*(ins->NVfields)*sizeof(dfloat),
-                         ins->vSendBuffer,
-                         ins->vRecvBuffer);
+    // start halo exchange, incoming halo lands in o_vHaloBuffer
+    meshHaloExchangeDeviceBufferStart(mesh, ins->vHalo, ins->o_vHaloBuffer, 0);
   }
 
   // Compute Volume Contribution
   occaTimerTic(mesh->device,"AdvectionVolume");
+  kernelProfileStart(ins->profile);
   if(ins->options.compareArgs("ADVECTION TYPE", "CUBATURE")){
     ins->advectionCubatureVolumeKernel(mesh->Nelements,
                                        mesh->o_vgeo,
@@ -71,13 +66,12 @@ void insAdvection(ins_t *ins, dfloat time, occa::memory o_U, occa::memory o_NU){
                                o_U,
                                o_NU);
   }
+  kernelProfileStop(ins->profile, ins->profAdvectionVolume);
   occaTimerToc(mesh->device,"AdvectionVolume");
 
   // COMPLETE HALO EXCHANGE
   if(mesh->totalHaloPairs>0){
-    meshHaloExchangeFinish(mesh);
-
-    ins->o_vHaloBuffer.copyFrom(ins->vRecvBuffer); 
+    meshHaloExchangeDeviceFinish(mesh, ins->vHalo);
 
     ins->velocityHaloScatterKernel(mesh->Nelements,
                                   mesh->totalHaloPairs,
@@ -87,6 +81,7 @@ void insAdvection(ins_t *ins, dfloat time, occa::memory o_U, occa::memory o_NU){
   }
 
   occaTimerTic(mesh->device,"AdvectionSurface");
+  kernelProfileStart(ins->profile);
   if(ins->options.compareArgs("ADVECTION TYPE", "CUBATURE")){
     ins->advectionCubatureSurfaceKernel(mesh->Nelements,
                                         mesh->o_vgeo,
@@ -121,5 +116,6 @@ void insAdvection(ins_t *ins, dfloat time, occa::memory o_U, occa::memory o_NU){
                                 o_U,
                                 o_NU);
   }
+  kernelProfileStop(ins->profile, ins->profAdvectionSurface);
   occaTimerToc(mesh->device,"AdvectionSurface");
 }
@@ -29,8 +29,9 @@ SOFTWARE.
 void insComputeDt(ins_t *ins, dfloat time){
 
   mesh_t *mesh = ins->mesh; 
-  // copy data to host
-  ins->o_U.copyTo(ins->U);
+  // copy newest velocity to host
+  occa::memory o_U0 = insHistoryLevel(ins, ins->o_U, ins->NVfields, 0);
+  o_U0.copyTo(ins->U, ins->NVfields*ins->fieldOffset*sizeof(dfloat));
 
   dfloat hminL = 0.0, umaxL = 0.0, dt = 1e9;
   for(dlong e=0;e<mesh->Nelements;++e){
@@ -53,12 +53,14 @@ void insDivergence(ins_t *ins, dfloat time, occa::memory o_U, occa::memory o_DU)
 
   // computes div u^(n+1) volume term
   occaTimerTic(mesh->device,"DivergenceVolume");
+  kernelProfileStart(ins->profile);
   ins->divergenceVolumeKernel(mesh->Nelements,
                              mesh->o_vgeo,
                              mesh->o_Dmatrices,
                              ins->fieldOffset,
                              o_U,
                              o_DU);
+  kernelProfileStop(ins->profile, ins->profDivergenceVolume);
   occaTimerToc(mesh->device,"DivergenceVolume");
 
   if (ins->vOptions.compareArgs("DISCRETIZATION","IPDG")) {
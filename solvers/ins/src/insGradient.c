@@ -51,6 +51,7 @@ void insGradient(ins_t *ins, dfloat time, occa::memory o_P, occa::memory o_GP){
   }
 
   occaTimerTic(mesh->device,"GradientVolume");
+  kernelProfileStart(ins->profile);
   // Compute Volume Contribution
   ins->gradientVolumeKernel(mesh->Nelements,
                             mesh->o_vgeo,
@@ -58,6 +59,7 @@ void insGradient(ins_t *ins, dfloat time, occa::memory o_P, occa::memory o_GP){
                             ins->fieldOffset,
                             o_P,
                             o_GP);
+  kernelProfileStop(ins->profile, ins->profGradientVolume);
   occaTimerToc(mesh->device,"GradientVolume");
 
   // COMPLETE HALO EXCHANGE
@@ -0,0 +1,59 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ins.h"
+
+// ring bookkeeping for the EXTBDF history, rotating the slot table replaces
+// the per step device copies that used to shift every history level
+
+void insHistorySetup(ins_t *ins){
+
+  mesh_t *mesh = ins->mesh;
+
+  ins->historyIndex = (int*) calloc(ins->Nstages+1, sizeof(int));
+  for (int s=0;s<=ins->Nstages;s++)
+    ins->historyIndex[s] = s;
+
+  ins->o_historyIndex = mesh->device.malloc((ins->Nstages+1)*sizeof(int), ins->historyIndex);
+}
+
+// level s becomes level s+1 and the spare slot (the new rkU/rkP) becomes
+// level 0, the oldest level is recycled as the next spare
+void insHistoryRotate(ins_t *ins){
+
+  int spare = ins->historyIndex[ins->Nstages];
+  for (int s=ins->Nstages;s>0;s--)
+    ins->historyIndex[s] = ins->historyIndex[s-1];
+  ins->historyIndex[0] = spare;
+
+  ins->o_historyIndex.copyFrom(ins->historyIndex);
+}
+
+// view of history level s of a field with Nfields components
+occa::memory insHistoryLevel(ins_t *ins, occa::memory &o_history, int Nfields, int s){
+
+  return o_history + ins->historyIndex[s]*Nfields*ins->fieldOffset*sizeof(dfloat);
+}
@@ -31,12 +31,15 @@ int main(int argc, char **argv){
   // start up MPI
   MPI_Init(&argc, &argv);
 
-  if(argc!=2){
-    printf("usage: ./insMain setupfile\n");
+  if(argc!=2 && !(argc==3 && !strcmp(argv[2], "prebuild"))){
+    printf("usage: ./insMain setupfile [prebuild]\n");
     MPI_Finalize();
     exit(-1);
   }
 
+  // prebuild: compile every kernel the setup file needs into the OCCA cache and stop
+  int prebuild = (argc==3);
+
   // if argv > 2 then should load input data from argv
   setupAide options(argv[1]);
   
@@ -71,6 +74,14 @@ int main(int argc, char **argv){
   }
 
   ins_t *ins = insSetup(mesh,options);
+  kernelBuilderReport(ins->builder);
+  if(prebuild){
+    MPI_Finalize();
+    exit(0);
+  }
+
+  // kernel counters, enabled by [KERNEL PROFILE] TRUE
+  insProfileSetup(ins, options);
 
   insPlotWallsVTUHex3D(ins, "walls");
   
@@ -83,6 +94,10 @@ int main(int argc, char **argv){
   if (ins->options.compareArgs("TIME INTEGRATOR", "ARK"))  insRunARK(ins);
   if (ins->options.compareArgs("TIME INTEGRATOR", "EXTBDF"))  insRunEXTBDF(ins);
 
+  kernelProfileReport(ins->profile, ins->options);
+
+  meshHaloDeviceFree(ins->vHalo);
+
   // close down MPI
   MPI_Finalize();
 
@@ -78,7 +78,7 @@ void insPressureSolve(ins_t *ins, dfloat time, int stage){
     occaTimerToc(mesh->device,"PoissonRhsIpdg");
   }
 
-  //keep current PI as the initial guess?
+  //keep current PI as the initial guess (replaced by the projected guess when [PRESSURE SOLUTION PROJECTION] > 0)
 
   // gather-scatter
   if(ins->pOptions.compareArgs("DISCRETIZATION","CONTINUOUS")) {
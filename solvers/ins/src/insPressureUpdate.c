@@ -36,6 +36,7 @@ void insPressureUpdate(ins_t *ins, dfloat time, int stage, occa::memory o_rkP){
                             stage,
 		                        ins->o_prkB,
                             ins->fieldOffset,
+                            ins->o_historyIndex,
                             ins->o_PI,
                             ins->o_P,
                             o_rkP);
@@ -0,0 +1,87 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ins.h"
+
+// register the INS operator kernels and the elliptic solves with their analytic
+// per-launch traffic and work, one profile for the whole run
+void insProfileSetup(ins_t *ins, setupAide &options){
+
+  mesh_t *mesh = ins->mesh;
+
+  ins->profile = kernelProfileSetup(mesh->device, mesh->comm, options);
+
+  kernelProfile_t *prof = ins->profile;
+
+  const double sz  = sizeof(dfloat);
+  const double isz = sizeof(dlong);
+
+  const int affine = (ins->elementType==TRIANGLES || ins->elementType==TETRAHEDRA);
+
+  const double Nelements = mesh->Nelements;
+  const double Np        = mesh->Np;
+  const double NfacesNfp = mesh->Nfaces*mesh->Nfp;
+  const double NV        = ins->NVfields;
+  const double dim       = ins->dim;
+
+  // one reference derivative per node: dense on affine elements, along a line otherwise
+  const double derivFlops = 2*(affine ? Np : mesh->Nq);
+  const double vgeoBytes  = sz*Nelements*mesh->Nvgeo*(affine ? 1 : Np);
+
+  // advection volume: read and write every velocity field. The cubature variant
+  // interpolates each field to the cubature nodes and projects the weighted derivatives back.
+  double advectionVolumeFlops = Nelements*Np*NV*(dim*derivFlops + 2*dim);
+  if(ins->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
+    advectionVolumeFlops = Nelements*NV*2*Np*mesh->cubNp*(1 + dim);
+
+  ins->profAdvectionVolume = kernelProfileRegister(prof, "insAdvectionVolume",
+                                                   2*sz*Nelements*Np*NV + vgeoBytes,
+                                                   advectionVolumeFlops);
+
+  // advection surface: connectivity, face geometry, both velocity traces, lifted update
+  ins->profAdvectionSurface = kernelProfileRegister(prof, "insAdvectionSurface",
+                                                    Nelements*(2*isz*NfacesNfp
+                                                               + sz*mesh->Nsgeo*(affine ? mesh->Nfaces : NfacesNfp)
+                                                               + sz*2*NfacesNfp*NV + sz*2*Np*NV),
+                                                    Nelements*NV*(8*NfacesNfp + 2*Np*NfacesNfp));
+
+  // gradient of the pressure and divergence of the velocity, volume terms
+  ins->profGradientVolume = kernelProfileRegister(prof, "insGradientVolume",
+                                                  sz*Nelements*Np*(1 + NV) + vgeoBytes,
+                                                  Nelements*Np*(dim*derivFlops + 2*dim*dim));
+
+  ins->profDivergenceVolume = kernelProfileRegister(prof, "insDivergenceVolume",
+                                                    sz*Nelements*Np*(NV + 1) + vgeoBytes,
+                                                    Nelements*Np*NV*(dim*derivFlops + 2*dim));
+
+  // elliptic solves, prefixed by the field they solve for
+  ellipticProfileSetup(ins->uSolver, prof, "U:");
+  if(!ins->blockVelocitySolve){
+    ellipticProfileSetup(ins->vSolver, prof, "V:");
+    if(ins->dim==3) ellipticProfileSetup(ins->wSolver, prof, "W:");
+  }
+  ellipticProfileSetup(ins->pSolver, prof, "P:");
+}
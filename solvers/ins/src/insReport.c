@@ -30,11 +30,15 @@ void insReport(ins_t *ins, dfloat time, int tstep){
 
   mesh_t *mesh = ins->mesh;
 
+  // newest history level
+  occa::memory o_U0 = insHistoryLevel(ins, ins->o_U, ins->NVfields, 0);
+  occa::memory o_P0 = insHistoryLevel(ins, ins->o_P, 1, 0);
+
   ins->vorticityKernel(mesh->Nelements,
                        mesh->o_vgeo,
                        mesh->o_Dmatrices,
                        ins->fieldOffset,
-                       ins->o_U,
+                       o_U0,
                        ins->o_Vort);
 
   
@@ -43,7 +47,7 @@ void insReport(ins_t *ins, dfloat time, int tstep){
                              mesh->o_vgeo,
                              mesh->o_Dmatrices,
                              ins->fieldOffset,
-                             ins->o_U,
+                             o_U0,
                              ins->o_Div);
 
   // gatherscatter vorticity field
@@ -62,8 +66,8 @@ void insReport(ins_t *ins, dfloat time, int tstep){
   ins->pSolver->dotMultiplyKernel(mesh->Nelements*mesh->Np, mesh->ogs->o_invDegree, ins->o_Div, ins->o_Div);
 
   // copy data back to host
-  ins->o_U.copyTo(ins->U);
-  ins->o_P.copyTo(ins->P);
+  o_U0.copyTo(ins->U, ins->NVfields*ins->fieldOffset*sizeof(dfloat));
+  o_P0.copyTo(ins->P, ins->fieldOffset*sizeof(dfloat));
 
   ins->o_Vort.copyTo(ins->Vort);
   ins->o_Div.copyTo(ins->Div);
@@ -75,7 +79,7 @@ void insReport(ins_t *ins, dfloat time, int tstep){
   if(ins->options.compareArgs("OUTPUT FILE FORMAT","PPM")){
 
     // copy data back to host
-    ins->o_P.copyTo(ins->P);
+    o_P0.copyTo(ins->P, ins->fieldOffset*sizeof(dfloat));
     ins->o_Vort.copyTo(ins->Vort);
    
     //
@@ -113,8 +117,8 @@ void insReport(ins_t *ins, dfloat time, int tstep){
                               mesh->o_x,
                               mesh->o_y,
                               mesh->o_z,
-                              ins->o_P, 
-                              ins->o_U,
+                              o_P0, 
+                              o_U0,
                               ins->o_Vort,
                               ins->o_plotInterp,
                               ins->o_plotEToV,
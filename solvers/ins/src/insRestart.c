@@ -30,7 +30,7 @@ void insRestartWrite(ins_t *ins, setupAide &options, dfloat t){
   mesh_t *mesh = ins->mesh; 
 
   // Copy Field To Host
-  // copy data back to host
+  // copy data back to host, history level s is in ring slot historyIndex[s]
   ins->o_U.copyTo(ins->U);
   ins->o_P.copyTo(ins->P);
   
@@ -67,8 +67,8 @@ void insRestartWrite(ins_t *ins, setupAide &options, dfloat t){
   for(int s =0; s<ins->Nstages; s++){
     for(dlong e = 0;e<mesh->Nelements; e++){
       for(int n=0; n<mesh->Np; n++ ){
-        const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields; 
-        const dlong idp = e*mesh->Np + n + s*ins->fieldOffset; 
+        const dlong idv = e*mesh->Np + n + ins->historyIndex[s]*ins->fieldOffset*ins->NVfields; 
+        const dlong idp = e*mesh->Np + n + ins->historyIndex[s]*ins->fieldOffset; 
           for(int vf = 0; vf<ins->NVfields; vf++){
             elmField[vf]   =  ins->U[idv + vf*ins->fieldOffset];
           }
@@ -81,7 +81,7 @@ void insRestartWrite(ins_t *ins, setupAide &options, dfloat t){
   for(int s =0; s<ins->Nstages; s++){
     for(dlong e = 0;e<mesh->Nelements; e++){
       for(int n=0; n<mesh->Np; n++ ){
-        const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields; 
+        const dlong idv = e*mesh->Np + n + ins->historyIndex[s]*ins->fieldOffset*ins->NVfields; 
           
           for(int vf = 0; vf<ins->NVfields; vf++)
             elmField2[vf]   =  ins->NU[idv + vf*ins->fieldOffset];
@@ -295,6 +295,10 @@ void insRestartRead(ins_t *ins, setupAide &options){
   // History of Pressure !!!!!
   ins->o_GP.copyFrom(ins->GP);
 
+  // the file holds the levels in order
+  for (int s=0;s<=ins->Nstages;s++) ins->historyIndex[s] = s;
+  ins->o_historyIndex.copyFrom(ins->historyIndex);
+
 
 }else{
   printf("No restart file...");
@@ -48,7 +48,10 @@ void insRunEXTBDF(ins_t *ins){
     else if(tstep<3 && ins->temporalOrder>=3) 
       extbdfCoefficents(ins,tstep+1);
 
-    insGradient (ins, 0, ins->o_P, ins->o_GP);
+    ins->o_rkU = insHistoryLevel(ins, ins->o_U, ins->NVfields, ins->Nstages);
+    ins->o_rkP = insHistoryLevel(ins, ins->o_P, 1, ins->Nstages);
+
+    insGradient (ins, 0, insHistoryLevel(ins, ins->o_P, 1, 0), insHistoryLevel(ins, ins->o_GP, ins->NVfields, 0));
 
     insVelocityRhs  (ins, 0, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW);
     insVelocitySolve(ins, 0, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW, ins->o_rkU);
@@ -59,31 +62,11 @@ void insRunEXTBDF(ins_t *ins){
     insPressureUpdate(ins, 0, ins->Nstages, ins->o_rkP);
     insGradient(ins, 0, ins->o_rkP, ins->o_rkGP);
 
-    //cycle history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_U.copyFrom(ins->o_U, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_P.copyFrom(ins->o_P, ins->Ntotal*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*sizeof(dfloat));
-    }
-
-    //copy updated pressure
-    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat)); 
-
     //update velocity
     insVelocityUpdate(ins, 0, ins->Nstages, ins->o_rkGP, ins->o_rkU);
 
-    //copy updated pressure
-    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
-
-    //cycle rhs history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_GP.copyFrom(ins->o_GP, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-    }
+    //cycle history
+    insHistoryRotate(ins);
 
     if (mesh->rank==0) printf("\rSstep = %d, solver iterations: U - %3d, V - %3d, P - %3d", tstep+1, ins->NiterU, ins->NiterV, ins->NiterP); fflush(stdout);
   }
@@ -94,6 +77,9 @@ void insRunEXTBDF(ins_t *ins){
   // Write Initial Data
   if(ins->outputStep) insReport(ins, ins->startTime, 0);
 
+  // running solver iteration totals, to judge projected initial guesses
+  long long int NiterTotalU = 0, NiterTotalV = 0, NiterTotalW = 0, NiterTotalP = 0;
+
   for(int tstep=0;tstep<ins->NtimeSteps;++tstep){
 
     // if(ins->restartedFromFile){
@@ -114,6 +100,15 @@ void insRunEXTBDF(ins_t *ins){
 
     hlong offset = mesh->Np*(mesh->Nelements+mesh->totalHaloPairs);
 
+    // newest history levels, the spare ring slot receives the new velocity and pressure
+    occa::memory o_U0  = insHistoryLevel(ins, ins->o_U,  ins->NVfields, 0);
+    occa::memory o_P0  = insHistoryLevel(ins, ins->o_P,  1, 0);
+    occa::memory o_NU0 = insHistoryLevel(ins, ins->o_NU, ins->NVfields, 0);
+    occa::memory o_GP0 = insHistoryLevel(ins, ins->o_GP, ins->NVfields, 0);
+
+    ins->o_rkU = insHistoryLevel(ins, ins->o_U, ins->NVfields, ins->Nstages);
+    ins->o_rkP = insHistoryLevel(ins, ins->o_P, 1, ins->Nstages);
+
 #if 0
     ins->constrainKernel(mesh->Nelements,
 			 offset,
@@ -124,12 +119,12 @@ void insRunEXTBDF(ins_t *ins){
 #endif
     
     if(ins->Nsubsteps) {
-      insSubCycle(ins, time, ins->Nstages, ins->o_U, ins->o_NU);
+      insSubCycle(ins, time, ins->Nstages, ins->o_U, o_NU0);
     } else {
-      insAdvection(ins, time, ins->o_U, ins->o_NU);
+      insAdvection(ins, time, o_U0, o_NU0);
     }
 
-    insGradient (ins, time, ins->o_P, ins->o_GP);
+    insGradient (ins, time, o_P0, o_GP0);
 
 #if 0
     ins->constrainKernel(mesh->Nelements,
@@ -168,19 +163,6 @@ void insRunEXTBDF(ins_t *ins){
 			 ins->o_rkGP);
 #endif
     
-    //cycle history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_U.copyFrom(ins->o_U, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_P.copyFrom(ins->o_P, ins->Ntotal*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*sizeof(dfloat));
-    }
-
-    //copy updated pressure
-    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat)); 
-
     //update velocity
     insVelocityUpdate(ins, time+ins->dt, ins->Nstages, ins->o_rkGP, ins->o_rkU);
 
@@ -199,20 +181,8 @@ void insRunEXTBDF(ins_t *ins){
     
 
     
-    //copy updated pressure
-    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
-
-    //cycle rhs history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_NU.copyFrom(ins->o_NU, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-			 (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-			 (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_GP.copyFrom(ins->o_GP, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-			 (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-			 (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-    }
-
-
+    //cycle history: rkU/rkP become level 0, no data is moved
+    insHistoryRotate(ins);
 
 #if 1
     if(((tstep+1)%10)==0){
@@ -225,6 +195,9 @@ void insRunEXTBDF(ins_t *ins){
     }
 #endif
 
+    NiterTotalU += ins->NiterU; NiterTotalV += ins->NiterV;
+    NiterTotalW += ins->NiterW; NiterTotalP += ins->NiterP;
+
     occaTimerTic(mesh->device,"Report");
 
     if(ins->outputStep){
@@ -269,6 +242,22 @@ void insRunEXTBDF(ins_t *ins){
   dfloat finalTime = ins->NtimeSteps*ins->dt;
   printf("\n");
 
+  // device copies the history ring avoids each step (read + write): Nstages
+  // level shifts plus the rkU/rkP copy for U and P, Nstages-1 shifts for NU and GP
+  if(mesh->rank==0){
+    size_t fieldBytes = ins->Ntotal*sizeof(dfloat);
+    size_t savedBytes = 2*fieldBytes*(ins->Nstages*(ins->NVfields+1) + 2*(ins->Nstages-1)*ins->NVfields);
+    printf("history ring saved %.2f MB of device copies per step\n", savedBytes/(1024.*1024.));
+  }
+
+  if(mesh->rank==0 && ins->NtimeSteps>0){
+    dfloat invN = 1./ins->NtimeSteps;
+    if (ins->dim==2) printf("average solver iterations per step: U - %5.1f, V - %5.1f, P - %5.1f\n",
+                            NiterTotalU*invN, NiterTotalV*invN, NiterTotalP*invN);
+    if (ins->dim==3) printf("average solver iterations per step: U - %5.1f, V - %5.1f, W - %5.1f, P - %5.1f\n",
+                            NiterTotalU*invN, NiterTotalV*invN, NiterTotalW*invN, NiterTotalP*invN);
+  }
+
   if(ins->outputStep) insReport(ins, finalTime,ins->NtimeSteps);
   
   if(mesh->rank==0) occa::printTimer();
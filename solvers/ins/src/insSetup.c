@@ -34,6 +34,8 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   ins->mesh = mesh;
   ins->options = options;
 
+  ins->builder = kernelBuilderSetup(mesh->device, mesh->comm, options);
+
   options.getArgs("MESH DIMENSION", ins->dim);
   options.getArgs("ELEMENT TYPE", ins->elementType);
 
@@ -222,8 +224,9 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   ins->Nblock = (Nlocal+blockSize-1)/blockSize;
 
   // compute samples of q at interpolation nodes
-  ins->U     = (dfloat*) calloc(ins->NVfields*ins->Nstages*Ntotal,sizeof(dfloat));
-  ins->P     = (dfloat*) calloc(              ins->Nstages*Ntotal,sizeof(dfloat));
+  // one slot more than the history levels, see insHistory
+  ins->U     = (dfloat*) calloc(ins->NVfields*(ins->Nstages+1)*Ntotal,sizeof(dfloat));
+  ins->P     = (dfloat*) calloc(              (ins->Nstages+1)*Ntotal,sizeof(dfloat));
 
   //rhs storage
   ins->rhsU  = (dfloat*) calloc(Ntotal,sizeof(dfloat));
@@ -376,8 +379,10 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   options.getArgs("DATA FILE", boundaryHeaderFileName);
   kernelInfo["includes"] += (char*)boundaryHeaderFileName.c_str();
 
-  ins->o_U = mesh->device.malloc(ins->NVfields*ins->Nstages*Ntotal*sizeof(dfloat), ins->U);
-  ins->o_P = mesh->device.malloc(              ins->Nstages*Ntotal*sizeof(dfloat), ins->P);
+  ins->o_U = mesh->device.malloc(ins->NVfields*(ins->Nstages+1)*Ntotal*sizeof(dfloat), ins->U);
+  ins->o_P = mesh->device.malloc(              (ins->Nstages+1)*Ntotal*sizeof(dfloat), ins->P);
+
+  insHistorySetup(ins);
 
 #if 0
   if (mesh->rank==0 && options.compareArgs("VERBOSE","TRUE")) 
@@ -402,15 +407,10 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   insPlotVTU(ins, fname);
 }else{
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
-      if (ins->dim==2) 
-        ins->setFlowFieldKernel =  mesh->device.buildKernel(DINS "/okl/insSetFlowField2D.okl", "insSetFlowField2D", kernelInfo);  
-      else
-        ins->setFlowFieldKernel =  mesh->device.buildKernel(DINS "/okl/insSetFlowField3D.okl", "insSetFlowField3D", kernelInfo);  
-    }
-    MPI_Barrier(mesh->comm);
-  }
+  if (ins->dim==2) 
+    ins->setFlowFieldKernel =  kernelBuild(ins->builder, DINS "/okl/insSetFlowField2D.okl", "insSetFlowField2D", kernelInfo);  
+  else
+    ins->setFlowFieldKernel =  kernelBuild(ins->builder, DINS "/okl/insSetFlowField3D.okl", "insSetFlowField3D", kernelInfo);  
 
   ins->startTime =0.0;
   options.getArgs("START TIME", ins->startTime);
@@ -644,6 +644,9 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->vOptions.setArgs("PARALMOND CYCLE",      options.getArgs("VELOCITY PARALMOND CYCLE"));
   ins->vOptions.setArgs("PARALMOND SMOOTHER",   options.getArgs("VELOCITY PARALMOND SMOOTHER"));
   ins->vOptions.setArgs("PARALMOND PARTITION",  options.getArgs("VELOCITY PARALMOND PARTITION"));
+  ins->vOptions.setArgs("PARALMOND COARSE SOLVER", options.getArgs("VELOCITY PARALMOND COARSE SOLVER"));
+  ins->vOptions.setArgs("PARALMOND COARSE SIZE",   options.getArgs("VELOCITY PARALMOND COARSE SIZE"));
+  ins->vOptions.setArgs("SOLUTION PROJECTION",     options.getArgs("VELOCITY SOLUTION PROJECTION"));
 
   ins->pOptions = options;
   ins->pOptions.setArgs("KRYLOV SOLVER",        options.getArgs("PRESSURE KRYLOV SOLVER"));
@@ -655,6 +658,9 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->pOptions.setArgs("PARALMOND CYCLE",      options.getArgs("PRESSURE PARALMOND CYCLE"));
   ins->pOptions.setArgs("PARALMOND SMOOTHER",   options.getArgs("PRESSURE PARALMOND SMOOTHER"));
   ins->pOptions.setArgs("PARALMOND PARTITION",  options.getArgs("PRESSURE PARALMOND PARTITION"));
+  ins->pOptions.setArgs("PARALMOND COARSE SOLVER", options.getArgs("PRESSURE PARALMOND COARSE SOLVER"));
+  ins->pOptions.setArgs("PARALMOND COARSE SIZE",   options.getArgs("PRESSURE PARALMOND COARSE SIZE"));
+  ins->pOptions.setArgs("SOLUTION PROJECTION",     options.getArgs("PRESSURE SOLUTION PROJECTION"));
 
   if (mesh->rank==0) printf("==================ELLIPTIC SOLVE SETUP=========================\n");
 
@@ -676,6 +682,7 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
 
   // Use third Order Velocity Solve: full rank should converge for low orders
   if (mesh->rank==0) printf("==================VELOCITY SOLVE SETUP=========================\n");
+  double velocitySetupStart = MPI_Wtime();
 
   ins->uSolver = new elliptic_t(); // (elliptic_t*) calloc(1, sizeof(elliptic_t));
   ins->uSolver->mesh = mesh;
@@ -683,6 +690,7 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->uSolver->dim = ins->dim;
   ins->uSolver->elementType = ins->elementType;
   ins->uSolver->BCType = (int*) calloc(7,sizeof(int));
+  ins->uSolver->builder = ins->builder;
   memcpy(ins->uSolver->BCType,uBCType,7*sizeof(int));
   ellipticSolveSetup(ins->uSolver, ins->lambda, kernelInfoV); 
 
@@ -692,6 +700,7 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->vSolver->dim = ins->dim;
   ins->vSolver->elementType = ins->elementType;
   ins->vSolver->BCType = (int*) calloc(7,sizeof(int));
+  ins->vSolver->builder = ins->builder;
   memcpy(ins->vSolver->BCType,vBCType,7*sizeof(int));
   ellipticSolveSetup(ins->vSolver, ins->lambda, kernelInfoV); //!!!!!
 
@@ -702,10 +711,42 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
     ins->wSolver->dim = ins->dim;
     ins->wSolver->elementType = ins->elementType;
     ins->wSolver->BCType = (int*) calloc(7,sizeof(int));
+    ins->wSolver->builder = ins->builder;
     memcpy(ins->wSolver->BCType,wBCType,7*sizeof(int));
     ellipticSolveSetup(ins->wSolver, ins->lambda, kernelInfoV);  //!!!!! 
   }
+
+  // the velocity components share one operator when no boundary on the mesh
+  // distinguishes them (slip walls do), and are then solved as one block
+  ins->blockVelocitySolve = 0;
+  if (options.compareArgs("VELOCITY BLOCK SOLVE", "TRUE") &&
+      ins->vOptions.compareArgs("DISCRETIZATION", "CONTINUOUS") &&
+      !(ins->dim==3 && ins->elementType==QUADRILATERALS) &&
+      ins->uSolver->NprojMax==0) {
+
+    int bcUsed[7] = {0,0,0,0,0,0,0}, bcUsedGlobal[7];
+    for (dlong n=0;n<mesh->Nelements*mesh->Nfaces;n++) {
+      int bc = mesh->EToB[n];
+      if (bc>0 && bc<7) bcUsed[bc] = 1;
+    }
+    MPI_Allreduce(bcUsed, bcUsedGlobal, 7, MPI_INT, MPI_MAX, mesh->comm);
+
+    int sameBCs = 1;
+    for (int bc=1;bc<7;bc++) {
+      if (!bcUsedGlobal[bc]) continue;
+      if (vBCType[bc]!=uBCType[bc]) sameBCs = 0;
+      if (ins->dim==3 && wBCType[bc]!=uBCType[bc]) sameBCs = 0;
+    }
+
+    if (sameBCs) {
+      ellipticBlockSolveSetup(ins->uSolver, ins->dim, ins->fieldOffset, kernelInfoV);
+      ins->blockVelocitySolve = 1;
+    }
+  }
   
+  ins->preconLambda = ins->lambda;
+  ins->velocitySetupTime = MPI_Wtime()-velocitySetupStart;
+
   if (mesh->rank==0) printf("==================PRESSURE SOLVE SETUP=========================\n");
   ins->pSolver = new elliptic_t(); // (elliptic_t*) calloc(1, sizeof(elliptic_t));
   ins->pSolver->mesh = mesh;
@@ -713,6 +754,7 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->pSolver->dim = ins->dim;
   ins->pSolver->elementType = ins->elementType;
   ins->pSolver->BCType = (int*) calloc(7,sizeof(int));
+  ins->pSolver->builder = ins->builder;
   memcpy(ins->pSolver->BCType,pBCType,7*sizeof(int));
   ellipticSolveSetup(ins->pSolver, 0.0, kernelInfoP); //!!!!
 
@@ -824,9 +866,15 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   }
 
   // MEMORY ALLOCATION
-  ins->o_rhsU  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsU);
-  ins->o_rhsV  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsV);
-  ins->o_rhsW  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsW);
+  // velocity rhs fields are packed at fieldOffset so the continuous
+  // velocity solve can gather-scatter them in one ogsGatherScatterMany call
+  ins->o_rhsUVW = mesh->device.malloc(3*Ntotal*sizeof(dfloat));
+  ins->o_rhsU  = ins->o_rhsUVW + 0*Ntotal*sizeof(dfloat);
+  ins->o_rhsV  = ins->o_rhsUVW + 1*Ntotal*sizeof(dfloat);
+  ins->o_rhsW  = ins->o_rhsUVW + 2*Ntotal*sizeof(dfloat);
+  ins->o_rhsU.copyFrom(ins->rhsU, Ntotal*sizeof(dfloat));
+  ins->o_rhsV.copyFrom(ins->rhsV, Ntotal*sizeof(dfloat));
+  ins->o_rhsW.copyFrom(ins->rhsW, Ntotal*sizeof(dfloat));
   ins->o_rhsP  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsP);
 
   ins->o_NU    = mesh->device.malloc(ins->NVfields*(ins->Nstages+1)*Ntotal*sizeof(dfloat), ins->NU);
@@ -844,9 +892,11 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
   ins->o_rkGP  = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->rkGP);
 
   //storage for helmholtz solves
-  ins->o_UH = mesh->device.malloc(Ntotal*sizeof(dfloat));
-  ins->o_VH = mesh->device.malloc(Ntotal*sizeof(dfloat));
-  ins->o_WH = mesh->device.malloc(Ntotal*sizeof(dfloat));
+  // packed fieldOffset apart so the velocity components can be solved as a block
+  ins->o_UVWH = mesh->device.malloc(3*Ntotal*sizeof(dfloat));
+  ins->o_UH = ins->o_UVWH + 0*Ntotal*sizeof(dfloat);
+  ins->o_VH = ins->o_UVWH + 1*Ntotal*sizeof(dfloat);
+  ins->o_WH = ins->o_UVWH + 2*Ntotal*sizeof(dfloat);
 
   //plotting fields
   ins->o_Vort = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Vort);
@@ -890,6 +940,8 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
     ins->o_velocityHaloGatherTmp = mesh->device.malloc(vGatherBytes,  ins->velocityHaloGatherTmp);
   }
 
+  ins->vHalo = meshHaloDeviceSetup(mesh, mesh->Np*ins->NVfields, options);
+
   // set kernel name suffix
   char *suffix;
   
@@ -908,184 +960,178 @@ if(options.compareArgs("INITIAL CONDITION", "BROWN-MINION") &&
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
-
-      sprintf(fileName, DINS "/okl/insHaloExchange.okl");
-      sprintf(kernelName, "insVelocityHaloExtract");
-      ins->velocityHaloExtractKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insHaloExchange.okl");
+  sprintf(kernelName, "insVelocityHaloExtract");
+  ins->velocityHaloExtractKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insVelocityHaloScatter");
-      ins->velocityHaloScatterKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insVelocityHaloScatter");
+  ins->velocityHaloScatterKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insPressureHaloExtract");
-      ins->pressureHaloExtractKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insPressureHaloExtract");
+  ins->pressureHaloExtractKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insPressureHaloScatter");
-      ins->pressureHaloScatterKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insPressureHaloScatter");
+  ins->pressureHaloScatterKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // --
-      if(ins->dim==3 && ins->elementType==QUADRILATERALS){
-	sprintf(fileName, DINS "/okl/insConstrainQuad3D.okl");
-	sprintf(kernelName, "insConstrainQuad3D");
-	ins->constrainKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
-      }
+  // --
+  if(ins->dim==3 && ins->elementType==QUADRILATERALS){
+    sprintf(fileName, DINS "/okl/insConstrainQuad3D.okl");
+    sprintf(kernelName, "insConstrainQuad3D");
+    ins->constrainKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
+  }
       
-      // ===========================================================================
+  // ===========================================================================
 
-      sprintf(fileName, DINS "/okl/insAdvection%s.okl", suffix);
+  sprintf(fileName, DINS "/okl/insAdvection%s.okl", suffix);
 
-      // needed to be implemented
-      sprintf(kernelName, "insAdvectionCubatureVolume%s", suffix);
-      ins->advectionCubatureVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  // needed to be implemented
+  sprintf(kernelName, "insAdvectionCubatureVolume%s", suffix);
+  ins->advectionCubatureVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insAdvectionCubatureSurface%s", suffix);
-      ins->advectionCubatureSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insAdvectionCubatureSurface%s", suffix);
+  ins->advectionCubatureSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insAdvectionVolume%s", suffix);
-      ins->advectionVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insAdvectionVolume%s", suffix);
+  ins->advectionVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insAdvectionSurface%s", suffix);
-      ins->advectionSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insAdvectionSurface%s", suffix);
+  ins->advectionSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // // ===========================================================================
+  // // ===========================================================================
       
-      // sprintf(fileName, DINS "/okl/insDiffusion%s.okl", suffix);
-      // sprintf(kernelName, "insDiffusion%s", suffix);
-      // ins->diffusionKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  // sprintf(fileName, DINS "/okl/insDiffusion%s.okl", suffix);
+  // sprintf(kernelName, "insDiffusion%s", suffix);
+  // ins->diffusionKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // sprintf(fileName, DINS "/okl/insDiffusionIpdg%s.okl", suffix);
-      // sprintf(kernelName, "insDiffusionIpdg%s", suffix);
-      // ins->diffusionIpdgKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  // sprintf(fileName, DINS "/okl/insDiffusionIpdg%s.okl", suffix);
+  // sprintf(kernelName, "insDiffusionIpdg%s", suffix);
+  // ins->diffusionIpdgKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // sprintf(fileName, DINS "/okl/insVelocityGradient%s.okl", suffix);
-      // sprintf(kernelName, "insVelocityGradient%s", suffix);
-      // ins->velocityGradientKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  // sprintf(fileName, DINS "/okl/insVelocityGradient%s.okl", suffix);
+  // sprintf(kernelName, "insVelocityGradient%s", suffix);
+  // ins->velocityGradientKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // // ===========================================================================
+  // // ===========================================================================
 
-      sprintf(fileName, DINS "/okl/insGradient%s.okl", suffix);
-      sprintf(kernelName, "insGradientVolume%s", suffix);
-      ins->gradientVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insGradient%s.okl", suffix);
+  sprintf(kernelName, "insGradientVolume%s", suffix);
+  ins->gradientVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insGradientSurface%s", suffix);
-      ins->gradientSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insGradientSurface%s", suffix);
+  ins->gradientSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // ===========================================================================
+  // ===========================================================================
       
-      sprintf(fileName, DINS "/okl/insDivergence%s.okl", suffix);
-      sprintf(kernelName, "insDivergenceVolume%s", suffix);
-      ins->divergenceVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insDivergence%s.okl", suffix);
+  sprintf(kernelName, "insDivergenceVolume%s", suffix);
+  ins->divergenceVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(kernelName, "insDivergenceSurface%s", suffix);
-      ins->divergenceSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(kernelName, "insDivergenceSurface%s", suffix);
+  ins->divergenceSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      // ===========================================================================
+  // ===========================================================================
       
-      sprintf(fileName, DINS "/okl/insVelocityRhs%s.okl", suffix);
-      if (options.compareArgs("TIME INTEGRATOR", "ARK")) 
-        sprintf(kernelName, "insVelocityRhsARK%s", suffix); 
-      else if (options.compareArgs("TIME INTEGRATOR", "EXTBDF")) 
-        sprintf(kernelName, "insVelocityRhsEXTBDF%s", suffix);
-      ins->velocityRhsKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insVelocityRhs%s.okl", suffix);
+  if (options.compareArgs("TIME INTEGRATOR", "ARK")) 
+    sprintf(kernelName, "insVelocityRhsARK%s", suffix); 
+  else if (options.compareArgs("TIME INTEGRATOR", "EXTBDF")) 
+    sprintf(kernelName, "insVelocityRhsEXTBDF%s", suffix);
+  ins->velocityRhsKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
 
 
-      if(!(ins->dim==3 && ins->elementType==QUADRILATERALS) ){
-        sprintf(fileName, DINS "/okl/insVelocityBC%s.okl", suffix);
-        sprintf(kernelName, "insVelocityIpdgBC%s", suffix);
-        ins->velocityRhsIpdgBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  if(!(ins->dim==3 && ins->elementType==QUADRILATERALS) ){
+    sprintf(fileName, DINS "/okl/insVelocityBC%s.okl", suffix);
+    sprintf(kernelName, "insVelocityIpdgBC%s", suffix);
+    ins->velocityRhsIpdgBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insVelocityBC%s", suffix);
-        ins->velocityRhsBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(kernelName, "insVelocityBC%s", suffix);
+    ins->velocityRhsBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insVelocityAddBC%s", suffix);
-        ins->velocityAddBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
-      }
+    sprintf(kernelName, "insVelocityAddBC%s", suffix);
+    ins->velocityAddBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
+  }
 
-      // ===========================================================================
+  // ===========================================================================
       
-      // Dont forget to modify!!!!!!!!
-      sprintf(fileName, DINS "/okl/insPressureRhs%s.okl", suffix);
-      sprintf(kernelName, "insPressureRhs%s", suffix);
-      ins->pressureRhsKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  // Dont forget to modify!!!!!!!!
+  sprintf(fileName, DINS "/okl/insPressureRhs%s.okl", suffix);
+  sprintf(kernelName, "insPressureRhs%s", suffix);
+  ins->pressureRhsKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-       if(!(ins->dim==3 && ins->elementType==QUADRILATERALS) ){
-        sprintf(fileName, DINS "/okl/insPressureBC%s.okl", suffix);
-        sprintf(kernelName, "insPressureIpdgBC%s", suffix);
-        ins->pressureRhsIpdgBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+   if(!(ins->dim==3 && ins->elementType==QUADRILATERALS) ){
+    sprintf(fileName, DINS "/okl/insPressureBC%s.okl", suffix);
+    sprintf(kernelName, "insPressureIpdgBC%s", suffix);
+    ins->pressureRhsIpdgBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insPressureBC%s", suffix);
-        ins->pressureRhsBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(kernelName, "insPressureBC%s", suffix);
+    ins->pressureRhsBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insPressureAddBC%s", suffix);
-        ins->pressureAddBCKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
-      }
+    sprintf(kernelName, "insPressureAddBC%s", suffix);
+    ins->pressureAddBCKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
+  }
 
-      // ===========================================================================
+  // ===========================================================================
 
-      sprintf(fileName, DINS "/okl/insPressureUpdate.okl");
-      sprintf(kernelName, "insPressureUpdate");
-      ins->pressureUpdateKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insPressureUpdate.okl");
+  sprintf(kernelName, "insPressureUpdate");
+  ins->pressureUpdateKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-      sprintf(fileName, DINS "/okl/insVelocityUpdate.okl");
-      sprintf(kernelName, "insVelocityUpdate");
-      ins->velocityUpdateKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);      
+  sprintf(fileName, DINS "/okl/insVelocityUpdate.okl");
+  sprintf(kernelName, "insVelocityUpdate");
+  ins->velocityUpdateKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);      
 
-      // ===========================================================================
+  // ===========================================================================
 
-      sprintf(fileName, DINS "/okl/insVorticity%s.okl", suffix);
-      sprintf(kernelName, "insVorticity%s", suffix);
-      ins->vorticityKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+  sprintf(fileName, DINS "/okl/insVorticity%s.okl", suffix);
+  sprintf(kernelName, "insVorticity%s", suffix);
+  ins->vorticityKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
     
-      // ===========================================================================
-      if(ins->dim==3 && ins->options.compareArgs("OUTPUT TYPE","ISO")){
-        sprintf(fileName, DINS "/okl/insIsoSurface3D.okl");
-        sprintf(kernelName, "insIsoSurface3D");
+  // ===========================================================================
+  if(ins->dim==3 && ins->options.compareArgs("OUTPUT TYPE","ISO")){
+    sprintf(fileName, DINS "/okl/insIsoSurface3D.okl");
+    sprintf(kernelName, "insIsoSurface3D");
 
-        ins->isoSurfaceKernel = mesh->device.buildKernel(fileName, kernelName, kernelInfo);  
-      }
+    ins->isoSurfaceKernel = kernelBuild(ins->builder, fileName, kernelName, kernelInfo);  
+  }
       
 
-      // Not implemented for Quad 3D yet !!!!!!!!!!
-      if(ins->Nsubsteps){
-        // Note that resU and resV can be replaced with already introduced buffer
-        ins->o_Ue    = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Ue);
-        ins->o_Ud    = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Ud);
-        ins->o_resU  = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->resU);
-        ins->o_rhsUd = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->rhsUd);
+  // Not implemented for Quad 3D yet !!!!!!!!!!
+  if(ins->Nsubsteps){
+    // Note that resU and resV can be replaced with already introduced buffer
+    ins->o_Ue    = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Ue);
+    ins->o_Ud    = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Ud);
+    ins->o_resU  = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->resU);
+    ins->o_rhsUd = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->rhsUd);
 
-        if(ins->elementType==HEXAHEDRA)
-          ins->o_cUd = mesh->device.malloc(ins->NVfields*mesh->Nelements*mesh->cubNp*sizeof(dfloat), ins->cUd);
-        else 
-          ins->o_cUd = ins->o_Ud;
+    if(ins->elementType==HEXAHEDRA)
+      ins->o_cUd = mesh->device.malloc(ins->NVfields*mesh->Nelements*mesh->cubNp*sizeof(dfloat), ins->cUd);
+    else 
+      ins->o_cUd = ins->o_Ud;
 
-        sprintf(fileName, DHOLMES "/okl/scaledAdd.okl");
-        sprintf(kernelName, "scaledAddwOffset");
-        ins->scaledAddKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(fileName, DHOLMES "/okl/scaledAdd.okl");
+    sprintf(kernelName, "scaledAddwOffset");
+    ins->scaledAddKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(fileName, DINS "/okl/insSubCycle%s.okl", suffix);
-        sprintf(kernelName, "insSubCycleVolume%s", suffix);
-        ins->subCycleVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(fileName, DINS "/okl/insSubCycle%s.okl", suffix);
+    sprintf(kernelName, "insSubCycleVolume%s", suffix);
+    ins->subCycleVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insSubCycleSurface%s", suffix);
-        ins->subCycleSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(kernelName, "insSubCycleSurface%s", suffix);
+    ins->subCycleSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insSubCycleCubatureVolume%s", suffix);
-        ins->subCycleCubatureVolumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(kernelName, "insSubCycleCubatureVolume%s", suffix);
+    ins->subCycleCubatureVolumeKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insSubCycleCubatureSurface%s", suffix);
-        ins->subCycleCubatureSurfaceKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(kernelName, "insSubCycleCubatureSurface%s", suffix);
+    ins->subCycleCubatureSurfaceKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(fileName, DINS "/okl/insSubCycle.okl");
-        sprintf(kernelName, "insSubCycleRKUpdate");
-        ins->subCycleRKUpdateKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+    sprintf(fileName, DINS "/okl/insSubCycle.okl");
+    sprintf(kernelName, "insSubCycleRKUpdate");
+    ins->subCycleRKUpdateKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
 
-        sprintf(kernelName, "insSubCycleExt");
-        ins->subCycleExtKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
-      }
-    }
-    MPI_Barrier(mesh->comm);
+    sprintf(kernelName, "insSubCycleExt");
+    ins->subCycleExtKernel =  kernelBuild(ins->builder, fileName, kernelName, kernelInfo);
   }
 
   return ins;
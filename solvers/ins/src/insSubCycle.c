@@ -34,13 +34,16 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
 
   const dlong NtotalElements = (mesh->Nelements+mesh->totalHaloPairs);  
 
+  // newest history level of the velocity
+  occa::memory o_U0 = insHistoryLevel(ins, o_U, ins->NVfields, 0);
+
   //Exctract Halo On Device, all fields
   if(mesh->totalHaloPairs>0){
     ins->velocityHaloExtractKernel(mesh->Nelements,
                                  mesh->totalHaloPairs,
                                  mesh->o_haloElementList,
                                  ins->fieldOffset,
-                                 o_U,
+                                 o_U0,
                                  ins->o_vHaloBuffer);
 
     // copy extracted halo to HOST 
@@ -59,7 +62,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
     ins->velocityHaloScatterKernel(mesh->Nelements,
                                   mesh->totalHaloPairs,
                                   ins->fieldOffset,
-                                  o_U,
+                                  o_U0,
                                   ins->o_vHaloBuffer);
   }
 
@@ -80,7 +83,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
     bScale += b;
 
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
-    dlong toffset = torder*ins->NVfields*ins->Ntotal;
+    dlong toffset = ins->historyIndex[torder]*ins->NVfields*ins->Ntotal;
 
     if (torder==ins->ExplicitOrder-1) { //first substep
       ins->scaledAddKernel(ins->NVfields*ins->Ntotal, b, toffset, o_U, zero, izero, o_Ud);
@@ -118,6 +121,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
         ins->subCycleExtKernel(NtotalElements,
                                Nstages,
                                ins->fieldOffset,
+                               ins->o_historyIndex,
                                ins->o_extC,
                                o_U,
                                ins->o_Ue);
@@ -61,6 +61,7 @@ void insVelocityRhs(ins_t *ins, dfloat time, int stage, occa::memory o_rhsU, occ
                            ins->o_extbdfB,
                            ins->o_extbdfC,
                            ins->fieldOffset,
+                           ins->o_historyIndex,
                            ins->o_U,
                            ins->o_NU,
                            ins->o_GP,
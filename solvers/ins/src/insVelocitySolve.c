@@ -38,6 +38,9 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
   elliptic_t *wsolver = ins->wSolver;
 
   int quad3D = (ins->dim==3 && ins->elementType==QUADRILATERALS) ? 1 : 0;  
+
+  // the EXTBDF order ramp and adaptive dt change lambda after setup
+  if (ins->lambda!=ins->preconLambda) insPreconditionerRefresh(ins);
   
   if (ins->vOptions.compareArgs("DISCRETIZATION","CONTINUOUS")){
 
@@ -61,12 +64,9 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
                                 o_rhsV,
                                 o_rhsW);
 
-    // gather-scatter
-    ogsGatherScatter(o_rhsU, ogsDfloat, ogsAdd, mesh->ogs);
-    ogsGatherScatter(o_rhsV, ogsDfloat, ogsAdd, mesh->ogs);
-
-    if (ins->dim==3)
-      ogsGatherScatter(o_rhsW, ogsDfloat, ogsAdd, mesh->ogs);
+    // gather-scatter all velocity components together, o_rhsU/V/W are
+    // packed fieldOffset apart (see insSetup)
+    ogsGatherScatterMany(o_rhsU, ins->dim, ins->fieldOffset, ogsDfloat, ogsAdd, mesh->ogs);
 
     if (usolver->Nmasked) mesh->maskKernel(usolver->Nmasked, usolver->o_maskIds, o_rhsU);
     if (vsolver->Nmasked) mesh->maskKernel(vsolver->Nmasked, vsolver->o_maskIds, o_rhsV);
@@ -95,12 +95,13 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
     occaTimerToc(mesh->device,"velocityRhsIpdg");   
   }
 
-  //copy current velocity fields as initial guess? (could use Uhat or beter guess)
+  //copy current velocity fields as initial guess (replaced by the projected guess when [VELOCITY SOLUTION PROJECTION] > 0)
   dlong Ntotal = (mesh->Nelements+mesh->totalHaloPairs)*mesh->Np;
-  ins->o_UH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,0*ins->fieldOffset*sizeof(dfloat));
-  ins->o_VH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,1*ins->fieldOffset*sizeof(dfloat));
+  occa::memory o_U0 = insHistoryLevel(ins, ins->o_U, ins->NVfields, 0);
+  ins->o_UH.copyFrom(o_U0,Ntotal*sizeof(dfloat),0,0*ins->fieldOffset*sizeof(dfloat));
+  ins->o_VH.copyFrom(o_U0,Ntotal*sizeof(dfloat),0,1*ins->fieldOffset*sizeof(dfloat));
   if (ins->dim==3)
-    ins->o_WH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,2*ins->fieldOffset*sizeof(dfloat));
+    ins->o_WH.copyFrom(o_U0,Ntotal*sizeof(dfloat),0,2*ins->fieldOffset*sizeof(dfloat));
 
   if (ins->vOptions.compareArgs("DISCRETIZATION","CONTINUOUS") && !quad3D) {
     if (usolver->Nmasked) mesh->maskKernel(usolver->Nmasked, usolver->o_maskIds, ins->o_UH);
@@ -110,18 +111,30 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
 
   }
   
-  occaTimerTic(mesh->device,"Ux-Solve");
-  ins->NiterU = ellipticSolve(usolver, ins->lambda, ins->velTOL, o_rhsU, ins->o_UH);
-  occaTimerToc(mesh->device,"Ux-Solve"); 
-
-  occaTimerTic(mesh->device,"Uy-Solve");
-  ins->NiterV = ellipticSolve(vsolver, ins->lambda, ins->velTOL, o_rhsV, ins->o_VH);
-  occaTimerToc(mesh->device,"Uy-Solve");
-
-  if (ins->dim==3) {
-    occaTimerTic(mesh->device,"Uz-Solve");
-    ins->NiterW = ellipticSolve(wsolver, ins->lambda, ins->velTOL, o_rhsW, ins->o_WH);
-    occaTimerToc(mesh->device,"Uz-Solve");
+  if (ins->blockVelocitySolve) {
+    int Niter[3];
+
+    occaTimerTic(mesh->device,"UVW-Solve");
+    ellipticBlockSolve(usolver, ins->lambda, ins->velTOL, o_rhsU, ins->o_UVWH, Niter);
+    occaTimerToc(mesh->device,"UVW-Solve");
+
+    ins->NiterU = Niter[0];
+    ins->NiterV = Niter[1];
+    if (ins->dim==3) ins->NiterW = Niter[2];
+  } else {
+    occaTimerTic(mesh->device,"Ux-Solve");
+    ins->NiterU = ellipticSolve(usolver, ins->lambda, ins->velTOL, o_rhsU, ins->o_UH);
+    occaTimerToc(mesh->device,"Ux-Solve"); 
+
+    occaTimerTic(mesh->device,"Uy-Solve");
+    ins->NiterV = ellipticSolve(vsolver, ins->lambda, ins->velTOL, o_rhsV, ins->o_VH);
+    occaTimerToc(mesh->device,"Uy-Solve");
+
+    if (ins->dim==3) {
+      occaTimerTic(mesh->device,"Uz-Solve");
+      ins->NiterW = ellipticSolve(wsolver, ins->lambda, ins->velTOL, o_rhsW, ins->o_WH);
+      occaTimerToc(mesh->device,"Uz-Solve");
+    }
   }
 
   if (ins->vOptions.compareArgs("DISCRETIZATION","CONTINUOUS") && !quad3D) {
@@ -144,3 +157,26 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
   if (ins->dim==3)
     ins->o_WH.copyTo(o_Uhat,Ntotal*sizeof(dfloat),2*ins->fieldOffset*sizeof(dfloat),0);    
 }
+
+// numeric-only update of the velocity preconditioners for the current lambda
+void insPreconditionerRefresh(ins_t *ins){
+
+  mesh_t *mesh = ins->mesh;
+
+  double tic = MPI_Wtime();
+
+  ellipticPreconditionerRefresh(ins->uSolver, ins->lambda);
+  if (!ins->blockVelocitySolve) {
+    ellipticPreconditionerRefresh(ins->vSolver, ins->lambda);
+    if (ins->dim==3) ellipticPreconditionerRefresh(ins->wSolver, ins->lambda);
+  }
+
+  ins->preconLambda = ins->lambda;
+
+  double refreshTime = MPI_Wtime()-tic, maxRefreshTime;
+  MPI_Allreduce(&refreshTime, &maxRefreshTime, 1, MPI_DOUBLE, MPI_MAX, mesh->comm);
+
+  if (mesh->rank==0)
+    printf("Velocity preconditioner refresh for lambda = %g: %g s (full velocity setup %g s)\n",
+           ins->lambda, maxRefreshTime, ins->velocitySetupTime);
+}
@@ -39,6 +39,7 @@ void insVelocityUpdate(ins_t *ins, dfloat time, int stage,
                               ins->ARKswitch,
                               ins->dt,
                               ins->fieldOffset,
+                              ins->o_historyIndex,
                               ins->o_prkA,
                               ins->o_prkB,
                               o_rkGP,
@@ -0,0 +1,101 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernelBuilder.h"
+
+kernelBuilder_t *kernelBuilderSetup(occa::device &device, MPI_Comm comm, setupAide &options){
+
+  kernelBuilder_t *kb = new kernelBuilder_t[1];
+
+  kb->device = device;
+  kb->comm = comm;
+  kb->Nkernels = 0;
+  kb->buildTime = 0;
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  kb->everyRank = options.compareArgs("KERNEL BUILD", "ALL");
+
+  if(options.compareArgs("KERNEL BUILD", "NODE")){
+    // first rank on each shared memory node
+    MPI_Comm nodeComm;
+    int nodeRank;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+    MPI_Comm_rank(nodeComm, &nodeRank);
+    MPI_Comm_free(&nodeComm);
+    kb->leader = (nodeRank==0);
+  } else {
+    kb->leader = (rank==0);
+  }
+
+  return kb;
+}
+
+occa::kernel kernelBuild(kernelBuilder_t *kb, const char *fileName, const char *kernelName,
+                         const occa::properties &info){
+
+  occa::kernel kernel;
+
+  double tic = MPI_Wtime();
+
+  if(kb->everyRank){
+    kernel = kb->device.buildKernel(fileName, kernelName, info);
+  } else {
+    // leaders compile into the cache, everyone else loads once they are done
+    if(kb->leader)
+      kernel = kb->device.buildKernel(fileName, kernelName, info);
+
+    MPI_Barrier(kb->comm);
+
+    if(!kb->leader)
+      kernel = kb->device.buildKernel(fileName, kernelName, info);
+  }
+
+  kb->buildTime += MPI_Wtime() - tic;
+  kb->Nkernels++;
+
+  return kernel;
+}
+
+void kernelBuilderReport(kernelBuilder_t *kb){
+
+  int rank;
+  MPI_Comm_rank(kb->comm, &rank);
+
+  double maxTime = 0;
+  MPI_Reduce(&kb->buildTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, 0, kb->comm);
+
+  if(!rank)
+    printf("Built %d kernels in %g s (slowest rank)\n", kb->Nkernels, maxTime);
+}
+
+void kernelBuilderFree(kernelBuilder_t *kb){
+  delete [] kb;
+}
@@ -0,0 +1,240 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernelProfile.h"
+
+kernelProfile_t *kernelProfileSetup(occa::device &device, MPI_Comm comm, setupAide &options){
+
+  kernelProfile_t *prof = new kernelProfile_t[1];
+
+  prof->enabled = options.compareArgs("KERNEL PROFILE", "TRUE");
+
+  prof->device = device;
+  prof->comm = comm;
+
+  prof->Nentries = 0;
+  prof->maxEntries = 0;
+  prof->entries = NULL;
+
+  // events are resolved in batches so the launch path never synchronizes
+  prof->Npending = 0;
+  prof->maxPending = 256;
+  prof->pendingEntries = new int[prof->maxPending];
+  prof->pendingStart = new occa::streamTag[prof->maxPending];
+  prof->pendingEnd   = new occa::streamTag[prof->maxPending];
+
+  return prof;
+}
+
+int kernelProfileRegister(kernelProfile_t *prof, const char *name, double bytes, double flops){
+
+  // all ranks register the same kernels in the same order so entries can be reduced by index
+  if(prof->Nentries==prof->maxEntries){
+    prof->maxEntries = (prof->maxEntries) ? 2*prof->maxEntries : 16;
+    kernelProfileEntry_t *entries = new kernelProfileEntry_t[prof->maxEntries];
+    if(prof->Nentries)
+      memcpy(entries, prof->entries, prof->Nentries*sizeof(kernelProfileEntry_t));
+    delete [] prof->entries;
+    prof->entries = entries;
+  }
+
+  kernelProfileEntry_t *entry = prof->entries + prof->Nentries;
+
+  entry->name = new char[strlen(name)+1];
+  strcpy(entry->name, name);
+  entry->bytes = bytes;
+  entry->flops = flops;
+  entry->Nlaunches = 0;
+  entry->time = 0;
+
+  return prof->Nentries++;
+}
+
+// accumulate the device time of every pending launch
+static void kernelProfileFlush(kernelProfile_t *prof){
+
+  if(!prof->Npending) return;
+
+  prof->device.waitFor(prof->pendingEnd[prof->Npending-1]);
+
+  for(int n=0;n<prof->Npending;++n){
+    kernelProfileEntry_t *entry = prof->entries + prof->pendingEntries[n];
+    entry->time += prof->device.timeBetween(prof->pendingStart[n], prof->pendingEnd[n]);
+  }
+
+  prof->Npending = 0;
+}
+
+void kernelProfileStart(kernelProfile_t *prof){
+
+  if(!prof || !prof->enabled) return;
+
+  prof->startTag = prof->device.tagStream();
+}
+
+void kernelProfileStop(kernelProfile_t *prof, int entry){
+
+  if(!prof || !prof->enabled || entry<0) return;
+
+  if(prof->Npending==prof->maxPending)
+    kernelProfileFlush(prof);
+
+  const int n = prof->Npending++;
+
+  prof->pendingEntries[n] = entry;
+  prof->pendingStart[n] = prof->startTag;
+  prof->pendingEnd[n] = prof->device.tagStream();
+
+  prof->entries[entry].Nlaunches++;
+}
+
+// device to device copy bandwidth, the memory ceiling of the roofline
+static double kernelProfileCopyBandwidth(kernelProfile_t *prof){
+
+  const size_t bytes = 64*1024*1024;
+  const int Ncopies = 10;
+
+  occa::memory o_a = prof->device.malloc(bytes);
+  occa::memory o_b = prof->device.malloc(bytes);
+
+  o_b.copyFrom(o_a, bytes); // warm up
+
+  occa::streamTag start = prof->device.tagStream();
+  for(int n=0;n<Ncopies;++n)
+    o_b.copyFrom(o_a, bytes);
+  occa::streamTag end = prof->device.tagStream();
+
+  prof->device.waitFor(end);
+  double elapsed = prof->device.timeBetween(start, end);
+
+  o_a.free();
+  o_b.free();
+
+  // a copy reads and writes every byte
+  return (elapsed>0) ? 2.*bytes*Ncopies/elapsed : 0;
+}
+
+void kernelProfileReport(kernelProfile_t *prof, setupAide &options){
+
+  if(!prof || !prof->enabled) return;
+
+  kernelProfileFlush(prof);
+
+  int rank, size;
+  MPI_Comm_rank(prof->comm, &rank);
+  MPI_Comm_size(prof->comm, &size);
+
+  const int Nentries = prof->Nentries;
+
+  // slowest rank sets the time, work is summed over ranks
+  double *localTime = (double*) calloc(Nentries, sizeof(double));
+  double *localWork = (double*) calloc(2*Nentries, sizeof(double));
+  double *time = (double*) calloc(Nentries, sizeof(double));
+  double *work = (double*) calloc(2*Nentries, sizeof(double));
+
+  for(int n=0;n<Nentries;++n){
+    kernelProfileEntry_t *entry = prof->entries+n;
+    localTime[n] = entry->time;
+    localWork[2*n+0] = entry->Nlaunches*entry->bytes;
+    localWork[2*n+1] = entry->Nlaunches*entry->flops;
+  }
+
+  MPI_Allreduce(localTime, time, Nentries, MPI_DOUBLE, MPI_MAX, prof->comm);
+  MPI_Allreduce(localWork, work, 2*Nentries, MPI_DOUBLE, MPI_SUM, prof->comm);
+
+  double localBW = kernelProfileCopyBandwidth(prof);
+  double copyBW = 0;
+  MPI_Allreduce(&localBW, &copyBW, 1, MPI_DOUBLE, MPI_SUM, prof->comm);
+
+  if(rank==0){
+    double totalTime = 0;
+    for(int n=0;n<Nentries;++n) totalTime += time[n];
+
+    printf("Kernel profile on %d ranks (%s backend), measured copy bandwidth %7.2f GB/s\n",
+           size, prof->device.mode().c_str(), copyBW/1.e9);
+    printf("%-32s %10s %12s %7s %10s %10s %10s\n",
+           "kernel", "launches", "time [s]", "%", "GB/s", "GFLOP/s", "flop/byte");
+
+    for(int n=0;n<Nentries;++n){
+      kernelProfileEntry_t *entry = prof->entries+n;
+      if(!entry->Nlaunches) continue;
+
+      double bytes = work[2*n+0], flops = work[2*n+1];
+      double t = time[n];
+
+      printf("%-32s %10lld %12.4e %7.2f %10.2f %10.2f %10.3f\n",
+             entry->name, entry->Nlaunches, t,
+             (totalTime>0) ? 100.*t/totalTime : 0.,
+             (t>0) ? bytes/(1.e9*t) : 0.,
+             (t>0) ? flops/(1.e9*t) : 0.,
+             (bytes>0) ? flops/bytes : 0.);
+    }
+
+    // one row per kernel in the column layout read by utilities/roofline/rooflinePlot.m
+    string fileName;
+    options.getArgs("KERNEL PROFILE FILE", fileName);
+    if(fileName.empty()) fileName = "roofline.dat";
+
+    FILE *fp = fopen(fileName.c_str(), "w");
+    if(fp){
+      fprintf(fp, "%%%%  arithmeticIntensity, perf, kernelBandwidth, maxEstimatedGFLOPS, maxEstimatedBandwidth\n");
+      for(int n=0;n<Nentries;++n){
+        kernelProfileEntry_t *entry = prof->entries+n;
+        if(!entry->Nlaunches || time[n]<=0 || work[2*n]<=0) continue;
+
+        double AI = work[2*n+1]/work[2*n+0];
+        double perf = work[2*n+1]/(1.e9*time[n]);
+        double BW = work[2*n+0]/(1.e9*time[n]);
+
+        fprintf(fp, "%% %s\n", entry->name);
+        fprintf(fp, "%lg, %lg, %lg, %lg, %lg\n", AI, perf, BW, AI*copyBW/1.e9, copyBW/1.e9);
+      }
+      fclose(fp);
+      printf("Roofline data written to %s\n", fileName.c_str());
+    }
+  }
+
+  free(localTime); free(localWork);
+  free(time); free(work);
+}
+
+void kernelProfileFree(kernelProfile_t *prof){
+
+  kernelProfileFlush(prof);
+
+  for(int n=0;n<prof->Nentries;++n)
+    delete [] prof->entries[n].name;
+  delete [] prof->entries;
+
+  delete [] prof->pendingEntries;
+  delete [] prof->pendingStart;
+  delete [] prof->pendingEnd;
+
+  delete [] prof;
+}
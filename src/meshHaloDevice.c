@@ -0,0 +1,274 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+
+#include "mesh.h"
+
+// OpenMPI advertises CUDA-aware builds through its extension header
+#if defined(OMPI_MAJOR_VERSION)
+#include "mpi-ext.h"
+#endif
+
+// decide how halo data moves between the device and MPI
+static int meshHaloDeviceMode(mesh_t *mesh, setupAide &options){
+
+  // Serial and OpenMP device buffers are host memory: hand them to MPI as is
+  if(mesh->device.mode()=="Serial" || mesh->device.mode()=="OpenMP")
+    return MESH_HALO_HOST;
+
+  if(options.compareArgs("GPU AWARE MPI", "FALSE"))
+    return MESH_HALO_STAGED;
+
+  if(options.compareArgs("GPU AWARE MPI", "TRUE"))
+    return MESH_HALO_DEVICE_DIRECT;
+
+  // otherwise query the MPI library
+#if defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+  if(mesh->device.mode()=="CUDA" && MPIX_Query_cuda_support())
+    return MESH_HALO_DEVICE_DIRECT;
+#endif
+
+  return MESH_HALO_STAGED;
+}
+
+// allocate the DEVICE and staging buffers for the exchange pattern of halo
+static void meshHaloDeviceBuffers(mesh_t *mesh, meshHalo_t *halo, int Nentries, setupAide &options){
+
+  halo->Nentries  = Nentries;
+  halo->Nbytes    = Nentries*sizeof(dfloat);
+  halo->haloBytes = halo->Nsend*halo->Nbytes;
+  halo->recvBytes = halo->Nrecv*halo->Nbytes;
+  halo->mode      = meshHaloDeviceMode(mesh, options);
+
+  halo->sendRequests = (MPI_Request*) calloc(halo->NsendMessages+1, sizeof(MPI_Request));
+  halo->recvRequests = (MPI_Request*) calloc(halo->NrecvMessages+1, sizeof(MPI_Request));
+
+  if(halo->Nsend>0){
+    // DEVICE buffer for extracted halo elements
+    halo->o_haloBuffer = mesh->device.malloc(halo->haloBytes);
+
+    // pinned HOST staging buffers (only needed when MPI cannot see device memory)
+    if(halo->mode==MESH_HALO_STAGED)
+      halo->sendBuffer = (dfloat*) occaHostMallocPinned(mesh->device, halo->haloBytes, NULL, halo->o_sendBuffer);
+  }
+
+  if(halo->Nrecv>0 && halo->mode==MESH_HALO_STAGED)
+    halo->recvBuffer = (dfloat*) occaHostMallocPinned(mesh->device, halo->recvBytes, NULL, halo->o_recvBuffer);
+
+  if(mesh->rank==0 && options.compareArgs("VERBOSE", "TRUE"))
+    printf("Halo exchange mode: %s\n",
+           (halo->mode==MESH_HALO_HOST) ? "host" :
+           (halo->mode==MESH_HALO_DEVICE_DIRECT) ? "device direct" : "staged");
+}
+
+// set up buffers for exchanging Nentries dfloats per halo element
+meshHalo_t *meshHaloDeviceSetup(mesh_t *mesh, int Nentries, setupAide &options){
+
+  meshHalo_t *halo = (meshHalo_t*) calloc(1, sizeof(meshHalo_t));
+
+  // the usual halo: one message each way per neighbouring rank
+  int Nmessages = 0;
+  for(int r=0;r<mesh->size;++r)
+    if(r!=mesh->rank && mesh->NhaloPairs[r]) ++Nmessages;
+
+  halo->Nsend = mesh->totalHaloPairs;
+  halo->Nrecv = mesh->totalHaloPairs;
+  halo->NsendMessages = Nmessages;
+  halo->NrecvMessages = Nmessages;
+  halo->sendRanks  = (int*)   calloc(Nmessages+1, sizeof(int));
+  halo->sendStarts = (dlong*) calloc(Nmessages+1, sizeof(dlong));
+
+  int message = 0;
+  for(int r=0;r<mesh->size;++r){
+    if(r!=mesh->rank && mesh->NhaloPairs[r]){
+      halo->sendRanks[message] = r;
+      halo->sendStarts[message+1] = halo->sendStarts[message] + mesh->NhaloPairs[r];
+      ++message;
+    }
+  }
+
+  // halo exchanges are symmetric
+  halo->recvRanks  = halo->sendRanks;
+  halo->recvStarts = halo->sendStarts;
+
+  if(mesh->totalHaloPairs>0)
+    halo->o_sendList = mesh->o_haloElementList;
+
+  meshHaloDeviceBuffers(mesh, halo, Nentries, options);
+
+  return halo;
+}
+
+// set up buffers for exchanging Nentries dfloats per element of the extended halo
+meshHalo_t *meshHaloDeviceExtendedSetup(mesh_t *mesh, meshHaloExtension_t *ext, int Nentries, setupAide &options){
+
+  meshHalo_t *halo = (meshHalo_t*) calloc(1, sizeof(meshHalo_t));
+
+  halo->Nsend = ext->Nsend;
+  halo->Nrecv = ext->Nrecv;
+  halo->NsendMessages = ext->NsendMessages;
+  halo->NrecvMessages = ext->NrecvMessages;
+  halo->sendRanks  = ext->sendRanks;
+  halo->sendStarts = ext->sendStarts;
+  halo->recvRanks  = ext->recvRanks;
+  halo->recvStarts = ext->recvStarts;
+  halo->extended   = 1;
+
+  if(ext->Nsend>0)
+    halo->o_sendList = mesh->device.malloc(ext->Nsend*sizeof(dlong), ext->sendList);
+
+  meshHaloDeviceBuffers(mesh, halo, Nentries, options);
+
+  return halo;
+}
+
+void meshHaloDeviceFree(meshHalo_t *halo){
+
+  if(halo->o_haloBuffer.size()) halo->o_haloBuffer.free();
+  if(halo->o_sendBuffer.size()) halo->o_sendBuffer.free();
+  if(halo->o_recvBuffer.size()) halo->o_recvBuffer.free();
+
+  free(halo->sendRequests);
+  free(halo->recvRequests);
+
+  // the usual pattern is built by meshHaloDeviceSetup around mesh->o_haloElementList,
+  // the extended one belongs to its meshHaloExtension_t apart from the device send list
+  if(halo->extended){
+    if(halo->o_sendList.size()) halo->o_sendList.free();
+  } else {
+    free(halo->sendRanks);
+    free(halo->sendStarts);
+  }
+
+  free(halo);
+}
+
+// post the receives of the halo pattern, message m lands at its element offset in recvPtr
+static void meshHaloDeviceRecvStart(mesh_t *mesh, meshHalo_t *halo, char *recvPtr){
+
+  // messages between the same pair of ranks are matched in the order they are posted
+  int tag = 999;
+
+  for(int m=0;m<halo->NrecvMessages;++m){
+    size_t offset = halo->recvStarts[m]*halo->Nbytes;
+    size_t count  = (halo->recvStarts[m+1]-halo->recvStarts[m])*halo->Nbytes;
+    MPI_Irecv(recvPtr+offset, count, MPI_CHAR, halo->recvRanks[m], tag,
+              mesh->comm, halo->recvRequests+m);
+  }
+}
+
+// post the sends of the halo pattern from the packed send buffer
+static void meshHaloDeviceSendStart(mesh_t *mesh, meshHalo_t *halo, char *sendPtr){
+
+  int tag = 999;
+
+  for(int m=0;m<halo->NsendMessages;++m){
+    size_t offset = halo->sendStarts[m]*halo->Nbytes;
+    size_t count  = (halo->sendStarts[m+1]-halo->sendStarts[m])*halo->Nbytes;
+    MPI_Isend(sendPtr+offset, count, MPI_CHAR, halo->sendRanks[m], tag,
+              mesh->comm, halo->sendRequests+m);
+  }
+}
+
+static void meshHaloDeviceWait(meshHalo_t *halo){
+
+  MPI_Waitall(halo->NrecvMessages, halo->recvRequests, MPI_STATUSES_IGNORE);
+  MPI_Waitall(halo->NsendMessages, halo->sendRequests, MPI_STATUSES_IGNORE);
+}
+
+// post receives (and, when possible, sends) for the extracted halo
+static void meshHaloDevicePost(mesh_t *mesh, meshHalo_t *halo, occa::memory &o_recv, size_t offset){
+
+  halo->o_recv     = o_recv;
+  halo->recvOffset = offset;
+
+  if(halo->mode==MESH_HALO_STAGED){
+    // make sure the extract kernel has finished before copying on the data stream
+    occa::streamTag tag = mesh->device.tagStream();
+
+    mesh->device.setStream(mesh->dataStream);
+    mesh->device.waitFor(tag);
+    if(halo->Nsend)
+      halo->o_haloBuffer.copyTo(halo->sendBuffer, halo->haloBytes, 0, "async: true");
+    mesh->device.setStream(mesh->defaultStream);
+
+    // receives can be posted straight away, sends wait for the copy
+    meshHaloDeviceRecvStart(mesh, halo, (char*) halo->recvBuffer);
+  } else {
+    char *sendPtr = halo->Nsend ? (char*) halo->o_haloBuffer.ptr() : NULL;
+    char *recvPtr = (char*) o_recv.ptr() + offset;
+
+    // the extracted halo must be complete before MPI reads it
+    if(halo->mode==MESH_HALO_DEVICE_DIRECT)
+      mesh->device.waitFor(mesh->device.tagStream());
+
+    meshHaloDeviceRecvStart(mesh, halo, recvPtr);
+    meshHaloDeviceSendStart(mesh, halo, sendPtr);
+  }
+}
+
+// extract whole elements of o_q (Nentries per element) and start the exchange;
+// incoming halo elements land after the local elements of o_q
+void meshHaloExchangeDeviceStart(mesh_t *mesh, meshHalo_t *halo, occa::memory &o_q){
+
+  if(halo->Nsend+halo->Nrecv>0){
+    if(halo->Nsend)
+      mesh->haloExtractKernel(halo->Nsend, halo->Nentries, halo->o_sendList, o_q, halo->o_haloBuffer);
+
+    meshHaloDevicePost(mesh, halo, o_q, mesh->Nelements*halo->Nbytes);
+  }
+}
+
+// start the exchange of data already packed into halo->o_haloBuffer;
+// incoming data lands in o_recv at byte offset
+void meshHaloExchangeDeviceBufferStart(mesh_t *mesh, meshHalo_t *halo, occa::memory &o_recv, size_t offset){
+
+  if(halo->Nsend+halo->Nrecv>0)
+    meshHaloDevicePost(mesh, halo, o_recv, offset);
+}
+
+void meshHaloExchangeDeviceFinish(mesh_t *mesh, meshHalo_t *halo){
+
+  if(halo->Nsend+halo->Nrecv>0){
+    if(halo->mode==MESH_HALO_STAGED){
+      // wait for the halo to reach the HOST then send it
+      mesh->device.setStream(mesh->dataStream);
+      mesh->device.finish();
+
+      meshHaloDeviceSendStart(mesh, halo, (char*) halo->sendBuffer);
+      meshHaloDeviceWait(halo);
+
+      // copy halo data to DEVICE
+      if(halo->Nrecv)
+        halo->o_recv.copyFrom(halo->recvBuffer, halo->recvBytes, halo->recvOffset, "async: true");
+      mesh->device.finish();
+      mesh->device.setStream(mesh->defaultStream);
+    } else {
+      meshHaloDeviceWait(halo);
+    }
+  }
+}
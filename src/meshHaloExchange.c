@@ -89,6 +89,15 @@ void meshHaloExchangeStart(mesh_t *mesh,
 			     void *sendBuffer,    // temporary buffer
 			     void *recvBuffer){
 
+  meshHaloExchangeRecvStart(mesh, Nbytes, recvBuffer);
+  meshHaloExchangeSendStart(mesh, Nbytes, sendBuffer);
+}
+
+// post halo receives only (sends can follow once the send buffer is ready)
+void meshHaloExchangeRecvStart(mesh_t *mesh,
+			       size_t Nbytes,       // message size per element
+			       void *recvBuffer){
+
   if(mesh->totalHaloPairs>0){
     // MPI info
     int rank, size;
@@ -98,7 +107,7 @@ void meshHaloExchangeStart(mesh_t *mesh,
     // count outgoing and incoming meshes
     int tag = 999;
     
-    // initiate immediate send  and receives to each other process as needed
+    // initiate immediate receives from each other process as needed
     int offset = 0, message = 0;
     for(int r=0;r<size;++r){
       if(r!=rank){
@@ -106,7 +115,34 @@ void meshHaloExchangeStart(mesh_t *mesh,
 	if(count){
 	  MPI_Irecv(((char*)recvBuffer)+offset, count, MPI_CHAR, r, tag,
 		    mesh->comm, (MPI_Request*)mesh->haloRecvRequests+message);
-	
+	  offset += count;
+	  ++message;
+	}
+      }
+    }
+  }  
+}
+
+// post halo sends only (matching receives posted by meshHaloExchangeRecvStart)
+void meshHaloExchangeSendStart(mesh_t *mesh,
+			       size_t Nbytes,       // message size per element
+			       void *sendBuffer){
+
+  if(mesh->totalHaloPairs>0){
+    // MPI info
+    int rank, size;
+    MPI_Comm_rank(mesh->comm, &rank);
+    MPI_Comm_size(mesh->comm, &size);
+
+    // count outgoing and incoming meshes
+    int tag = 999;
+    
+    // initiate immediate sends to each other process as needed
+    int offset = 0, message = 0;
+    for(int r=0;r<size;++r){
+      if(r!=rank){
+	size_t count = mesh->NhaloPairs[r]*Nbytes;
+	if(count){
 	  MPI_Isend(((char*)sendBuffer)+offset, count, MPI_CHAR, r, tag,
 		    mesh->comm, (MPI_Request*)mesh->haloSendRequests+message);
 	  offset += count;
@@ -0,0 +1,260 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+
+#include "mesh.h"
+
+typedef struct {
+
+  int   rank;  // owner of the element
+  dlong id;    // element index on its owner
+  dlong index; // element index here (known elements) or face slot (requests)
+
+}remoteElement_t;
+
+/* comparison function that orders remote elements
+   by owner then by index on the owner */
+static int compareRemoteElements(const void *a,
+                                 const void *b){
+
+  const remoteElement_t *ea = (const remoteElement_t*) a;
+  const remoteElement_t *eb = (const remoteElement_t*) b;
+
+  if(ea->rank < eb->rank) return -1;
+  if(ea->rank > eb->rank) return +1;
+
+  if(ea->id < eb->id) return -1;
+  if(ea->id > eb->id) return +1;
+
+  return 0;
+}
+
+// extend the halo one layer deeper so the face terms of halo elements can be
+// evaluated locally (call after meshHaloSetup and meshConnectFaceNodes)
+meshHaloExtension_t *meshHaloExtensionSetup(mesh_t *mesh){
+
+  int rank = mesh->rank;
+  int size = mesh->size;
+
+  int Np     = mesh->Np;
+  int Nfp    = mesh->Nfp;
+  int Nfaces = mesh->Nfaces;
+
+  dlong Nelements = mesh->Nelements;
+  dlong Nhalo     = mesh->totalHaloPairs;
+
+  meshHaloExtension_t *ext = (meshHaloExtension_t*) calloc(1, sizeof(meshHaloExtension_t));
+
+  // owner and owner index of every local and halo element
+  dlong *ids    = (dlong*) calloc(Nelements+Nhalo, sizeof(dlong));
+  int   *owners = (int*)   calloc(Nelements+Nhalo, sizeof(int));
+
+  for(dlong e=0;e<Nelements;++e){
+    ids[e]    = e;
+    owners[e] = rank;
+    for(int f=0;f<Nfaces;++f){
+      dlong ef = e*Nfaces+f;
+      if(mesh->EToP[ef]!=-1)
+        owners[mesh->EToE[ef]] = mesh->EToP[ef];
+    }
+  }
+
+  // each face of an element is described by the owner and owner index of the
+  // face neighbour, the boundary flag and the neighbour node of each face node
+  int Nrecord = Nfaces*(3+Nfp);
+
+  dlong *records    = (dlong*) calloc((Nelements+Nhalo)*Nrecord, sizeof(dlong));
+  dlong *sendBuffer = (dlong*) calloc((Nhalo+1)*Nrecord, sizeof(dlong));
+
+  meshHaloExchange(mesh, sizeof(dlong), ids, sendBuffer, ids+Nelements);
+
+  for(dlong e=0;e<Nelements;++e){
+    for(int f=0;f<Nfaces;++f){
+      dlong *record = records + e*Nrecord + f*(3+Nfp);
+      dlong  base   = (e*Nfaces+f)*Nfp;
+
+      // boundary faces are connected to the element itself
+      dlong eP = mesh->vmapP[base]/Np;
+
+      record[0] = owners[eP];
+      record[1] = ids[eP];
+      record[2] = mesh->EToB[e*Nfaces+f];
+      for(int n=0;n<Nfp;++n)
+        record[3+n] = mesh->vmapP[base+n]%Np;
+    }
+  }
+
+  // halo elements arrive with the description of their faces
+  meshHaloExchange(mesh, Nrecord*sizeof(dlong), records, sendBuffer, records+Nelements*Nrecord);
+
+  // halo elements sorted for look up
+  remoteElement_t *known = (remoteElement_t*) calloc(Nhalo+1, sizeof(remoteElement_t));
+  for(dlong h=0;h<Nhalo;++h){
+    known[h].rank  = owners[Nelements+h];
+    known[h].id    = ids[Nelements+h];
+    known[h].index = Nelements+h;
+  }
+  qsort(known, Nhalo, sizeof(remoteElement_t), compareRemoteElements);
+
+  // find the face neighbours of the halo elements, collecting the ones not held here
+  dlong *faceElement = (dlong*) calloc(Nhalo*Nfaces+1, sizeof(dlong));
+  remoteElement_t *requests = (remoteElement_t*) calloc(Nhalo*Nfaces+1, sizeof(remoteElement_t));
+
+  dlong Nrequests = 0;
+  for(dlong h=0;h<Nhalo;++h){
+    for(int f=0;f<Nfaces;++f){
+      dlong *record = records + (Nelements+h)*Nrecord + f*(3+Nfp);
+
+      remoteElement_t neighbour;
+      neighbour.rank  = (int) record[0];
+      neighbour.id    = record[1];
+      neighbour.index = h*Nfaces+f;
+
+      if(neighbour.rank==rank){
+        faceElement[h*Nfaces+f] = neighbour.id;
+      } else if(neighbour.rank==owners[Nelements+h] && neighbour.id==ids[Nelements+h]){
+        faceElement[h*Nfaces+f] = Nelements+h;
+      } else {
+        remoteElement_t *match = (remoteElement_t*)
+          bsearch(&neighbour, known, Nhalo, sizeof(remoteElement_t), compareRemoteElements);
+
+        if(match)
+          faceElement[h*Nfaces+f] = match->index;
+        else
+          requests[Nrequests++] = neighbour;
+      }
+    }
+  }
+
+  // extra elements are numbered after the halo, grouped by owner
+  qsort(requests, Nrequests, sizeof(remoteElement_t), compareRemoteElements);
+
+  int *NrequestFrom = (int*) calloc(size, sizeof(int));
+  int *NrequestedBy = (int*) calloc(size, sizeof(int));
+
+  dlong *requestIds = (dlong*) calloc(Nrequests+1, sizeof(dlong));
+
+  ext->Nextra = 0;
+  for(dlong n=0;n<Nrequests;++n){
+    if(n==0 || compareRemoteElements(requests+n, requests+n-1)){
+      requestIds[ext->Nextra++] = requests[n].id;
+      NrequestFrom[requests[n].rank] += 1;
+    }
+    faceElement[requests[n].index] = Nelements+Nhalo+ext->Nextra-1;
+  }
+
+  // face node maps and boundary flags of the halo elements
+  ext->vmapM = (dlong*) calloc(Nhalo*Nfaces*Nfp+1, sizeof(dlong));
+  ext->vmapP = (dlong*) calloc(Nhalo*Nfaces*Nfp+1, sizeof(dlong));
+  ext->EToB  = (int*)   calloc(Nhalo*Nfaces+1, sizeof(int));
+
+  for(dlong h=0;h<Nhalo;++h){
+    for(int f=0;f<Nfaces;++f){
+      dlong *record = records + (Nelements+h)*Nrecord + f*(3+Nfp);
+
+      ext->EToB[h*Nfaces+f] = (int) record[2];
+      for(int n=0;n<Nfp;++n){
+        dlong id = (h*Nfaces+f)*Nfp+n;
+        ext->vmapM[id] = (Nelements+h)*Np + mesh->faceNodes[f*Nfp+n];
+        ext->vmapP[id] = faceElement[h*Nfaces+f]*Np + record[3+n];
+      }
+    }
+  }
+
+  // tell the owners which of their elements are needed here
+  MPI_Alltoall(NrequestFrom, 1, MPI_INT, NrequestedBy, 1, MPI_INT, mesh->comm);
+
+  int *requestFromStarts = (int*) calloc(size+1, sizeof(int));
+  int *requestedByStarts = (int*) calloc(size+1, sizeof(int));
+  for(int r=0;r<size;++r){
+    requestFromStarts[r+1] = requestFromStarts[r] + NrequestFrom[r];
+    requestedByStarts[r+1] = requestedByStarts[r] + NrequestedBy[r];
+  }
+
+  dlong Nrequested = requestedByStarts[size];
+  dlong *requestedIds = (dlong*) calloc(Nrequested+1, sizeof(dlong));
+
+  MPI_Alltoallv(requestIds,   NrequestFrom, requestFromStarts, MPI_DLONG,
+                requestedIds, NrequestedBy, requestedByStarts, MPI_DLONG, mesh->comm);
+
+  // the usual halo elements go first, then the extra elements
+  ext->Nsend = Nhalo + Nrequested;
+  ext->Nrecv = Nhalo + ext->Nextra;
+
+  ext->sendList = (dlong*) calloc(ext->Nsend+1, sizeof(dlong));
+  for(dlong h=0;h<Nhalo;++h)
+    ext->sendList[h] = mesh->haloElementList[h];
+  for(dlong n=0;n<Nrequested;++n)
+    ext->sendList[Nhalo+n] = requestedIds[n];
+
+  ext->sendRanks  = (int*)   calloc(2*size+1, sizeof(int));
+  ext->recvRanks  = (int*)   calloc(2*size+1, sizeof(int));
+  ext->sendStarts = (dlong*) calloc(2*size+1, sizeof(dlong));
+  ext->recvStarts = (dlong*) calloc(2*size+1, sizeof(dlong));
+
+  ext->NsendMessages = 0;
+  ext->NrecvMessages = 0;
+  for(int r=0;r<size;++r){
+    if(r!=rank && mesh->NhaloPairs[r]){
+      int ms = ext->NsendMessages++;
+      ext->sendRanks[ms] = r;
+      ext->sendStarts[ms+1] = ext->sendStarts[ms] + mesh->NhaloPairs[r];
+
+      int mr = ext->NrecvMessages++;
+      ext->recvRanks[mr] = r;
+      ext->recvStarts[mr+1] = ext->recvStarts[mr] + mesh->NhaloPairs[r];
+    }
+  }
+  for(int r=0;r<size;++r){
+    if(NrequestedBy[r]){
+      int ms = ext->NsendMessages++;
+      ext->sendRanks[ms] = r;
+      ext->sendStarts[ms+1] = ext->sendStarts[ms] + NrequestedBy[r];
+    }
+    if(NrequestFrom[r]){
+      int mr = ext->NrecvMessages++;
+      ext->recvRanks[mr] = r;
+      ext->recvStarts[mr+1] = ext->recvStarts[mr] + NrequestFrom[r];
+    }
+  }
+
+  free(ids);
+  free(owners);
+  free(records);
+  free(sendBuffer);
+  free(known);
+  free(faceElement);
+  free(requests);
+  free(NrequestFrom);
+  free(NrequestedBy);
+  free(requestIds);
+  free(requestFromStarts);
+  free(requestedByStarts);
+  free(requestedIds);
+
+  return ext;
+}
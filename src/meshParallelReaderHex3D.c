@@ -137,21 +137,42 @@ mesh3D* meshParallelReaderHex3D(char *fileName){
   hlong cnt=0, bcnt=0;
   Nhexes = 0;
 
+  // surface id and boundary type of each boundary surface, printed by the acoustics setup
+  hlong surfIdCounter = 0;
+  hlong currentSurfId = -1;
+  // [EA] (surface id, physical id) pairs, grown as new surfaces appear
+  hlong maxSurfIds = 64;
+  mesh->NmshPrint = 0;
+  mesh->mshPrint = (hlong*) calloc(2*maxSurfIds, sizeof(hlong));
   mesh->boundaryInfo = (hlong*) calloc(NboundaryFaces*(mesh->NfaceVertices+1), sizeof(hlong));
   for(hlong n=0;n<Nelements;++n){
     int elementType; 
     hlong v1, v2, v3, v4, v5, v6, v7, v8;
+    hlong surfId;
     status = fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d%d", &elementType);
 
     if(elementType==3){ // quad boundary face
-      sscanf(buf, "%*d%*d %*d" hlongFormat "%*d "hlongFormat hlongFormat hlongFormat hlongFormat, 
-             mesh->boundaryInfo+bcnt*5, &v1, &v2, &v3, &v4);
+      sscanf(buf, "%*d%*d %*d" hlongFormat hlongFormat hlongFormat hlongFormat hlongFormat hlongFormat, 
+             mesh->boundaryInfo+bcnt*5, &surfId, &v1, &v2, &v3, &v4);
 
       mesh->boundaryInfo[bcnt*5+1] = v1-1;
       mesh->boundaryInfo[bcnt*5+2] = v2-1;
       mesh->boundaryInfo[bcnt*5+3] = v3-1;
       mesh->boundaryInfo[bcnt*5+4] = v4-1;
+
+      if(surfId != currentSurfId){
+        if(mesh->NmshPrint == maxSurfIds){
+          maxSurfIds *= 2;
+          mesh->mshPrint = (hlong*) realloc(mesh->mshPrint, 2*maxSurfIds*sizeof(hlong));
+        }
+        mesh->mshPrint[surfIdCounter] = surfId;
+        mesh->mshPrint[surfIdCounter+1] = mesh->boundaryInfo[bcnt*5];
+        mesh->NmshPrint++;
+        currentSurfId = surfId;
+        surfIdCounter += 2;
+      }
+
       ++bcnt;
     }
 
@@ -135,10 +135,10 @@ mesh3D* meshParallelReaderTet3D(char *fileName){
 
   hlong surfIdCounter = 0;
   hlong currentSurfId = -1;
-  mesh->mshPrint = (hlong*) calloc(1000, sizeof(hlong)); // Hardcoded 1000 long. Assuming max 500 surfaces
-  for(hlong jj = 0; jj < 1000; jj++){
-    mesh->mshPrint[jj] = -1;
-  }
+  // [EA] (surface id, physical id) pairs, grown as new surfaces appear
+  hlong maxSurfIds = 64;
+  mesh->NmshPrint = 0;
+  mesh->mshPrint = (hlong*) calloc(2*maxSurfIds, sizeof(hlong));
   mesh->boundaryInfo = (hlong*) calloc(NboundaryFaces*4, sizeof(hlong));
   for(hlong n=0;n<Nelements;++n){
     int elementType; 
@@ -156,8 +156,13 @@ mesh3D* meshParallelReaderTet3D(char *fileName){
       mesh->boundaryInfo[bcnt*4+3] = v3-1;
 
       if(surfId != currentSurfId){
+        if(mesh->NmshPrint == maxSurfIds){
+          maxSurfIds *= 2;
+          mesh->mshPrint = (hlong*) realloc(mesh->mshPrint, 2*maxSurfIds*sizeof(hlong));
+        }
         mesh->mshPrint[surfIdCounter] = surfId;
         mesh->mshPrint[surfIdCounter+1] = mesh->boundaryInfo[bcnt*4];
+        mesh->NmshPrint++;
         currentSurfId = surfId;
         surfIdCounter += 2;
       }
@@ -88,6 +88,40 @@ mesh3D *meshSetupHex3D(char *filename, int N){
   memcpy(mesh->rka, rka, Nrk*sizeof(dfloat));
   memcpy(mesh->rkb, rkb, Nrk*sizeof(dfloat));
   memcpy(mesh->rkc, rkc, (Nrk+1)*sizeof(dfloat));
+
+  int INrk = 6;
+  dfloat erka[36] = {
+        0.0,0.0,0.0,0.0,0.0,0.0,
+        1.0/2.0,0.0,0.0,0.0,0.0,0.0,
+        13861.0/62500.0,6889.0/62500.0,0.0,0.0,0.0,0.0,
+        -116923316275.0/2393684061468.0,-2731218467317.0/15368042101831.0,9408046702089.0/11113171139209.0,0.0,0.0,0.0,
+        -451086348788.0/2902428689909.0,-2682348792572.0/7519795681897.0,12662868775082.0/11960479115383.0,3355817975965.0/11060851509271.0,0.0,0.0,
+        647845179188.0/3216320057751.0,73281519250.0/8382639484533.0,552539513391.0/3454668386233.0,3354512671639.0/8306763924573.0,4040.0/17871.0,0.0
+        };
+  dfloat erkb[6] = {82889.0/524892.0,0.0,15625.0/83664.0,69875.0/102672.0,-2260.0/8211.0,1.0/4.0};
+  dfloat erkc[6] = {0.0,1.0/2.0,83.0/250.0,31.0/50.0,17.0/20.0,1.0};
+  dfloat erke[6] = {31666707.0/9881966720.0, 0.0, -256875.0/105007616.0, -2768025.0/128864768.0, 169839.0/3864644.0, -5247.0/225920.0};
+  dfloat esdirka[36] = {
+        0.0,0.0,0.0,0.0,0.0,0.0,
+        1.0/4.0,1.0/4.0,0.0,0.0,0.0,0,
+        8611.0/62500.0,-1743.0/31250.0,1.0/4.0,0.0,0.0,0,
+        5012029.0/34652500.0,-654441.0/2922500.0,174375.0/388108.0,1.0/4.0,0.0,0,
+        15267082809.0/155376265600.0,-71443401.0/120774400.0,730878875.0/902184768.0,2285395.0/8070912.0,1.0/4.0,0,
+        82889.0/524892.0,0.0,15625.0/83664.0,69875.0/102672.0,-2260.0/8211.0,1.0/4
+        };
+  dfloat esdirkb[6] = {82889.0/524892.0,0.0,15625.0/83664.0,69875.0/102672.0,-2260.0/8211.0,1.0/4.0};
+  dfloat esdirkc[6] = {0.0,1.0/2.0,83.0/250.0,31.0/50.0,17.0/20.0,1.0};
+  dfloat esdirke[6] = {31666707.0/9881966720.0, 0.0, -256875.0/105007616.0, -2768025.0/128864768.0, 169839.0/3864644.0, -5247.0/225920.0};
+
+  mesh->INrk = INrk;
+  memcpy(mesh->erka, erka, INrk*INrk*sizeof(dfloat));
+  memcpy(mesh->erkb, erkb, INrk*sizeof(dfloat));
+  memcpy(mesh->erkc, erkc, INrk*sizeof(dfloat));
+  memcpy(mesh->erke, erke, INrk*sizeof(dfloat));
+  memcpy(mesh->esdirka, esdirka, INrk*INrk*sizeof(dfloat));
+  memcpy(mesh->esdirkb, esdirkb, INrk*sizeof(dfloat));
+  memcpy(mesh->esdirkc, esdirkc, INrk*sizeof(dfloat));
+  memcpy(mesh->esdirke, esdirke, INrk*sizeof(dfloat));
     
   return mesh;
 }
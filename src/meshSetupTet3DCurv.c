@@ -81,7 +81,7 @@ mesh3D *meshSetupTet3DCurv(char *filename, int N){
         };
   dfloat erkb[6] = {82889.0/524892.0,0.0,15625.0/83664.0,69875.0/102672.0,-2260.0/8211.0,1.0/4.0};
   dfloat erkc[6] = {0.0,1.0/2.0,83.0/250.0,31.0/50.0,17.0/20.0,1.0};
-  dfloat erke[6] = {31666707/9881966720, 0, -256875/105007616, -2768025/128864768, 169839/3864644, -5247/225920};
+  dfloat erke[6] = {31666707.0/9881966720.0, 0.0, -256875.0/105007616.0, -2768025.0/128864768.0, 169839.0/3864644.0, -5247.0/225920.0};
   dfloat esdirka[36] = {
         0.0,0.0,0.0,0.0,0.0,0.0,
         1.0/4.0,1.0/4.0,0.0,0.0,0.0,0,
@@ -92,7 +92,7 @@ mesh3D *meshSetupTet3DCurv(char *filename, int N){
         };
   dfloat esdirkb[6] = {82889.0/524892.0,0.0,15625.0/83664.0,69875.0/102672.0,-2260.0/8211.0,1.0/4.0};
   dfloat esdirkc[6] = {0.0,1.0/2.0,83.0/250.0,31.0/50.0,17.0/20.0,1.0};
-  dfloat esdirke[6] = {31666707/9881966720, 0, -256875/105007616, -2768025/128864768, 169839/3864644, -5247/225920};
+  dfloat esdirke[6] = {31666707.0/9881966720.0, 0.0, -256875.0/105007616.0, -2768025.0/128864768.0, 169839.0/3864644.0, -5247.0/225920.0};
 
   mesh->INrk = INrk;
   memcpy(mesh->erka, erka, INrk*INrk*sizeof(dfloat));